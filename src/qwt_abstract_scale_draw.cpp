@@ -28,6 +28,7 @@
 #include "qwt_text.h"
 #include "qwt_painter.h"
 #include "qwt_scale_map.h"
+#include "qwt_interval.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
@@ -49,6 +50,7 @@ public:
     }
 
     ScaleComponents components;
+    CacheAttributes cacheAttributes;
 
     QwtScaleMap map;
     QwtScaleDiv scaleDiv;
@@ -117,9 +119,24 @@ bool QwtAbstractScaleDraw::hasComponent(ScaleComponent component) const
  */
 void QwtAbstractScaleDraw::setScaleDiv(const QwtScaleDiv& scaleDiv)
 {
+    if ((m_data->cacheAttributes & KeepLabelsOnShift) && scaleDiv.isShiftOf(m_data->scaleDiv)) {
+        // keep the labels around the new interval, so that the cache doesn't grow forever
+        const QwtInterval interval = scaleDiv.interval().normalized();
+        const double margin        = interval.width();
+
+        QMap< double, QwtText >::iterator it = m_data->labelCache.begin();
+        while (it != m_data->labelCache.end()) {
+            if (it.key() < interval.minValue() - margin || it.key() > interval.maxValue() + margin)
+                it = m_data->labelCache.erase(it);
+            else
+                ++it;
+        }
+    } else {
+        m_data->labelCache.clear();
+    }
+
     m_data->scaleDiv = scaleDiv;
     m_data->map.setScaleInterval(scaleDiv.lowerBound(), scaleDiv.upperBound());
-    m_data->labelCache.clear();
 }
 
 /*!
@@ -457,6 +474,31 @@ const QwtText& QwtAbstractScaleDraw::tickLabel(const QFont& font, double value)
     return *it2;
 }
 
+/*!
+   Change a cache attribute
+
+   \param attribute Cache attribute
+   \param on On/Off
+
+   \sa CacheAttribute, testCacheAttribute()
+ */
+void QwtAbstractScaleDraw::setCacheAttribute(CacheAttribute attribute, bool on)
+{
+    if (on)
+        m_data->cacheAttributes |= attribute;
+    else
+        m_data->cacheAttributes &= ~attribute;
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa CacheAttribute, setCacheAttribute()
+ */
+bool QwtAbstractScaleDraw::testCacheAttribute(CacheAttribute attribute) const
+{
+    return m_data->cacheAttributes & attribute;
+}
+
 /*!
    Invalidate the cache used by tickLabel()
 
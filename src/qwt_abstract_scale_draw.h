@@ -66,6 +66,35 @@ public:
 
     Q_DECLARE_FLAGS(ScaleComponents, ScaleComponent)
 
+    /*!
+       Attributes, how the rendering of tick labels is cached
+       \sa setCacheAttribute(), testCacheAttribute()
+     */
+    enum CacheAttribute
+    {
+        /*!
+           Keep the tick labels, when the new scale division is a shifted
+           version of the previous one ( QwtScaleDiv::isShiftOf() ).
+           This avoids recreating and measuring the labels while panning.
+
+           \warning Labels, that depend on the scale division ( f.e. the date
+                    formats of QwtDateScaleDraw ), might become outdated.
+         */
+        KeepLabelsOnShift = 0x01,
+
+        /*!
+           Cache the labels as images and blit them, instead of laying out
+           and rendering the text again. The images are keyed by text, font,
+           color, rotation and device pixel ratio and are used for raster
+           paint devices only.
+
+           \note Only QwtScaleDraw supports this attribute.
+         */
+        CacheLabelImages = 0x02
+    };
+
+    Q_DECLARE_FLAGS(CacheAttributes, CacheAttribute)
+
     QwtAbstractScaleDraw();
     virtual ~QwtAbstractScaleDraw();
 
@@ -118,6 +147,9 @@ public:
     void setMinimumExtent(double);
     double minimumExtent() const;
 
+    void setCacheAttribute(CacheAttribute, bool on = true);
+    bool testCacheAttribute(CacheAttribute) const;
+
     void invalidateCache();
 
 protected:
@@ -160,5 +192,6 @@ private:
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QwtAbstractScaleDraw::ScaleComponents)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QwtAbstractScaleDraw::CacheAttributes)
 
 #endif
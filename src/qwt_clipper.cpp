@@ -234,6 +234,162 @@ class QwtPolygonClipper
     const Rect m_clipRect;
 };
 
+class QwtPolylineClipper
+{
+  public:
+    explicit QwtPolylineClipper( const QRectF& clipRect ):
+        m_xMin( clipRect.left() ),
+        m_xMax( clipRect.right() ),
+        m_yMin( clipRect.top() ),
+        m_yMax( clipRect.bottom() )
+    {
+    }
+
+    QVector< QPolygonF > clipPolyline( const QPolygonF& polyline ) const
+    {
+        QVector< QPolygonF > runs;
+
+        const int numPoints = polyline.size();
+        if ( numPoints < 2 )
+            return runs;
+
+        const QPointF* points = polyline.constData();
+
+        /*
+            The outcodes are calculated in a separate loop without any
+            branches, so that the compiler is able to vectorize it.
+            Comparisons are written in a way, that NaN coordinates set
+            the bits of both sides - what can't happen for a valid point.
+         */
+        QVector< uchar > codes( numPoints );
+        uchar* c = codes.data();
+
+        for ( int i = 0; i < numPoints; i++ )
+        {
+            const double x = points[i].x();
+            const double y = points[i].y();
+
+            c[i] = static_cast< uchar >( int( !( x >= m_xMin ) )
+                | ( int( !( x <= m_xMax ) ) << 1 )
+                | ( int( !( y >= m_yMin ) ) << 2 )
+                | ( int( !( y <= m_yMax ) ) << 3 ) );
+        }
+
+        QPolygonF run;
+
+        for ( int i = 1; i < numPoints; i++ )
+        {
+            const uchar c0 = c[i - 1];
+            const uchar c1 = c[i];
+
+            if ( ( c0 | c1 ) == 0 )
+            {
+                // completely inside
+
+                if ( run.isEmpty() )
+                    run += points[i - 1];
+
+                run += points[i];
+                continue;
+            }
+
+            double t0, t1;
+            if ( ( c0 & c1 ) || !isValid( c0 ) || !isValid( c1 )
+                || !clipSegment( points[i - 1], points[i], t0, t1 ) )
+            {
+                // completely outside
+                closeRun( run, runs );
+                continue;
+            }
+
+            const QPointF& p0 = points[i - 1];
+            const QPointF d = points[i] - p0;
+
+            if ( run.isEmpty() )
+            {
+                if ( t0 >= t1 )
+                    continue; // touching a corner only
+
+                run += p0 + t0 * d;
+            }
+
+            run += ( c1 == 0 ) ? points[i] : p0 + t1 * d;
+
+            if ( c1 != 0 )
+                closeRun( run, runs );
+        }
+
+        closeRun( run, runs );
+
+        return runs;
+    }
+
+  private:
+    static inline bool isValid( uchar code )
+    {
+        return ( code & 0x03 ) != 0x03 && ( code & 0x0c ) != 0x0c;
+    }
+
+    static inline void closeRun( QPolygonF& run, QVector< QPolygonF >& runs )
+    {
+        if ( run.size() >= 2 )
+            runs += run;
+
+        run.clear();
+    }
+
+    // Liang-Barsky
+    inline bool clipSegment( const QPointF& p0, const QPointF& p1,
+        double& t0, double& t1 ) const
+    {
+        const double dx = p1.x() - p0.x();
+        const double dy = p1.y() - p0.y();
+
+        const double p[4] = { -dx, dx, -dy, dy };
+        const double q[4] = { p0.x() - m_xMin, m_xMax - p0.x(),
+            p0.y() - m_yMin, m_yMax - p0.y() };
+
+        t0 = 0.0;
+        t1 = 1.0;
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            if ( p[k] == 0.0 )
+            {
+                if ( q[k] < 0.0 )
+                    return false;
+            }
+            else
+            {
+                const double r = q[k] / p[k];
+                if ( p[k] < 0.0 )
+                {
+                    if ( r > t1 )
+                        return false;
+
+                    if ( r > t0 )
+                        t0 = r;
+                }
+                else
+                {
+                    if ( r < t0 )
+                        return false;
+
+                    if ( r < t1 )
+                        t1 = r;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const double m_xMin;
+    const double m_xMax;
+    const double m_yMin;
+    const double m_yMax;
+};
+
 class QwtCircleClipper
 {
   public:
@@ -478,6 +634,28 @@ QPolygonF QwtClipper::clippedPolygonF(
     return points;
 }
 
+/*!
+   \brief Clip a polyline into its visible runs
+
+   In opposite to clipPolygonF() the clipper doesn't insert points
+   along the border of the clip rectangle for segments leaving and
+   reentering it. Instead each sequence of consecutive visible segments
+   is returned as a polyline of its own. The polyline is clipped in one
+   pass with Cohen-Sutherland outcodes and Liang-Barsky segment clipping.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Disjoint visible runs of the polyline
+   \sa clipPolygonF()
+ */
+QVector< QPolygonF > QwtClipper::clippedPolylinesF(
+    const QRectF& clipRect, const QPolygonF& polyline )
+{
+    QwtPolylineClipper clipper( clipRect );
+    return clipper.clipPolyline( polyline );
+}
+
 /*!
    Circle clipping
 
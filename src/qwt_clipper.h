@@ -64,6 +64,9 @@ namespace QwtClipper
     QWT_EXPORT QPolygonF clippedPolygonF( const QRectF&,
         const QPolygonF&, bool closePolygon = false );
 
+    QWT_EXPORT QVector< QPolygonF > clippedPolylinesF(
+        const QRectF&, const QPolygonF& );
+
     QWT_EXPORT QVector< QwtInterval > clipCircle(
         const QRectF&, const QPointF&, double radius );
 };
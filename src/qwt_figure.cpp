@@ -14,15 +14,29 @@
 #include <QWidgetItem>
 #include <QMap>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QPixmap>
+#include <QRegion>
+#include <QtMath>
 // qwt
 #include "qwt_figure_layout.h"
+#include "qwt_figure_tiff_writer.h"
+#include "qwt_lightweight_axes.h"
+#include "qwt_plot_layout_engine.h"
 #include "qwt_scale_engine.h"
 #include "qwt_scale_widget.h"
 #include "qwt_plot_layout.h"
 #include "qwt_plot.h"
+#include "qwt_plot_axis_link.h"
 #include "qwt_plot_canvas.h"
 #include "qwt_plot_transparent_canvas.h"
 #include "qwt_parasite_plot_layout.h"
+#include "qwt_plot_renderer.h"
+#include "qwt_scale_map.h"
+#include "qwt_scale_div.h"
+#include "qwt_painter.h"
 
 #ifndef QWTFIGURE_SAFEGET_LAY
 #define QWTFIGURE_SAFEGET_LAY(lay)                                                                                     \
@@ -40,6 +54,56 @@
     }
 #endif
 
+/**
+ * @brief Plot renderer, that also renders the canvas items of the parasite plots
+ * @brief 同时绘制寄生轴画布内容的绘图渲染器
+ *
+ * The canvas of a parasite plot is composited on the host canvas, so its items
+ * are drawn with the canvas rectangle of the host and maps built from the scales of the parasite.
+ */
+class QwtFigurePlotRenderer : public QwtPlotRenderer
+{
+public:
+    virtual void renderCanvas(const QwtPlot* plot,
+                              QPainter* painter,
+                              const QRectF& canvasRect,
+                              const QwtScaleMap* maps) const QWT_OVERRIDE
+    {
+        QwtPlotRenderer::renderCanvas(plot, painter, canvasRect, maps);
+
+        const QList< QwtPlot* > parasites = plot->parasitePlots();
+        for (QwtPlot* parasite : parasites) {
+            if (parasite->isHidden()) {
+                continue;
+            }
+
+            QwtScaleMap parasiteMaps[ QwtAxis::AxisPositions ];
+            for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+                const QwtScaleDiv& sd = parasite->axisScaleDiv(axisPos);
+
+                QwtScaleMap& map = parasiteMaps[ axisPos ];
+                map.setTransformation(parasite->axisScaleEngine(axisPos)->transformation());
+                map.setScaleInterval(sd.lowerBound(), sd.upperBound());
+                map.setPaintInterval(maps[ axisPos ].p1(), maps[ axisPos ].p2());
+            }
+
+            painter->save();
+            painter->setClipRect(canvasRect, Qt::IntersectClip);
+            parasite->drawItems(painter, canvasRect, parasiteMaps);
+            painter->restore();
+        }
+    }
+};
+
+// pixel size of the figure, when being exported with a resolution of dpi
+static QSize qwtFigureTargetSize(const QwtFigure* figure, int dpi)
+{
+    const double sx = double(dpi) / figure->logicalDpiX();
+    const double sy = double(dpi) / figure->logicalDpiY();
+
+    return QSize(qCeil(figure->width() * sx), qCeil(figure->height() * sy));
+}
+
 class QwtFigure::PrivateData
 {
     QWT_DECLARE_PUBLIC(QwtFigure)
@@ -58,10 +122,22 @@ public:
     int edgeLineWidth { 0 };                    ///< Border line width / 边框线宽
     QPointer< QwtPlot > currentAxes;            ///< Current active axes / 当前活动坐标轴
     QList< AlignmentConfig > alignmentConfigs;  // 所有对齐配置
+    QList< QPointer< QwtPlotAxisLink > > axisLinks;  ///< Axis link groups owned by the figure / figure持有的坐标轴联动组
+
+    // 轻量坐标系
+    QwtPlotLayoutEngine lightweightLayoutEngine;  ///< Layout engine of all lightweight axes / 所有轻量坐标系共用的布局引擎
+    QPixmap lightweightCache;                     ///< Shared backing store of all lightweight axes / 所有轻量坐标系共享的缓存
+    QVector< QRect > lightweightCacheKey;         ///< Geometries of the cached axes / 缓存对应的坐标系位置
+    QRegion lightweightDirtyRegion;               ///< Region to be rendered again / 需要重绘的区域
 };
 
 QwtFigure::PrivateData::PrivateData(QwtFigure* p) : q_ptr(p)
 {
+    // the same defaults as QwtPlotLayout
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        lightweightLayoutEngine.setCanvasMargin(axisPos, -1);
+        lightweightLayoutEngine.setAlignCanvas(axisPos, false);
+    }
 }
 
 //----------------------------------------------------
@@ -458,6 +534,11 @@ bool QwtFigure::takeAxes(QwtPlot* plot)
         }
     }
     if (isRemove) {
+        for (const QPointer< QwtPlotAxisLink >& link : qAsConst(m_data->axisLinks)) {
+            if (link) {
+                link->removePlot(plot);
+            }
+        }
         // 处理寄生轴
         const QList< QwtPlot* > parasites = plot->parasitePlots();
         for (QwtPlot* para : parasites) {
@@ -512,13 +593,12 @@ void QwtFigure::clear()
                 ++removeCnt;
             }
         }
-        // 最后再统一删除item
-        for (int i = 0; i < itemCnt; ++i) {
-            QLayoutItem* item = lay->itemAt(i);
-            lay->removeItem(item);
+        // 最后再统一删除item，轻量坐标系也在这里删除
+        while (QLayoutItem* item = lay->takeAt(0)) {
             delete item;
         }
     }
+    clearAxisLinks();
     setCurrentAxes(nullptr);
     if (removeCnt > 0) {
         Q_EMIT figureCleared();
@@ -859,10 +939,11 @@ QList< QwtPlot* > QwtFigure::getParasiteAxes(QwtPlot* hostPlot) const
  * @brief Save the figure to a QPixmap with specified DPI/使用指定DPI将图形保存为QPixmap
  *
  * This method renders the figure to a QPixmap with the specified DPI.
- * If DPI is -1, the current screen DPI is used.
+ * If DPI is -1, the current screen DPI is used. Otherwise the plots are
+ * rendered again for the target resolution by renderFigure().
  *
  * 此方法将图形渲染为具有指定DPI的QPixmap。
- * 如果DPI为-1，则使用当前屏幕DPI。
+ * 如果DPI为-1，则使用当前屏幕DPI，否则通过renderFigure()在目标DPI下重新渲染绘图。
  *
  * @param dpi Dots per inch for the saved image (-1 to use screen DPI) / 保存图像的DPI（-1表示使用屏幕DPI）
  * @return QPixmap containing the rendered figure / 包含渲染图形的QPixmap
@@ -879,55 +960,32 @@ QList< QwtPlot* > QwtFigure::getParasiteAxes(QwtPlot* hostPlot) const
  */
 QPixmap QwtFigure::saveFig(int dpi) const
 {
-    // Calculate the target size based on DPI
-    QSize targetSize;
-    int targetDpi;
-
     if (dpi <= 0) {
-        QScreen* screen = QGuiApplication::primaryScreen();
-        targetDpi       = screen ? screen->logicalDotsPerInch() : 96;
-        targetSize      = size();
-    } else {
-        targetDpi                 = dpi;
-        QSizeF physicalSizeInches = getSizeInches();
-        targetSize                = QSize(static_cast< int >(physicalSizeInches.width() * dpi),
-                           static_cast< int >(physicalSizeInches.height() * dpi));
+        // No scaling needed, just grab the current state
+        return const_cast< QwtFigure* >(this)->grab();
     }
 
-    // Use const_cast to call non-const methods
-    QwtFigure* nonConstThis = const_cast< QwtFigure* >(this);
+    // 在目标DPI下重新渲染绘图，而不是对屏幕图像进行缩放
+    // The plots are rendered again for the target resolution instead of scaling a screen grab
+    const QSize targetSize = qwtFigureTargetSize(this, dpi);
 
-    if (dpi <= 0) {
-        // No scaling needed, just grab the current state
-        return nonConstThis->grab();
-    }
-    // Create pixmap with target size
-    QPixmap pixmap(targetSize);
+    // 设置DPI信息后，图像处理软件（如Photoshop、GIMP等）和打印机会知道如何正确解释图像的物理尺寸。
+    // 同时QwtPlotRenderer依据此DPI计算字体和线宽的缩放
+    // Convert DPI to dots per meter (1 inch = 2.54 cm, so 1 meter = 100/2.54 inches)
+    // 将DPI转换为每米的点数（1英寸=2.54厘米，所以1米=100/2.54英寸）
+    QImage image(targetSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDotsPerMeterX(qRound(dpi * 100 / 2.54));
+    image.setDotsPerMeterY(qRound(dpi * 100 / 2.54));
+    image.fill(Qt::transparent);
 
-    // Use QPainter for high-quality scaling
-    QPainter painter(&pixmap);
+    QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
     painter.setRenderHint(QPainter::TextAntialiasing);
 
-    // Calculate scaling factors
-    qreal scaleX = static_cast< qreal >(targetSize.width()) / width();
-    qreal scaleY = static_cast< qreal >(targetSize.height()) / height();
-    painter.scale(scaleX, scaleY);
-
-    // Render the figure with scaling
-    nonConstThis->render(&painter);
+    renderFigure(&painter, QRectF(QPointF(0.0, 0.0), targetSize));
     painter.end();
 
-    // Set DPI information if needed
-    // 当你在图像文件中设置DPI信息时，图像处理软件（如Photoshop、GIMP等）和打印机会知道如何正确解释图像的物理尺寸。
-    // 如果没有DPI信息，软件通常会使用默认的DPI（通常是72或96），这会导致物理尺寸计算错误。
-    // 不同的设备和软件可能有不同的默认DPI设置。明确设置DPI可以确保图像在所有平台上显示一致的物理尺寸。
-    QImage image = pixmap.toImage();
-    // Convert DPI to dots per meter (1 inch = 2.54 cm, so 1 meter = 100/2.54 inches)
-    // 将DPI转换为每米的点数（1英寸=2.54厘米，所以1米=100/2.54英寸）
-    image.setDotsPerMeterX(targetDpi * 100 / 2.54);
-    image.setDotsPerMeterY(targetDpi * 100 / 2.54);
     return QPixmap::fromImage(image);
 }
 
@@ -1012,13 +1070,232 @@ QPixmap QwtFigure::saveFig(QSizeF& inchesSize) const
  * // 使用300 DPI保存图形
  * figure.saveFig("high_res_figure.png", 300);
  * @endcode
+ *
+ * @note TIFF images larger than 256MB are exported by saveFigTiled(). Other formats - including
+ *       PNG - are always rendered into one image. Use TIFF for huge images.
+ *
+ * @note 超过256MB的TIFF图像自动改用saveFigTiled()分块导出；PNG等其他格式总是渲染为整张图像，
+ *       超大图像请使用TIFF
  */
 bool QwtFigure::saveFig(const QString& filename, int dpi) const
 {
+    if (dpi > 0) {
+        // 超大图片改为分块导出，避免一次性分配数GB内存
+        // Huge images are exported tile by tile to avoid allocating gigabytes at once
+        const QSize targetSize = qwtFigureTargetSize(this, dpi);
+        const qint64 numBytes  = qint64(targetSize.width()) * targetSize.height() * 4;
+
+        // saveFigTiled() supports TIFF only
+        const QString suffix = QFileInfo(filename).suffix().toLower();
+        const bool canStream = (suffix == "tif" || suffix == "tiff");
+
+        if (canStream && numBytes > Q_INT64_C(256) * 1024 * 1024) {
+            return saveFigTiled(filename, dpi);
+        }
+    }
+
     QPixmap pixmap = saveFig(dpi);
     return pixmap.save(filename, nullptr, -1);
 }
 
+/**
+ * @brief Save the figure tile by tile with bounded memory/分块渲染保存图形，内存占用与输出尺寸无关
+ *
+ * The figure is rendered in horizontal bands of tileHeight rows. For each band the plots
+ * are rendered again by QwtPlotRenderer for the target resolution - including the canvas items
+ * of their parasite axes - and the rows are streamed to the file. So the memory being
+ * needed depends on the width of the image and tileHeight only, what makes it possible
+ * to export posters with hundreds of megapixels.
+ *
+ * 图形按tileHeight行的水平条带渲染。每个条带中的绘图都通过QwtPlotRenderer在目标DPI下重新绘制
+ * （包括寄生轴的画布内容），渲染完成的行直接写入文件。内存占用只取决于图像宽度和tileHeight，
+ * 因此可以导出数亿像素的海报级图像。
+ *
+ * The only supported format is TIFF ( suffix "tif" or "tiff" ), where each band is written as a strip
+ * compressed with deflate and horizontal differencing. Other formats are rejected: the zlib stream
+ * of a PNG can't be compressed in independent parts, and a PNG with stored blocks would be about
+ * 4 bytes per pixel.
+ *
+ * 只支持TIFF格式（后缀为tif或tiff），每个条带作为一个使用deflate和水平差分压缩的strip写入。
+ * 其他格式会被拒绝：PNG的zlib流无法分段独立压缩，不压缩存储每像素约4字节。
+ *
+ * @param filename Name of the file / 文件名
+ * @param dpi Dots per inch (-1 to use the screen DPI) / 保存图像的DPI（-1表示使用屏幕DPI）
+ * @param tileHeight Number of rows being rendered at once / 每次渲染的行数
+ * @return true if saved successfully, false otherwise / 成功保存返回true，否则返回false
+ *
+ * @code
+ * // A0 poster with 600 DPI
+ * figure.setSizeInches(33.1, 46.8);
+ * figure.saveFigTiled("poster.tif", 600);
+ * @endcode
+ *
+ * @sa saveFig(), renderFigure()
+ */
+bool QwtFigure::saveFigTiled(const QString& filename, int dpi, int tileHeight) const
+{
+    if (dpi <= 0) {
+        dpi = logicalDpiX();
+    }
+
+    const QSize targetSize = qwtFigureTargetSize(this, dpi);
+    if (targetSize.isEmpty()) {
+        return false;
+    }
+
+    const QString suffix = QFileInfo(filename).suffix().toLower();
+    if (suffix != "tif" && suffix != "tiff") {
+        qWarning() << "QwtFigure::saveFigTiled: unsupported format" << suffix << ", only TIFF can be written tile by tile";
+        return false;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    const int bandHeight = qBound(1, tileHeight, targetSize.height());
+    QwtFigureTiffWriter writer;
+    if (!writer.begin(&file, targetSize, dpi, bandHeight)) {
+        return false;
+    }
+
+    QImage band(targetSize.width(), bandHeight, QImage::Format_RGBA8888_Premultiplied);
+    band.setDotsPerMeterX(qRound(dpi * 100 / 2.54));
+    band.setDotsPerMeterY(qRound(dpi * 100 / 2.54));
+
+    for (int y = 0; y < targetSize.height(); y += bandHeight) {
+        const int numRows = qMin(bandHeight, targetSize.height() - y);
+
+        band.fill(Qt::transparent);
+
+        QPainter painter(&band);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setClipRect(0, 0, band.width(), numRows);
+        painter.translate(0, -y);
+
+        renderFigure(&painter, QRectF(QPointF(0.0, 0.0), targetSize));
+        painter.end();
+
+        if (!writer.writeRows(band, numRows)) {
+            return false;
+        }
+    }
+
+    return writer.end();
+}
+
+/**
+ * @brief Render the figure into a rectangle of a painter/将图形渲染到绘图设备的指定矩形中
+ *
+ * The background and the border of the figure are painted, the plots are rendered by QwtPlotRenderer
+ * and all other widgets by QWidget::render(). Parts of the figure outside of the clip region of
+ * the painter are skipped.
+ *
+ * 绘制图形的背景和边框，绘图通过QwtPlotRenderer渲染，其它窗口通过QWidget::render()渲染。
+ * 位于画笔裁剪区域之外的部分会被跳过。
+ *
+ * @param painter Painter / 画笔
+ * @param targetRect Target rectangle in painter coordinates / 目标矩形（画笔坐标）
+ * @note The layout of the plots matches the screen, when the ratio between targetRect and the size of the
+ *       figure is the ratio between the resolutions of the paint device and the screen.
+ *       当targetRect与图形尺寸的比例等于绘图设备与屏幕分辨率的比例时，绘图的布局与屏幕一致。
+ */
+void QwtFigure::renderFigure(QPainter* painter, const QRectF& targetRect) const
+{
+    if (painter == nullptr || !painter->isActive() || targetRect.isEmpty() || size().isEmpty()) {
+        return;
+    }
+
+    const qreal sx = targetRect.width() / width();
+    const qreal sy = targetRect.height() / height();
+
+    QTransform transform;
+    transform.translate(targetRect.x(), targetRect.y());
+    transform.scale(sx, sy);
+
+    const QRectF clipRect = painter->hasClipping() ? painter->clipBoundingRect() : targetRect;
+
+    painter->save();
+
+    painter->fillRect(targetRect, m_data->faceBrush);
+
+    // the lightweight axes are painted below the widgets, like on screen
+    const QList< QwtLightweightAxes* > axesList = allLightweightAxes();
+    for (const QwtLightweightAxes* axes : axesList) {
+        if (!transform.mapRect(QRectF(axes->geometry())).intersects(clipRect)) {
+            continue;
+        }
+
+        painter->save();
+        painter->setWorldTransform(transform, true);
+        axes->draw(painter, QRectF(axes->geometry()));
+        painter->restore();
+    }
+
+    QwtFigurePlotRenderer renderer;
+    QLayout* lay = layout();
+
+    // children() 越靠后 z 越高，只渲染布局管理的窗口
+    const QObjectList& oc = children();
+    for (QObject* obj : oc) {
+        QWidget* w = qobject_cast< QWidget* >(obj);
+        if (w == nullptr || w->isHidden() || !lay || lay->indexOf(w) < 0) {
+            continue;
+        }
+
+        const QRectF widgetRect = transform.mapRect(QRectF(w->geometry()));
+        if (!widgetRect.intersects(clipRect)) {
+            continue;
+        }
+
+        QwtPlot* plot = qobject_cast< QwtPlot* >(w);
+        if (plot && plot->isHostPlot()) {
+            renderer.render(plot, painter, widgetRect);
+
+            // the canvas items of the parasites have been drawn by the renderer, their axes are children of the host
+            const QList< QwtPlot* > parasites = plot->parasitePlots();
+            for (QwtPlot* parasite : parasites) {
+                if (parasite->isHidden()) {
+                    continue;
+                }
+
+                for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+                    QwtScaleWidget* scaleWidget = parasite->axisWidget(axisPos);
+                    if (!scaleWidget || !parasite->isAxisVisible(axisPos)) {
+                        continue;
+                    }
+
+                    const QRect scaleRect(scaleWidget->mapTo(this, QPoint(0, 0)), scaleWidget->size());
+                    if (transform.mapRect(QRectF(scaleRect)).intersects(clipRect)) {
+                        painter->save();
+                        painter->setWorldTransform(transform, true);
+                        scaleWidget->render(painter, scaleRect.topLeft(), QRegion(), QWidget::DrawChildren);
+                        painter->restore();
+                    }
+                }
+            }
+        } else {
+            painter->save();
+            painter->setWorldTransform(transform, true);
+            w->render(painter, w->pos(), QRegion(), QWidget::DrawWindowBackground | QWidget::DrawChildren);
+            painter->restore();
+        }
+    }
+
+    if (m_data->edgeLineWidth > 0) {
+        QPen pen(m_data->edgeColor);
+        pen.setWidthF(m_data->edgeLineWidth * sx);
+        painter->setPen(pen);
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(transform.mapRect(QRectF(rect().adjusted(1, 1, -1, -1))));
+    }
+
+    painter->restore();
+}
+
 /**
  * @brief Set the current axes (plot)/设置当前坐标轴（绘图）
  *
@@ -1196,6 +1473,210 @@ void QwtFigure::replotAll()
     for (QwtPlot* plot : plots) {
         plot->replotAll();
     }
+
+    const QList< QwtLightweightAxes* > axesList = allLightweightAxes();
+    for (QwtLightweightAxes* axes : axesList) {
+        axes->invalidate();
+        axes->replot();
+    }
+}
+
+/**
+ * @brief Add lightweight axes with normalized coordinates/使用归一化坐标添加轻量坐标系
+ *
+ * A lightweight axes has no widgets of its own. It is laid out by QwtFigureLayout like a plot and
+ * painted by the figure into a backing store, that is shared by all lightweight axes of the figure.
+ * This is the cheap alternative to addAxes() for grids with many small subplots.
+ *
+ * 轻量坐标系没有自己的窗口，和绘图一样由QwtFigureLayout布局，由figure绘制到所有轻量坐标系共享的缓存中。
+ * 对于包含大量小子图的网格，这是比addAxes()开销低得多的方式。
+ *
+ * @param rect Normalized coordinates [left, top, width, height] in range [0,1]
+ *              归一化坐标 [左, 上, 宽, 高]，范围 [0,1]
+ * @return The new axes, owned by the figure / 新的坐标系，由figure持有
+ * @sa QwtLightweightAxes, addGridLightweightAxes(), removeLightweightAxes()
+ */
+QwtLightweightAxes* QwtFigure::addLightweightAxes(const QRectF& rect)
+{
+    QWTFIGURE_SAFEGET_LAY_RET(lay, nullptr)
+
+    QwtLightweightAxes* axes = new QwtLightweightAxes(this);
+    lay->addLayoutItem(axes, rect);
+    lay->invalidate();
+    update();
+
+    return axes;
+}
+
+/**
+ * @brief Add lightweight axes by grid layout/添加轻量坐标系到网格布局
+ *
+ * @param rowCnt Number of rows in the grid / 网格行数
+ * @param colCnt Number of columns in the grid / 网格列数
+ * @param row Grid row position (0-based) / 网格行位置（从0开始）
+ * @param col Grid column position (0-based) / 网格列位置（从0开始）
+ * @param rowSpan Number of rows to span (default: 1) / 跨行数（默认：1）
+ * @param colSpan Number of columns to span (default: 1) / 跨列数（默认：1）
+ * @param wspace Horizontal space between subplots [0,1] / 子图之间的水平间距 [0,1]
+ * @param hspace Vertical space between subplots [0,1] / 子图之间的垂直间距 [0,1]
+ * @return The new axes, owned by the figure, or nullptr for invalid grid parameters / 新的坐标系，网格参数无效时返回nullptr
+ * @sa addLightweightAxes()
+ */
+QwtLightweightAxes* QwtFigure::addGridLightweightAxes(int rowCnt,
+                                                      int colCnt,
+                                                      int row,
+                                                      int col,
+                                                      int rowSpan,
+                                                      int colSpan,
+                                                      qreal wspace,
+                                                      qreal hspace)
+{
+    QWTFIGURE_SAFEGET_LAY_RET(lay, nullptr)
+
+    QwtLightweightAxes* axes = new QwtLightweightAxes(this);
+    if (!lay->addGridLayoutItem(axes, rowCnt, colCnt, row, col, rowSpan, colSpan, wspace, hspace)) {
+        delete axes;
+        return nullptr;
+    }
+    lay->invalidate();
+    update();
+
+    return axes;
+}
+
+/**
+ * @brief Remove and delete lightweight axes/移除并删除轻量坐标系
+ * @param axes Axes of this figure / 本figure的轻量坐标系
+ */
+void QwtFigure::removeLightweightAxes(QwtLightweightAxes* axes)
+{
+    QWTFIGURE_SAFEGET_LAY(lay)
+    if (!axes || lay->indexOf(axes) < 0) {
+        return;
+    }
+
+    lay->removeItem(axes);
+    delete axes;
+
+    update();
+}
+
+/**
+ * @brief All lightweight axes of the figure in the order they have been added/按添加顺序返回所有轻量坐标系
+ */
+QList< QwtLightweightAxes* > QwtFigure::allLightweightAxes() const
+{
+    QList< QwtLightweightAxes* > axesList;
+
+    QLayout* lay = layout();
+    if (lay) {
+        for (int i = 0; i < lay->count(); ++i) {
+            if (QwtLightweightAxes* axes = dynamic_cast< QwtLightweightAxes* >(lay->itemAt(i))) {
+                axesList.append(axes);
+            }
+        }
+    }
+    return axesList;
+}
+
+/**
+ * @brief 获取在此坐标下的轻量坐标系，如果此坐标下没有，则返回nullptr
+ * @param pos 坐标
+ * @return 如果有重叠，返回最后添加的坐标系
+ */
+QwtLightweightAxes* QwtFigure::lightweightAxesUnderPos(const QPoint& pos) const
+{
+    const QList< QwtLightweightAxes* > axesList = allLightweightAxes();
+    for (int i = axesList.size() - 1; i >= 0; --i) {
+        if (axesList[ i ]->geometry().contains(pos)) {
+            return axesList[ i ];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief The layout engine of all lightweight axes/所有轻量坐标系共用的布局引擎
+ *
+ * Spacing and canvas margins are the same for all lightweight axes of the figure. After changing
+ * them replotAll() has to be called.
+ *
+ * 所有轻量坐标系的间距和画布边距相同，修改后需要调用replotAll()
+ */
+QwtPlotLayoutEngine* QwtFigure::lightweightLayoutEngine()
+{
+    return &m_data->lightweightLayoutEngine;
+}
+
+const QwtPlotLayoutEngine* QwtFigure::lightweightLayoutEngine() const
+{
+    return &m_data->lightweightLayoutEngine;
+}
+
+/**
+ * @brief Render the area of an axes in the backing store again/重绘缓存中坐标系所在的区域
+ * @note Called by QwtLightweightAxes::replot()
+ */
+void QwtFigure::updateLightweightAxes(QwtLightweightAxes* axes)
+{
+    m_data->lightweightDirtyRegion += axes->geometry();
+    update(axes->geometry());
+}
+
+/**
+ * @brief Draw the lightweight axes from the shared backing store/从共享缓存绘制轻量坐标系
+ *
+ * The backing store is rendered completely, when the size of the figure or the geometry of an axes
+ * has changed. Otherwise only the areas of the axes, that have been replotted, are rendered again.
+ *
+ * @param painter Painter of the figure / figure的画笔
+ */
+void QwtFigure::drawLightweightAxes(QPainter* painter)
+{
+    const QList< QwtLightweightAxes* > axesList = allLightweightAxes();
+    if (axesList.isEmpty()) {
+        m_data->lightweightCache = QPixmap();
+        m_data->lightweightCacheKey.clear();
+        m_data->lightweightDirtyRegion = QRegion();
+        return;
+    }
+
+    QVector< QRect > key;
+    key.reserve(axesList.size() + 1);
+    for (const QwtLightweightAxes* axes : axesList) {
+        key.append(axes->geometry());
+    }
+    key.append(rect());
+
+    QPixmap& cache      = m_data->lightweightCache;
+    QRegion dirtyRegion = m_data->lightweightDirtyRegion;
+
+    if (cache.isNull() || key != m_data->lightweightCacheKey) {
+        cache = QwtPainter::backingStore(this, size());
+        cache.fill(Qt::transparent);
+
+        dirtyRegion                 = QRegion(rect());
+        m_data->lightweightCacheKey = key;
+    }
+    m_data->lightweightDirtyRegion = QRegion();
+
+    if (!dirtyRegion.isEmpty()) {
+        QPainter p(&cache);
+        p.setRenderHints(painter->renderHints());
+        p.setClipRegion(dirtyRegion);
+
+        p.setCompositionMode(QPainter::CompositionMode_Source);
+        p.fillRect(rect(), Qt::transparent);
+        p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+        for (const QwtLightweightAxes* axes : axesList) {
+            if (dirtyRegion.intersects(axes->geometry())) {
+                axes->draw(&p, QRectF(axes->geometry()));
+            }
+        }
+    }
+
+    painter->drawPixmap(0, 0, cache);
 }
 
 /**
@@ -1287,6 +1768,97 @@ void QwtFigure::applyAlignmentsForAxis(int axisId)
     }
 }
 
+/**
+ * @brief Link an axis of several plots/联动多个绘图的坐标轴
+ *
+ * All plots show the same scale on @p axisId. The autoscale interval is united over the items
+ * of all plots once, one QwtScaleDiv is propagated to every plot and the repaints are coalesced.
+ * This is much cheaper than connecting the scale signals of the plots to each other,
+ * where every plot runs its own autoscaling and replot.
+ *
+ * 所有绘图的@p axisId 轴显示相同的刻度。自动缩放的范围只对所有绘图的item合并计算一次，
+ * 同一个QwtScaleDiv同步到所有绘图并合并重绘，比把各个绘图的刻度信号互相连接要高效得多
+ *
+ * @param plots 需要联动的绘图，不在figure中的绘图会被忽略
+ * @param axisId 联动的轴ID（QwtAxis::XTop/XBottom/YLeft/YRight）
+ * @return 新建的联动组，由figure管理其生命周期；如果没有有效的绘图返回nullptr
+ * @note 绘图的坐标轴如果已经在其它联动组中，会先从原联动组中移除
+ * @sa QwtPlotAxisLink
+ */
+QwtPlotAxisLink* QwtFigure::linkAxes(const QList< QwtPlot* >& plots, int axisId)
+{
+    if (plots.isEmpty() || !QwtAxis::isValid(axisId)) {
+        return nullptr;
+    }
+    QList< QwtPlot* > validPlots;
+    for (QwtPlot* plot : plots) {
+        if (plot && hasAxes(plot) && !validPlots.contains(plot)) {
+            validPlots.append(plot);
+        }
+    }
+    if (validPlots.isEmpty()) {
+        return nullptr;
+    }
+
+    QwtPlotAxisLink* link = new QwtPlotAxisLink(this);
+    for (QwtPlot* plot : qAsConst(validPlots)) {
+        link->addPlot(plot, axisId);
+    }
+    m_data->axisLinks.append(link);
+    return link;
+}
+
+/**
+ * @brief 把绘图从指定轴的联动组中移除
+ * @param plot 绘图
+ * @param axisId 轴ID
+ * @return 成功移除返回true
+ * @note 联动组中没有绘图后会被删除
+ */
+bool QwtFigure::unlinkAxes(QwtPlot* plot, int axisId)
+{
+    if (!plot || !QwtAxis::isValid(axisId)) {
+        return false;
+    }
+    QwtPlotAxisLink* link = plot->axisLink(axisId);
+    if (!link || !m_data->axisLinks.contains(link)) {
+        return false;
+    }
+    link->removePlot(plot);
+    if (link->plots().isEmpty()) {
+        m_data->axisLinks.removeAll(link);
+        link->deleteLater();
+    }
+    return true;
+}
+
+/**
+ * @brief 所有的联动组
+ * @return
+ */
+QList< QwtPlotAxisLink* > QwtFigure::axisLinks() const
+{
+    QList< QwtPlotAxisLink* > res;
+    for (const QPointer< QwtPlotAxisLink >& link : qAsConst(m_data->axisLinks)) {
+        if (link) {
+            res.append(link.data());
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief 清除所有联动组，坐标轴恢复到联动前的自动缩放状态
+ */
+void QwtFigure::clearAxisLinks()
+{
+    const QList< QPointer< QwtPlotAxisLink > > links = m_data->axisLinks;
+    m_data->axisLinks.clear();
+    for (const QPointer< QwtPlotAxisLink >& link : links) {
+        delete link.data();
+    }
+}
+
 /**
  * @brief QwtPlot轴对齐函数
  * @param plots 待对齐的QwtPlot列表（非空）
@@ -1376,6 +1948,9 @@ void QwtFigure::paintEvent(QPaintEvent* event)
     // Draw background
     painter.fillRect(rect(), m_data->faceBrush);
 
+    // Draw the axes, that have no widgets
+    drawLightweightAxes(&painter);
+
     // Draw border
     if (m_data->edgeLineWidth > 0) {
         QPen pen(m_data->edgeColor);
@@ -7,11 +7,15 @@
 #include <QFrame>
 class QResizeEvent;
 class QPaintEvent;
+class QPainter;
 
 // qwt
 #include "qwt_global.h"
 #include "qwt_axis.h"
 class QwtPlot;
+class QwtPlotAxisLink;
+class QwtPlotLayoutEngine;
+class QwtLightweightAxes;
 
 /**
  * @class QwtFigure
@@ -181,6 +185,12 @@ public:
     // Save the figure to a file with specified DPI/使用指定DPI将图形保存到文件
     bool saveFig(const QString& filename, int dpi = -1) const;
 
+    // Save the figure tile by tile with bounded memory (PNG/TIFF)/分块渲染保存图形，内存占用与输出尺寸无关（PNG/TIFF）
+    bool saveFigTiled(const QString& filename, int dpi = -1, int tileHeight = 256) const;
+
+    // Render the figure into a rectangle of a painter/将图形渲染到绘图设备的指定矩形中
+    void renderFigure(QPainter* painter, const QRectF& targetRect) const;
+
     // Set the current axes (plot)/设置当前坐标轴（绘图）
     void setCurrentAxes(QwtPlot* plot);
     void sca(QwtPlot* plot);
@@ -201,6 +211,27 @@ public:
     QRect calcActualRect(const QRectF& normRect);
     // 更新所有的绘图
     void replotAll();
+
+    //=============LightweightAxes==================
+    // Add axes without widgets, painted by the figure/添加没有窗口的轻量坐标系，由figure绘制
+    QwtLightweightAxes* addLightweightAxes(const QRectF& rect);
+    QwtLightweightAxes* addGridLightweightAxes(int rowCnt,
+                                               int colCnt,
+                                               int row,
+                                               int col,
+                                               int rowSpan  = 1,
+                                               int colSpan  = 1,
+                                               qreal wspace = 0.0,
+                                               qreal hspace = 0.0);
+    // 移除并删除轻量坐标系
+    void removeLightweightAxes(QwtLightweightAxes* axes);
+    // 所有的轻量坐标系
+    QList< QwtLightweightAxes* > allLightweightAxes() const;
+    // 获取在此坐标下的轻量坐标系，如果此坐标下没有，则返回nullptr
+    QwtLightweightAxes* lightweightAxesUnderPos(const QPoint& pos) const;
+    // 所有轻量坐标系共用的布局引擎
+    QwtPlotLayoutEngine* lightweightLayoutEngine();
+    const QwtPlotLayoutEngine* lightweightLayoutEngine() const;
     //=============AxisAlignment==================
     // 添加轴对齐配置
     void addAxisAlignment(const QList< QwtPlot* >& plots, int axisId);
@@ -212,6 +243,15 @@ public:
     void applyAllAxisAlignments(bool replot = true);
     // 应用指定轴ID的所有对齐配置
     void applyAlignmentsForAxis(int axisId);
+    //=============AxisLink==================
+    // 联动坐标轴，所有绘图的指定轴共享一个刻度，统一计算自动缩放范围并合并重绘
+    QwtPlotAxisLink* linkAxes(const QList< QwtPlot* >& plots, int axisId);
+    // 把绘图从指定轴的联动组中移除
+    bool unlinkAxes(QwtPlot* plot, int axisId);
+    // 所有的联动组
+    QList< QwtPlotAxisLink* > axisLinks() const;
+    // 清除所有联动组
+    void clearAxisLinks();
 Q_SIGNALS:
     /**
      * @brief Signal emitted when axes are added to the figure/当坐标轴添加到图形时发出的信号
@@ -247,6 +287,11 @@ public:
 protected:
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+
+private:
+    friend class QwtLightweightAxes;
+    void updateLightweightAxes(QwtLightweightAxes* axes);
+    void drawLightweightAxes(QPainter* painter);
 };
 
 #endif  // QWT_FIGURE_H
@@ -114,7 +114,15 @@ void QwtFigureLayout::setGeometry(const QRect& rect)
              << ",right=" << m_data->m_right << ",bottom=" << m_data->m_bottom << ",top=" << m_data->m_top;
 #endif
     for (const auto& item : qAsConst(m_data->m_items)) {
-        if (!item.item || !item.item->widget() || !item.item->widget()->isVisibleTo(item.item->widget()->parentWidget())) {
+        if (!item.item) {
+            continue;
+        }
+        if (QWidget* w = item.item->widget()) {
+            if (!w->isVisibleTo(w->parentWidget())) {
+                continue;
+            }
+        } else if (item.item->isEmpty()) {
+            // items without widget, like QwtLightweightAxes
             continue;
         }
         // Convert normalized coordinates to actual pixels using Qt's top-left coordinate system
@@ -177,7 +185,28 @@ void QwtFigureLayout::addAxes(QWidget* widget, const QRectF& rect)
         return;
     }
 
-    QLayoutItem* item = new QWidgetItem(widget);
+    addLayoutItem(new QWidgetItem(widget), rect);
+}
+
+/**
+ * @brief Add a layout item with normalized coordinates/使用归一化坐标添加布局项
+ *
+ * Used for items without widget, like QwtLightweightAxes. The layout takes ownership of the item.
+ *
+ * 用于没有窗口的布局项，例如QwtLightweightAxes，布局获得item的所有权
+ *
+ * @param item Layout item to add / 要添加的布局项
+ * @param rect Normalized coordinates [left, top, width, height] in range [0,1]
+ *              归一化坐标 [左, 上, 宽, 高]，范围 [0,1]
+ * @sa addAxes()
+ */
+void QwtFigureLayout::addLayoutItem(QLayoutItem* item, const QRectF& rect)
+{
+    if (!item) {
+        qWarning() << "Attempted to add null item to QwtFigureLayout";
+        return;
+    }
+
     QwtFigureLayout::PrivateData::LayoutItem li;
     li.item     = item;
     li.normRect = rect;
@@ -325,25 +354,65 @@ void QwtFigureLayout::addGridAxes(QWidget* widget,
         qWarning() << "QwtFigureLayout::addToGrid get a null widget";
         return;
     }
+
+    QLayoutItem* item = new QWidgetItem(widget);
+    if (!addGridLayoutItem(item, rowCnt, colCnt, row, col, rowSpan, colSpan, wspace, hspace)) {
+        delete item;
+    }
+}
+
+/**
+ * @brief Add a layout item by grid layout/添加布局项到网格布局
+ *
+ * Used for items without widget, like QwtLightweightAxes. On success the layout takes ownership of the item.
+ *
+ * 用于没有窗口的布局项，例如QwtLightweightAxes，添加成功后布局获得item的所有权
+ *
+ * @param item Layout item to add / 要添加的布局项
+ * @param rowCnt Total number of rows in the grid / 网格总行数
+ * @param colCnt Total number of columns in the grid / 网格总列数
+ * @param row Grid row position (0-based) / 网格行位置（从0开始）
+ * @param col Grid column position (0-based) / 网格列位置（从0开始）
+ * @param rowSpan Number of rows to span / 跨行数
+ * @param colSpan Number of columns to span / 跨列数
+ * @param wspace Horizontal space between subplots [0,1] / 子图之间的水平间距 [0,1]
+ * @param hspace Vertical space between subplots [0,1] / 子图之间的垂直间距 [0,1]
+ * @return false, when the grid parameters are invalid / 网格参数无效时返回false
+ * @sa addGridAxes()
+ */
+bool QwtFigureLayout::addGridLayoutItem(QLayoutItem* item,
+                                        int rowCnt,
+                                        int colCnt,
+                                        int row,
+                                        int col,
+                                        int rowSpan,
+                                        int colSpan,
+                                        qreal wspace,
+                                        qreal hspace)
+{
+    if (!item) {
+        qWarning() << "QwtFigureLayout::addToGrid get a null item";
+        return false;
+    }
     if (row < 0 || col < 0 || rowSpan <= 0 || colSpan <= 0 || rowCnt <= 0 || colCnt <= 0) {
         qWarning()
             << "QwtFigureLayout::addToGrid Grid row, column, rowSpan, colSpan, rowCnt and colCnt should be positive.";
-        return;
+        return false;
     }
 
     if (row + rowSpan > rowCnt || col + colSpan > colCnt) {
         qWarning() << "QwtFigureLayout::addToGrid Grid position and span exceed grid dimensions.";
-        return;
+        return false;
     }
 
     // Calculate normalized coordinates
     QRectF normRect = calcGridRect(rowCnt, colCnt, row, col, rowSpan, colSpan, wspace, hspace);
 
-    QLayoutItem* item = new QWidgetItem(widget);
     QwtFigureLayout::PrivateData::LayoutItem li;
     li.item     = item;
     li.normRect = normRect;
     m_data->m_items.append(li);
+    return true;
 }
 
 /**
@@ -49,6 +49,18 @@ public:
                      qreal wspace = 0.0,
                      qreal hspace = 0.0);
 
+    // Add a layout item without widget/添加没有窗口的布局项
+    void addLayoutItem(QLayoutItem* item, const QRectF& rect);
+    bool addGridLayoutItem(QLayoutItem* item,
+                           int rowCnt,
+                           int colCnt,
+                           int row,
+                           int col,
+                           int rowSpan  = 1,
+                           int colSpan  = 1,
+                           qreal wspace = 0.0,
+                           qreal hspace = 0.0);
+
     // 改变已经添加的窗口的位置占比,如果窗口还没添加，此函数无效
     void setAxesNormPos(QWidget* widget, const QRectF& rect);
 
@@ -0,0 +1,163 @@
+﻿#include "qwt_figure_tiff_writer.h"
+// Qt
+#include <QIODevice>
+#include <QImage>
+#include <QByteArray>
+#include <QDebug>
+
+QwtFigureTiffWriter::QwtFigureTiffWriter()
+{
+}
+
+/**
+ * @brief Write the header of the file / 写入文件头
+ * @param device Open device, that supports seeking / 已打开且支持seek的设备
+ * @param size Size of the image / 图像尺寸
+ * @param dpi Resolution / 分辨率
+ * @param rowsPerBand Number of rows of each band, the last one might be smaller / 每个条带的行数，最后一个条带可以更少
+ */
+bool QwtFigureTiffWriter::begin(QIODevice* device, const QSize& size, int dpi, int rowsPerBand)
+{
+    m_device      = device;
+    m_size        = size;
+    m_dpi         = dpi;
+    m_rowsPerBand = rowsPerBand;
+    m_stripOffsets.clear();
+    m_stripByteCounts.clear();
+
+    QByteArray header("II");
+    appendUInt16(header, 42);
+    appendUInt32(header, 0);  // offset of the directory, patched in end()
+
+    return m_device->write(header) == header.size();
+}
+
+/**
+ * @brief Write the first numRows rows of band as a strip / 把band的前numRows行写为一个strip
+ */
+bool QwtFigureTiffWriter::writeRows(const QImage& band, int numRows)
+{
+    const int rowSize = band.width() * 4;
+
+    QByteArray raw;
+    raw.resize(numRows * rowSize);
+    for (int y = 0; y < numRows; y++) {
+        const uchar* src = band.constScanLine(y);
+        uchar* dst       = reinterpret_cast< uchar* >(raw.data()) + y * rowSize;
+
+        // horizontal differencing ( predictor 2 ) makes uniform areas compress well
+        for (int i = 0; i < 4 && i < rowSize; i++)
+            dst[ i ] = src[ i ];
+        for (int i = 4; i < rowSize; i++)
+            dst[ i ] = uchar(src[ i ] - src[ i - 4 ]);
+    }
+
+    // qCompress prepends the uncompressed size to the zlib stream
+    const QByteArray strip = qCompress(raw, 6).mid(4);
+
+    const qint64 offset = m_device->pos();
+    if (offset + strip.size() > Q_INT64_C(0xffffffff)) {
+        qWarning() << "QwtFigure: the image exceeds the 4GB limit of TIFF";
+        return false;
+    }
+
+    m_stripOffsets += quint32(offset);
+    m_stripByteCounts += quint32(strip.size());
+
+    return m_device->write(strip) == strip.size();
+}
+
+/**
+ * @brief Write the directory and patch its offset into the header / 写入目录并在文件头中记录其位置
+ */
+bool QwtFigureTiffWriter::end()
+{
+    // word alignment of the values, that are referenced from the directory
+    if (m_device->pos() % 2)
+        m_device->write("\0", 1);
+
+    const quint32 valuesOffset = quint32(m_device->pos());
+
+    QByteArray values;
+    appendUInt32(values, m_dpi);  // XResolution
+    appendUInt32(values, 1);
+    appendUInt32(values, m_dpi);  // YResolution
+    appendUInt32(values, 1);
+    for (int i = 0; i < 4; i++)
+        appendUInt16(values, 8);  // BitsPerSample
+
+    const quint32 stripOffsetsOffset = valuesOffset + values.size();
+    for (quint32 offset : qAsConst(m_stripOffsets))
+        appendUInt32(values, offset);
+
+    const quint32 stripByteCountsOffset = valuesOffset + values.size();
+    for (quint32 count : qAsConst(m_stripByteCounts))
+        appendUInt32(values, count);
+
+    // a single value is stored in the directory entry itself
+    const quint32 numStrips = quint32(m_stripOffsets.size());
+    const quint32 stripOffsets    = (numStrips == 1) ? m_stripOffsets.first() : stripOffsetsOffset;
+    const quint32 stripByteCounts = (numStrips == 1) ? m_stripByteCounts.first() : stripByteCountsOffset;
+
+    enum
+    {
+        Short    = 3,
+        Long     = 4,
+        Rational = 5
+    };
+
+    QByteArray ifd;
+    appendUInt16(ifd, 15);
+    appendEntry(ifd, 256, Long, 1, m_size.width());            // ImageWidth
+    appendEntry(ifd, 257, Long, 1, m_size.height());           // ImageLength
+    appendEntry(ifd, 258, Short, 4, valuesOffset + 16);        // BitsPerSample
+    appendEntry(ifd, 259, Short, 1, 8);                        // Compression: deflate
+    appendEntry(ifd, 262, Short, 1, 2);                        // PhotometricInterpretation: RGB
+    appendEntry(ifd, 273, Long, numStrips, stripOffsets);      // StripOffsets
+    appendEntry(ifd, 277, Short, 1, 4);                        // SamplesPerPixel
+    appendEntry(ifd, 278, Long, 1, m_rowsPerBand);             // RowsPerStrip
+    appendEntry(ifd, 279, Long, numStrips, stripByteCounts);   // StripByteCounts
+    appendEntry(ifd, 282, Rational, 1, valuesOffset);          // XResolution
+    appendEntry(ifd, 283, Rational, 1, valuesOffset + 8);      // YResolution
+    appendEntry(ifd, 284, Short, 1, 1);                        // PlanarConfiguration: contiguous
+    appendEntry(ifd, 296, Short, 1, 2);                        // ResolutionUnit: inch
+    appendEntry(ifd, 317, Short, 1, 2);                        // Predictor: horizontal differencing
+    appendEntry(ifd, 338, Short, 1, 1);                        // ExtraSamples: associated alpha
+    appendUInt32(ifd, 0);                                      // no further directory
+
+    const qint64 ifdOffset = valuesOffset + values.size();
+    if (ifdOffset + ifd.size() > Q_INT64_C(0xffffffff)) {
+        qWarning() << "QwtFigure: the image exceeds the 4GB limit of TIFF";
+        return false;
+    }
+
+    if (m_device->write(values) != values.size() || m_device->write(ifd) != ifd.size())
+        return false;
+
+    QByteArray header;
+    appendUInt32(header, quint32(ifdOffset));
+
+    return m_device->seek(4) && m_device->write(header) == header.size();
+}
+
+void QwtFigureTiffWriter::appendUInt16(QByteArray& data, quint16 value)
+{
+    data.append(char(value & 0xff));
+    data.append(char(value >> 8));
+}
+
+void QwtFigureTiffWriter::appendUInt32(QByteArray& data, quint32 value)
+{
+    appendUInt16(data, quint16(value & 0xffff));
+    appendUInt16(data, quint16(value >> 16));
+}
+
+void QwtFigureTiffWriter::appendEntry(QByteArray& data, quint16 tag, quint16 type, quint32 count, quint32 value)
+{
+    appendUInt16(data, tag);
+    appendUInt16(data, type);
+    appendUInt32(data, count);
+
+    // values of type SHORT are left justified, what is the first 2 bytes in little endian
+    appendUInt32(data, value);
+}
@@ -0,0 +1,47 @@
+﻿#ifndef QWT_FIGURE_TIFF_WRITER_H
+#define QWT_FIGURE_TIFF_WRITER_H
+// Qt
+#include <QSize>
+#include <QVector>
+class QIODevice;
+class QImage;
+class QByteArray;
+
+/**
+ * @brief Streaming TIFF writer of QwtFigure::saveFigTiled()
+ * @brief QwtFigure::saveFigTiled()使用的流式TIFF写入器
+ *
+ * The image is written band by band, without holding the complete image in memory.
+ * Each band is written as a strip, compressed with deflate and horizontal differencing.
+ * The alpha channel is stored as associated ( premultiplied ) alpha, what matches
+ * the rendered rows. The directory is written at the end of the file.
+ *
+ * 图像按条带逐个写入，无需在内存中保存整张图片。每个条带作为一个strip，使用deflate和水平差分压缩；
+ * alpha通道按预乘alpha存储，与渲染的行一致；目录写在文件末尾。
+ *
+ * @note Internal class, not part of the public API / 内部类，不属于公开接口
+ */
+class QwtFigureTiffWriter
+{
+public:
+    QwtFigureTiffWriter();
+
+    bool begin(QIODevice* device, const QSize& size, int dpi, int rowsPerBand);
+    // rows of band are in QImage::Format_RGBA8888_Premultiplied
+    bool writeRows(const QImage& band, int numRows);
+    bool end();
+
+private:
+    static void appendUInt16(QByteArray& data, quint16 value);
+    static void appendUInt32(QByteArray& data, quint32 value);
+    static void appendEntry(QByteArray& data, quint16 tag, quint16 type, quint32 count, quint32 value);
+
+    QIODevice* m_device { nullptr };
+    QSize m_size;
+    int m_dpi { 0 };
+    int m_rowsPerBand { 0 };
+    QVector< quint32 > m_stripOffsets;
+    QVector< quint32 > m_stripByteCounts;
+};
+
+#endif  // QWT_FIGURE_TIFF_WRITER_H
@@ -32,6 +32,7 @@
 #include "qwt_utils.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qpalette.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
@@ -104,6 +105,9 @@ public:
     double totalAngle;
 
     double mouseOffset;
+
+    // scale and knob, that don't depend on the value
+    QPixmap pixmapCache;
 };
 
 /*!
@@ -147,6 +151,7 @@ void QwtKnob::setKnobStyle(KnobStyle knobStyle)
 {
     if (m_data->knobStyle != knobStyle) {
         m_data->knobStyle = knobStyle;
+        invalidateCache();
         update();
     }
 }
@@ -203,6 +208,7 @@ void QwtKnob::setTotalAngle(double angle)
         m_data->totalAngle = angle;
 
         scaleDraw()->setAngleRange(-0.5 * m_data->totalAngle, 0.5 * m_data->totalAngle);
+        invalidateCache();
 
         updateGeometry();
         update();
@@ -239,6 +245,7 @@ void QwtKnob::setNumTurns(int numTurns)
         m_data->totalAngle = angle;
 
         scaleDraw()->setAngleRange(-0.5 * m_data->totalAngle, 0.5 * m_data->totalAngle);
+        invalidateCache();
 
         updateGeometry();
         update();
@@ -270,6 +277,8 @@ void QwtKnob::setScaleDraw(QwtRoundScaleDraw* scaleDraw)
     setAbstractScaleDraw(scaleDraw);
     setTotalAngle(m_data->totalAngle);
 
+    invalidateCache();
+
     updateGeometry();
     update();
 }
@@ -420,6 +429,9 @@ double QwtKnob::scrolledTo(const QPoint& pos) const
  */
 void QwtKnob::changeEvent(QEvent* event)
 {
+    // palette, enabled and activation state affect the cached colors
+    invalidateCache();
+
     switch (event->type()) {
     case QEvent::StyleChange:
     case QEvent::FontChange: {
@@ -449,14 +461,24 @@ void QwtKnob::paintEvent(QPaintEvent* event)
 
     painter.setRenderHint(QPainter::Antialiasing, true);
 
-    if (!knobRect.contains(event->region().boundingRect())) {
+    const QSize cacheSize = size() * QwtPainter::devicePixelRatio(this);
+    if (m_data->pixmapCache.size() != cacheSize) {
+        m_data->pixmapCache = QwtPainter::backingStore(this, size());
+        m_data->pixmapCache.fill(Qt::transparent);
+
+        QPainter p(&m_data->pixmapCache);
+        p.setFont(font());
+        p.setRenderHint(QPainter::Antialiasing, true);
+
         scaleDraw()->setRadius(0.5 * knobRect.width() + m_data->scaleDist);
         scaleDraw()->moveCenter(knobRect.center());
 
-        scaleDraw()->draw(&painter, palette());
+        scaleDraw()->draw(&p, palette());
+
+        drawKnob(&p, knobRect);
     }
 
-    drawKnob(&painter, knobRect);
+    painter.drawPixmap(0, 0, m_data->pixmapCache);
 
     drawMarker(&painter, knobRect, qwtNormalizeDegrees(scaleMap().transform(value())));
 
@@ -466,11 +488,40 @@ void QwtKnob::paintEvent(QPaintEvent* event)
         drawFocusIndicator(&painter);
 }
 
+/*!
+   Invalidate the cached static layer ( scale and knob ).
+
+   The cache is invalidated automatically, when the widget is resized
+   or its layout, palette or scale has changed. Applications and derived
+   classes need to call invalidateCache() and update() when they modify
+   anything else, that is painted into the static layer: f.e. state used by a reimplemented drawKnob()
+   or the labels of a custom scale draw.
+ */
+void QwtKnob::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
+//! Notify a change of the scale
+void QwtKnob::scaleChange()
+{
+    invalidateCache();
+    QwtAbstractSlider::scaleChange();
+}
+
 /*!
    \brief Draw the knob
 
+   The knob doesn't depend on the value. When painting the widget it is
+   rendered into the cached static layer together with the scale, so
+   drawKnob() is not called for value changes. Reimplementations,
+   that depend on anything else than the geometry, palette or scale,
+   need to call invalidateCache(), when it changes.
+
    \param painter painter
    \param knobRect Bounding rectangle of the knob (without scale)
+
+   \sa drawMarker(), invalidateCache()
  */
 void QwtKnob::drawKnob(QPainter* painter, const QRectF& knobRect) const
 {
@@ -694,6 +745,7 @@ void QwtKnob::setAlignment(Qt::Alignment alignment)
 {
     if (m_data->alignment != alignment) {
         m_data->alignment = alignment;
+        invalidateCache();
         update();
     }
 }
@@ -732,6 +784,7 @@ void QwtKnob::setKnobWidth(int width)
         setSizePolicy(policy, policy);
 
         m_data->knobWidth = width;
+        invalidateCache();
 
         updateGeometry();
         update();
@@ -751,6 +804,7 @@ int QwtKnob::knobWidth() const
 void QwtKnob::setBorderWidth(int borderWidth)
 {
     m_data->borderWidth = qMax(borderWidth, 0);
+    invalidateCache();
 
     updateGeometry();
     update();
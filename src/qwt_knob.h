@@ -173,9 +173,12 @@ class QWT_EXPORT QwtKnob : public QwtAbstractSlider
 
     QRect knobRect() const;
 
+    void invalidateCache();
+
   protected:
     virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
     virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
+    virtual void scaleChange() QWT_OVERRIDE;
 
     virtual void drawKnob( QPainter*, const QRectF& ) const;
 
@@ -0,0 +1,784 @@
+﻿#include "qwt_lightweight_axes.h"
+// stl
+#include <algorithm>
+// Qt
+#include <QPainter>
+#include <QPalette>
+#include <QBrush>
+#include <QWidget>
+// qwt
+#include "qwt_figure.h"
+#include "qwt_plot_layout.h"
+#include "qwt_plot_layout_engine.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_map.h"
+#include "qwt_scale_div.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+
+class QwtLightweightAxes::PrivateData
+{
+    QWT_DECLARE_PUBLIC(QwtLightweightAxes)
+public:
+    PrivateData(QwtLightweightAxes* p);
+    ~PrivateData();
+
+    struct AxisData
+    {
+        bool isVisible { true };
+        bool doAutoScale { true };
+        double minValue { 0.0 };
+        double maxValue { 1000.0 };
+        double stepSize { 0.0 };
+        int maxMajor { 8 };
+        int maxMinor { 5 };
+        bool isValid { false };
+        QwtScaleDiv scaleDiv;
+        QwtScaleEngine* scaleEngine { nullptr };
+        QwtScaleDraw* scaleDraw { nullptr };
+    };
+
+    // 布局结果，坐标与布局的矩形一致
+    struct Layout
+    {
+        QRectF titleRect;
+        QRectF canvasRect;
+        QPointF scalePos[ QwtAxis::AxisPositions ];
+        double scaleLength[ QwtAxis::AxisPositions ];
+    };
+
+    const QwtPlotLayoutEngine* layoutEngine() const;
+    QFont scaleFont() const;
+    QwtText titleText() const;
+    // 计算rect中标题、画布和刻度的位置
+    Layout calcLayout(const QRectF& rect) const;
+    // geometry的布局，缓存到下次invalidate
+    const Layout& geometryLayout() const;
+    QwtScaleMap canvasMap(int axisPos, const Layout& layout) const;
+
+public:
+    QwtFigure* figure { nullptr };
+    QwtPlotItemList items;
+    QwtText title;
+    QBrush canvasBrush { Qt::white };
+    AxisData axisData[ QwtAxis::AxisPositions ];
+    QRect geometry;
+    QwtPlotLayoutEngine defaultEngine;  ///< 没有figure时使用
+
+    mutable Layout layoutCache;
+    mutable bool isLayoutValid { false };
+};
+
+QwtLightweightAxes::PrivateData::PrivateData(QwtLightweightAxes* p) : q_ptr(p)
+{
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        AxisData& d = axisData[ axisPos ];
+
+        d.scaleEngine = new QwtLinearScaleEngine();
+        d.scaleDraw   = new QwtScaleDraw();
+        d.scaleDraw->setTransformation(d.scaleEngine->transformation());
+    }
+
+    axisData[ QwtAxis::YLeft ].scaleDraw->setAlignment(QwtScaleDraw::LeftScale);
+    axisData[ QwtAxis::YRight ].scaleDraw->setAlignment(QwtScaleDraw::RightScale);
+    axisData[ QwtAxis::XBottom ].scaleDraw->setAlignment(QwtScaleDraw::BottomScale);
+    axisData[ QwtAxis::XTop ].scaleDraw->setAlignment(QwtScaleDraw::TopScale);
+
+    axisData[ QwtAxis::YRight ].isVisible = false;
+    axisData[ QwtAxis::XTop ].isVisible   = false;
+
+    // the same defaults as QwtPlotLayout
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        defaultEngine.setCanvasMargin(axisPos, -1);
+        defaultEngine.setAlignCanvas(axisPos, false);
+    }
+}
+
+QwtLightweightAxes::PrivateData::~PrivateData()
+{
+    qDeleteAll(items);
+
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        delete axisData[ axisPos ].scaleEngine;
+        delete axisData[ axisPos ].scaleDraw;
+    }
+}
+
+const QwtPlotLayoutEngine* QwtLightweightAxes::PrivateData::layoutEngine() const
+{
+    return figure ? figure->lightweightLayoutEngine() : &defaultEngine;
+}
+
+QFont QwtLightweightAxes::PrivateData::scaleFont() const
+{
+    return figure ? figure->font() : QFont();
+}
+
+QwtText QwtLightweightAxes::PrivateData::titleText() const
+{
+    QwtText text = title;
+    if (!text.isEmpty() && !text.testPaintAttribute(QwtText::PaintUsingTextFont)) {
+        QFont font = scaleFont();
+        font.setBold(true);
+        text.setFont(font);
+    }
+    return text;
+}
+
+/**
+ * @brief 与QwtPlotLayout::activate相同的布局，但刻度数据来自QwtScaleDraw，没有图例和脚注
+ */
+QwtLightweightAxes::PrivateData::Layout QwtLightweightAxes::PrivateData::calcLayout(const QRectF& plotRect) const
+{
+    using namespace QwtAxis;
+
+    const QwtPlotLayoutEngine* engine = layoutEngine();
+    const int options = QwtPlotLayout::IgnoreLegend | QwtPlotLayout::IgnoreFooter | QwtPlotLayout::IgnoreFrames;
+
+    QwtPlotLayoutEngine::LayoutData layoutData;
+    layoutData.labelData[ QwtPlotLayoutEngine::LayoutData::Title ].text = titleText();
+
+    const QFont font = scaleFont();
+    for (int axisPos = 0; axisPos < AxisPositions; axisPos++) {
+        if (axisData[ axisPos ].isVisible) {
+            layoutData.axisData(axisPos).init(axisData[ axisPos ].scaleDraw, font, 0);
+        }
+    }
+
+    Layout layout;
+    QRectF rect(plotRect);
+
+    const QwtPlotLayoutEngine::Dimensions dimensions = engine->layoutDimensions(options, layoutData, rect);
+
+    if (dimensions.dimTitle > 0) {
+        layout.titleRect.setRect(rect.left(), rect.top(), rect.width(), dimensions.dimTitle);
+        rect.setTop(layout.titleRect.bottom() + engine->spacing());
+
+        if (!layoutData.hasSymmetricYAxes()) {
+            layout.titleRect = dimensions.centered(rect, layout.titleRect);
+        }
+    }
+
+    layout.canvasRect = dimensions.innerRect(rect);
+
+    QRectF scaleRect[ AxisPositions ];
+    for (int axisPos = 0; axisPos < AxisPositions; axisPos++) {
+        const int dim = dimensions.dimAxis(axisPos);
+        if (dim <= 0) {
+            continue;
+        }
+
+        const QRectF& canvasRect = layout.canvasRect;
+        QRectF& r                = scaleRect[ axisPos ];
+        r                        = canvasRect;
+
+        switch (axisPos) {
+        case YLeft:
+            r.setX(canvasRect.left() - dim);
+            r.setWidth(dim);
+            break;
+        case YRight:
+            r.setX(canvasRect.right());
+            r.setWidth(dim);
+            break;
+        case XBottom:
+            r.setY(canvasRect.bottom());
+            r.setHeight(dim);
+            break;
+        case XTop:
+            r.setY(canvasRect.top() - dim);
+            r.setHeight(dim);
+            break;
+        }
+        r = r.normalized();
+    }
+
+    engine->alignScales(options, layoutData, layout.canvasRect, scaleRect);
+
+    // the backbones, like QwtScaleWidget::layoutScale() with a margin of 0
+    for (int axisPos = 0; axisPos < AxisPositions; axisPos++) {
+        layout.scalePos[ axisPos ]    = QPointF();
+        layout.scaleLength[ axisPos ] = 0.0;
+
+        const QRectF& r = scaleRect[ axisPos ];
+        if (!r.isValid()) {
+            continue;
+        }
+
+        const QwtPlotLayoutEngine::LayoutData::ScaleData& scaleData = layoutData.axisData(axisPos);
+        if (isYAxis(axisPos)) {
+            const double x = (axisPos == YLeft) ? r.right() - 1.0 : r.left();
+            layout.scalePos[ axisPos ]    = QPointF(x, r.top() + scaleData.start);
+            layout.scaleLength[ axisPos ] = r.height() - (scaleData.start + scaleData.end);
+        } else {
+            const double y = (axisPos == XBottom) ? r.top() : r.bottom() - 1.0;
+            layout.scalePos[ axisPos ]    = QPointF(r.left() + scaleData.start, y);
+            layout.scaleLength[ axisPos ] = r.width() - (scaleData.start + scaleData.end);
+        }
+    }
+
+    return layout;
+}
+
+const QwtLightweightAxes::PrivateData::Layout& QwtLightweightAxes::PrivateData::geometryLayout() const
+{
+    if (!isLayoutValid) {
+        layoutCache   = calcLayout(QRectF(geometry));
+        isLayoutValid = true;
+    }
+    return layoutCache;
+}
+
+QwtScaleMap QwtLightweightAxes::PrivateData::canvasMap(int axisPos, const Layout& layout) const
+{
+    const AxisData& d = axisData[ axisPos ];
+
+    QwtScaleMap map;
+    map.setTransformation(d.scaleEngine->transformation());
+    map.setScaleInterval(d.scaleDiv.lowerBound(), d.scaleDiv.upperBound());
+
+    const bool hasScale = d.isVisible && layout.scaleLength[ axisPos ] > 0.0;
+    if (QwtAxis::isYAxis(axisPos)) {
+        if (hasScale) {
+            const double y = layout.scalePos[ axisPos ].y();
+            map.setPaintInterval(y + layout.scaleLength[ axisPos ], y);
+        } else {
+            map.setPaintInterval(layout.canvasRect.bottom(), layout.canvasRect.top());
+        }
+    } else {
+        if (hasScale) {
+            const double x = layout.scalePos[ axisPos ].x();
+            map.setPaintInterval(x, x + layout.scaleLength[ axisPos ]);
+        } else {
+            map.setPaintInterval(layout.canvasRect.left(), layout.canvasRect.right());
+        }
+    }
+
+    return map;
+}
+
+//----------------------------------------------------
+// QwtLightweightAxes
+//----------------------------------------------------
+
+/**
+ * @brief Constructor
+ * @param figure Figure, that lays out and paints the axes / 负责布局和绘制的figure
+ * @note Usually created by QwtFigure::addLightweightAxes() / 通常由QwtFigure::addLightweightAxes()创建
+ */
+QwtLightweightAxes::QwtLightweightAxes(QwtFigure* figure) : QLayoutItem(), QWT_PIMPL_CONSTRUCT
+{
+    m_data->figure = figure;
+    updateAxes();
+}
+
+/**
+ * @brief Destructor, deletes all items / 析构，删除所有的item
+ */
+QwtLightweightAxes::~QwtLightweightAxes()
+{
+}
+
+/**
+ * @brief The figure of the axes / 所在的figure
+ */
+QwtFigure* QwtLightweightAxes::figure() const
+{
+    return m_data->figure;
+}
+
+/**
+ * @brief Add an item / 添加item
+ *
+ * The axes takes the ownership of the item. The items are painted in increasing z order.
+ *
+ * 坐标系获得item的所有权，item按z值从小到大绘制
+ *
+ * @param item Item, that is not attached to a QwtPlot / 没有依附于QwtPlot的item
+ */
+void QwtLightweightAxes::attachItem(QwtPlotItem* item)
+{
+    if (!item || m_data->items.contains(item)) {
+        return;
+    }
+    m_data->items.append(item);
+}
+
+/**
+ * @brief Remove an item without deleting it / 移除item，不删除它
+ */
+void QwtLightweightAxes::detachItem(QwtPlotItem* item)
+{
+    m_data->items.removeAll(item);
+}
+
+/**
+ * @brief Remove all items of a type / 移除指定类型的item
+ * @param rtti Runtime type information, QwtPlotItem::Rtti_PlotItem for all items / 类型，QwtPlotItem::Rtti_PlotItem表示所有item
+ * @param autoDelete Delete the items / 是否删除item
+ */
+void QwtLightweightAxes::detachItems(int rtti, bool autoDelete)
+{
+    const QwtPlotItemList items = m_data->items;
+    for (QwtPlotItem* item : items) {
+        if (rtti == QwtPlotItem::Rtti_PlotItem || item->rtti() == rtti) {
+            m_data->items.removeAll(item);
+            if (autoDelete) {
+                delete item;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Items of the axes / 坐标系的item
+ */
+const QwtPlotItemList& QwtLightweightAxes::itemList() const
+{
+    return m_data->items;
+}
+
+/**
+ * @brief Set the title / 设置标题
+ */
+void QwtLightweightAxes::setTitle(const QString& title)
+{
+    setTitle(QwtText(title));
+}
+
+/**
+ * @brief Set the title / 设置标题
+ * @note Without QwtText::PaintUsingTextFont the bold font of the figure is used / 没有设置字体时使用figure的粗体字体
+ */
+void QwtLightweightAxes::setTitle(const QwtText& title)
+{
+    m_data->title         = title;
+    m_data->isLayoutValid = false;
+}
+
+QwtText QwtLightweightAxes::title() const
+{
+    return m_data->title;
+}
+
+/**
+ * @brief Set the background of the canvas / 设置画布背景
+ */
+void QwtLightweightAxes::setCanvasBackground(const QBrush& brush)
+{
+    m_data->canvasBrush = brush;
+}
+
+QBrush QwtLightweightAxes::canvasBackground() const
+{
+    return m_data->canvasBrush;
+}
+
+/**
+ * @brief Show/Hide an axis / 显示/隐藏坐标轴
+ * @note By default QwtAxis::YLeft and QwtAxis::XBottom are visible / 默认显示左轴和下轴
+ */
+void QwtLightweightAxes::setAxisVisible(QwtAxisId axisId, bool on)
+{
+    if (QwtAxis::isValid(axisId) && on != m_data->axisData[ axisId ].isVisible) {
+        m_data->axisData[ axisId ].isVisible = on;
+        m_data->isLayoutValid                = false;
+    }
+}
+
+bool QwtLightweightAxes::isAxisVisible(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) && m_data->axisData[ axisId ].isVisible;
+}
+
+/**
+ * @brief Disable autoscaling and set a fixed scale / 关闭自动缩放并设置固定刻度
+ * @sa QwtPlot::setAxisScale()
+ */
+void QwtLightweightAxes::setAxisScale(QwtAxisId axisId, double min, double max, double stepSize)
+{
+    if (!QwtAxis::isValid(axisId)) {
+        return;
+    }
+
+    PrivateData::AxisData& d = m_data->axisData[ axisId ];
+
+    d.doAutoScale = false;
+    d.isValid     = false;
+
+    d.minValue = min;
+    d.maxValue = max;
+    d.stepSize = stepSize;
+}
+
+/**
+ * @brief Disable autoscaling and set a fixed scale division / 关闭自动缩放并设置固定刻度划分
+ */
+void QwtLightweightAxes::setAxisScaleDiv(QwtAxisId axisId, const QwtScaleDiv& scaleDiv)
+{
+    if (!QwtAxis::isValid(axisId)) {
+        return;
+    }
+
+    PrivateData::AxisData& d = m_data->axisData[ axisId ];
+
+    d.doAutoScale = false;
+    d.scaleDiv    = scaleDiv;
+    d.isValid     = true;
+}
+
+/**
+ * @brief Scale division of an axis, as calculated by the last updateAxes() / 最后一次updateAxes()计算的刻度划分
+ */
+const QwtScaleDiv& QwtLightweightAxes::axisScaleDiv(QwtAxisId axisId) const
+{
+    return m_data->axisData[ QwtAxis::isValid(axisId) ? axisId : QwtAxis::XBottom ].scaleDiv;
+}
+
+/**
+ * @brief Enable/Disable autoscaling / 开启/关闭自动缩放
+ * @note Takes effect with the next updateAxes() or replot() / 在下次updateAxes()或replot()时生效
+ */
+void QwtLightweightAxes::setAxisAutoScale(QwtAxisId axisId, bool on)
+{
+    if (QwtAxis::isValid(axisId)) {
+        m_data->axisData[ axisId ].doAutoScale = on;
+    }
+}
+
+bool QwtLightweightAxes::axisAutoScale(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) && m_data->axisData[ axisId ].doAutoScale;
+}
+
+/**
+ * @brief Maximum number of major scale intervals / 主刻度的最大数量
+ */
+void QwtLightweightAxes::setAxisMaxMajor(QwtAxisId axisId, int maxMajor)
+{
+    if (QwtAxis::isValid(axisId)) {
+        PrivateData::AxisData& d = m_data->axisData[ axisId ];
+
+        maxMajor = qBound(1, maxMajor, 10000);
+        if (maxMajor != d.maxMajor) {
+            d.maxMajor = maxMajor;
+            d.isValid  = false;
+        }
+    }
+}
+
+int QwtLightweightAxes::axisMaxMajor(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].maxMajor : 0;
+}
+
+/**
+ * @brief Maximum number of minor scale intervals / 次刻度的最大数量
+ */
+void QwtLightweightAxes::setAxisMaxMinor(QwtAxisId axisId, int maxMinor)
+{
+    if (QwtAxis::isValid(axisId)) {
+        PrivateData::AxisData& d = m_data->axisData[ axisId ];
+
+        maxMinor = qBound(0, maxMinor, 100);
+        if (maxMinor != d.maxMinor) {
+            d.maxMinor = maxMinor;
+            d.isValid  = false;
+        }
+    }
+}
+
+int QwtLightweightAxes::axisMaxMinor(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].maxMinor : 0;
+}
+
+/**
+ * @brief Change the scale engine of an axis / 设置坐标轴的刻度引擎
+ * @param axisId Axis / 坐标轴
+ * @param scaleEngine Scale engine, the axis takes the ownership / 刻度引擎，坐标轴获得所有权
+ */
+void QwtLightweightAxes::setAxisScaleEngine(QwtAxisId axisId, QwtScaleEngine* scaleEngine)
+{
+    if (!QwtAxis::isValid(axisId) || !scaleEngine) {
+        return;
+    }
+
+    PrivateData::AxisData& d = m_data->axisData[ axisId ];
+    if (scaleEngine == d.scaleEngine) {
+        return;
+    }
+
+    delete d.scaleEngine;
+    d.scaleEngine = scaleEngine;
+    d.scaleDraw->setTransformation(scaleEngine->transformation());
+    d.isValid = false;
+}
+
+QwtScaleEngine* QwtLightweightAxes::axisScaleEngine(QwtAxisId axisId)
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].scaleEngine : nullptr;
+}
+
+const QwtScaleEngine* QwtLightweightAxes::axisScaleEngine(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].scaleEngine : nullptr;
+}
+
+/**
+ * @brief Change the scale draw of an axis / 设置坐标轴的刻度绘制对象
+ * @param axisId Axis / 坐标轴
+ * @param scaleDraw Scale draw, the axis takes the ownership / 刻度绘制对象，坐标轴获得所有权
+ */
+void QwtLightweightAxes::setAxisScaleDraw(QwtAxisId axisId, QwtScaleDraw* scaleDraw)
+{
+    if (!QwtAxis::isValid(axisId) || !scaleDraw) {
+        return;
+    }
+
+    PrivateData::AxisData& d = m_data->axisData[ axisId ];
+    if (scaleDraw == d.scaleDraw) {
+        return;
+    }
+
+    scaleDraw->setAlignment(d.scaleDraw->alignment());
+    scaleDraw->setScaleDiv(d.scaleDiv);
+    scaleDraw->setTransformation(d.scaleEngine->transformation());
+
+    delete d.scaleDraw;
+    d.scaleDraw = scaleDraw;
+
+    m_data->isLayoutValid = false;
+}
+
+QwtScaleDraw* QwtLightweightAxes::axisScaleDraw(QwtAxisId axisId)
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].scaleDraw : nullptr;
+}
+
+const QwtScaleDraw* QwtLightweightAxes::axisScaleDraw(QwtAxisId axisId) const
+{
+    return QwtAxis::isValid(axisId) ? m_data->axisData[ axisId ].scaleDraw : nullptr;
+}
+
+/**
+ * @brief Map between the scale and the figure coordinates / 刻度与figure坐标之间的映射
+ */
+QwtScaleMap QwtLightweightAxes::canvasMap(QwtAxisId axisId) const
+{
+    if (!QwtAxis::isValid(axisId)) {
+        return QwtScaleMap();
+    }
+    return m_data->canvasMap(axisId, m_data->geometryLayout());
+}
+
+/**
+ * @brief Rectangle of the canvas in figure coordinates / 画布在figure中的矩形
+ */
+QRectF QwtLightweightAxes::canvasRect() const
+{
+    return m_data->geometryLayout().canvasRect;
+}
+
+/**
+ * @brief Recalculate the scale divisions / 重新计算刻度划分
+ *
+ * The same as QwtPlot::updateAxes(): the axes with autoscaling enabled are adjusted
+ * to the bounding rectangles of the items.
+ *
+ * 与QwtPlot::updateAxes()相同，开启自动缩放的坐标轴按item的范围调整
+ */
+void QwtLightweightAxes::updateAxes()
+{
+    QwtInterval boundingIntervals[ QwtAxis::AxisPositions ];
+
+    for (const QwtPlotItem* item : qAsConst(m_data->items)) {
+        if (!item->testItemAttribute(QwtPlotItem::AutoScale) || !item->isVisible()) {
+            continue;
+        }
+        if (!axisAutoScale(item->xAxis()) && !axisAutoScale(item->yAxis())) {
+            continue;
+        }
+
+        const QRectF rect = item->boundingRect();
+
+        if (rect.width() >= 0.0) {
+            boundingIntervals[ item->xAxis() ] |= QwtInterval(rect.left(), rect.right());
+        }
+        if (rect.height() >= 0.0) {
+            boundingIntervals[ item->yAxis() ] |= QwtInterval(rect.top(), rect.bottom());
+        }
+    }
+
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        PrivateData::AxisData& d = m_data->axisData[ axisPos ];
+
+        double minValue = d.minValue;
+        double maxValue = d.maxValue;
+        double stepSize = d.stepSize;
+
+        const QwtInterval& interval = boundingIntervals[ axisPos ];
+        if (d.doAutoScale && interval.isValid()) {
+            d.isValid = false;
+
+            minValue = interval.minValue();
+            maxValue = interval.maxValue();
+
+            d.scaleEngine->autoScale(d.maxMajor, minValue, maxValue, stepSize);
+        }
+        if (!d.isValid) {
+            d.scaleDiv = d.scaleEngine->divideScale(minValue, maxValue, d.maxMajor, d.maxMinor, stepSize);
+            d.isValid  = true;
+        }
+
+        if (d.scaleDraw->scaleDiv() != d.scaleDiv) {
+            d.scaleDraw->setScaleDiv(d.scaleDiv);
+
+            // the tick labels decide about the layout
+            m_data->isLayoutValid = false;
+        }
+    }
+
+    for (QwtPlotItem* item : qAsConst(m_data->items)) {
+        if (item->testItemInterest(QwtPlotItem::ScaleInterest)) {
+            item->updateScaleDiv(axisScaleDiv(item->xAxis()), axisScaleDiv(item->yAxis()));
+        }
+    }
+}
+
+/**
+ * @brief Update the scales and repaint the axes / 更新刻度并重绘坐标系
+ *
+ * Only the area of this axes in the backing store of the figure is rendered again.
+ *
+ * 只重绘figure缓存中本坐标系所在的区域
+ */
+void QwtLightweightAxes::replot()
+{
+    updateAxes();
+    if (m_data->figure) {
+        m_data->figure->updateLightweightAxes(this);
+    }
+}
+
+/**
+ * @brief Draw the axes into a rectangle / 把坐标系绘制到矩形中
+ *
+ * Canvas background, items, scales and title are painted with the fonts and the palette of the figure.
+ *
+ * 使用figure的字体和调色板绘制画布背景、item、坐标轴和标题
+ *
+ * @param painter Painter / 画笔
+ * @param rect Bounding rectangle / 绘制的矩形
+ */
+void QwtLightweightAxes::draw(QPainter* painter, const QRectF& rect) const
+{
+    if (!painter || rect.isEmpty()) {
+        return;
+    }
+
+    const PrivateData::Layout layout =
+        (rect == QRectF(m_data->geometry)) ? m_data->geometryLayout() : m_data->calcLayout(rect);
+
+    painter->save();
+
+    painter->fillRect(layout.canvasRect, m_data->canvasBrush);
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        maps[ axisPos ] = m_data->canvasMap(axisPos, layout);
+    }
+
+    // the z order of the items might have been changed after attaching them
+    QwtPlotItemList items = m_data->items;
+    std::stable_sort(items.begin(), items.end(), [](const QwtPlotItem* item1, const QwtPlotItem* item2) {
+        return item1->z() < item2->z();
+    });
+
+    painter->save();
+    painter->setClipRect(layout.canvasRect, Qt::IntersectClip);
+
+    for (QwtPlotItem* item : qAsConst(items)) {
+        if (!item->isVisible()) {
+            continue;
+        }
+
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(painter, maps[ item->xAxis() ], maps[ item->yAxis() ], layout.canvasRect);
+        painter->restore();
+    }
+
+    painter->restore();
+
+    const QPalette palette = m_data->figure ? m_data->figure->palette() : QPalette();
+
+    painter->setFont(m_data->scaleFont());
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        const PrivateData::AxisData& d = m_data->axisData[ axisPos ];
+        if (!d.isVisible || layout.scaleLength[ axisPos ] <= 0.0) {
+            continue;
+        }
+
+        d.scaleDraw->move(layout.scalePos[ axisPos ]);
+        d.scaleDraw->setLength(layout.scaleLength[ axisPos ]);
+        d.scaleDraw->draw(painter, palette);
+    }
+
+    if (!layout.titleRect.isEmpty()) {
+        painter->setPen(palette.color(QPalette::Text));
+        m_data->titleText().draw(painter, layout.titleRect);
+    }
+
+    painter->restore();
+}
+
+QSize QwtLightweightAxes::sizeHint() const
+{
+    return QSize(200, 150);
+}
+
+QSize QwtLightweightAxes::minimumSize() const
+{
+    return QSize(0, 0);
+}
+
+QSize QwtLightweightAxes::maximumSize() const
+{
+    return QSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+}
+
+Qt::Orientations QwtLightweightAxes::expandingDirections() const
+{
+    return Qt::Horizontal | Qt::Vertical;
+}
+
+/**
+ * @brief Set the geometry in figure coordinates, called by QwtFigureLayout / 设置在figure中的位置，由QwtFigureLayout调用
+ */
+void QwtLightweightAxes::setGeometry(const QRect& rect)
+{
+    if (rect != m_data->geometry) {
+        m_data->geometry      = rect;
+        m_data->isLayoutValid = false;
+    }
+}
+
+QRect QwtLightweightAxes::geometry() const
+{
+    return m_data->geometry;
+}
+
+bool QwtLightweightAxes::isEmpty() const
+{
+    return false;
+}
+
+/**
+ * @brief Drop the cached layout, f.e. after the font of the figure has changed / 清除缓存的布局，例如figure字体改变后
+ */
+void QwtLightweightAxes::invalidate()
+{
+    m_data->isLayoutValid = false;
+}
@@ -0,0 +1,137 @@
+﻿#ifndef QWT_LIGHTWEIGHT_AXES_H
+#define QWT_LIGHTWEIGHT_AXES_H
+// stl
+#include <memory>
+
+// Qt
+#include <QLayoutItem>
+// qwt
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+#include "qwt_plot_dict.h"
+class QPainter;
+class QBrush;
+class QwtFigure;
+class QwtText;
+class QwtScaleDiv;
+class QwtScaleMap;
+class QwtScaleDraw;
+class QwtScaleEngine;
+
+/**
+ * @brief Axes of a QwtFigure without widgets of their own
+ * @brief 没有独立窗口的QwtFigure坐标系
+ *
+ * A lightweight axes holds plot items, a title and four scales ( scale division, scale map and
+ * QwtScaleDraw ), but no QWidget at all: no canvas, no scale widgets and no labels. It is a layout item
+ * of QwtFigureLayout and is laid out like the other axes of the figure. All lightweight axes of a figure
+ * are painted by the figure itself into one shared backing store, and a replot() renders the area of
+ * this axes only. Their layout is calculated by one QwtPlotLayoutEngine, that is owned by the figure.
+ *
+ * 轻量坐标系包含绘图item、标题和四个坐标轴（刻度划分、刻度映射和QwtScaleDraw），但没有任何QWidget：
+ * 没有画布、刻度窗口和标签。它是QwtFigureLayout的布局项，和figure中的其它坐标系一样布局。
+ * figure中所有的轻量坐标系由figure自己绘制到一个共享缓存中，replot()只重绘本坐标系所在的区域。
+ * 布局由figure持有的同一个QwtPlotLayoutEngine计算。
+ *
+ * This makes grids of hundreds of small multiples cheap to create, to lay out and to keep in memory.
+ * As there is no canvas, pickers, zoomers, panners and legends are not available. Interactions can be
+ * implemented in the figure with QwtFigure::lightweightAxesUnderPos() and canvasMap().
+ *
+ * 因此创建、布局包含数百个小子图的网格开销很低。由于没有画布，picker、zoomer、panner和图例都不可用，
+ * 交互可以在figure中通过QwtFigure::lightweightAxesUnderPos()和canvasMap()实现。
+ *
+ * @code
+ * for (int row = 0; row < 10; ++row) {
+ *     for (int col = 0; col < 10; ++col) {
+ *         QwtLightweightAxes* axes = figure->addGridLightweightAxes(10, 10, row, col, 1, 1, 0.02, 0.02);
+ *
+ *         QwtPlotCurve* curve = new QwtPlotCurve();
+ *         curve->setSamples(samples[ row * 10 + col ]);
+ *         axes->attachItem(curve);
+ *         axes->replot();
+ *     }
+ * }
+ * @endcode
+ *
+ * @note The items are not attached to a QwtPlot, so QwtPlotItem::plot() returns nullptr and
+ *       changes of an item need an explicit replot().
+ *       item不依附于QwtPlot，QwtPlotItem::plot()返回nullptr，修改item后需要显式调用replot()
+ * @note The axes is owned by the layout of the figure. Use QwtFigure::removeLightweightAxes() instead of deleting it.
+ *       坐标系由figure的布局持有，应通过QwtFigure::removeLightweightAxes()删除，而不是直接delete
+ *
+ * @sa QwtFigure::addLightweightAxes(), QwtFigure::addGridLightweightAxes()
+ */
+class QWT_EXPORT QwtLightweightAxes : public QLayoutItem
+{
+    QWT_DECLARE_PRIVATE(QwtLightweightAxes)
+public:
+    explicit QwtLightweightAxes(QwtFigure* figure);
+    ~QwtLightweightAxes() override;
+
+    QwtFigure* figure() const;
+
+    // 添加item，坐标系获得item的所有权
+    void attachItem(QwtPlotItem* item);
+    // 移除item，不删除它
+    void detachItem(QwtPlotItem* item);
+    // 移除指定类型的item
+    void detachItems(int rtti = QwtPlotItem::Rtti_PlotItem, bool autoDelete = true);
+    const QwtPlotItemList& itemList() const;
+
+    // 标题
+    void setTitle(const QString& title);
+    void setTitle(const QwtText& title);
+    QwtText title() const;
+
+    // 画布背景
+    void setCanvasBackground(const QBrush& brush);
+    QBrush canvasBackground() const;
+
+    // 坐标轴
+    void setAxisVisible(QwtAxisId axisId, bool on = true);
+    bool isAxisVisible(QwtAxisId axisId) const;
+
+    void setAxisScale(QwtAxisId axisId, double min, double max, double stepSize = 0);
+    void setAxisScaleDiv(QwtAxisId axisId, const QwtScaleDiv& scaleDiv);
+    const QwtScaleDiv& axisScaleDiv(QwtAxisId axisId) const;
+
+    void setAxisAutoScale(QwtAxisId axisId, bool on = true);
+    bool axisAutoScale(QwtAxisId axisId) const;
+
+    void setAxisMaxMajor(QwtAxisId axisId, int maxMajor);
+    int axisMaxMajor(QwtAxisId axisId) const;
+    void setAxisMaxMinor(QwtAxisId axisId, int maxMinor);
+    int axisMaxMinor(QwtAxisId axisId) const;
+
+    void setAxisScaleEngine(QwtAxisId axisId, QwtScaleEngine* scaleEngine);
+    QwtScaleEngine* axisScaleEngine(QwtAxisId axisId);
+    const QwtScaleEngine* axisScaleEngine(QwtAxisId axisId) const;
+
+    void setAxisScaleDraw(QwtAxisId axisId, QwtScaleDraw* scaleDraw);
+    QwtScaleDraw* axisScaleDraw(QwtAxisId axisId);
+    const QwtScaleDraw* axisScaleDraw(QwtAxisId axisId) const;
+
+    // 画布坐标映射，坐标为figure坐标
+    QwtScaleMap canvasMap(QwtAxisId axisId) const;
+    QRectF canvasRect() const;
+
+    // 重新计算自动缩放的刻度
+    void updateAxes();
+    // 更新刻度并重绘本坐标系所在的区域
+    void replot();
+
+    // 把坐标系绘制到rect中
+    void draw(QPainter* painter, const QRectF& rect) const;
+
+    // QLayoutItem
+    QSize sizeHint() const override;
+    QSize minimumSize() const override;
+    QSize maximumSize() const override;
+    Qt::Orientations expandingDirections() const override;
+    void setGeometry(const QRect& rect) override;
+    QRect geometry() const override;
+    bool isEmpty() const override;
+    void invalidate() override;
+};
+
+#endif  // QWT_LIGHTWEIGHT_AXES_H
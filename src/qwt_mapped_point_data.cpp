@@ -0,0 +1,675 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_point_data.h"
+#include "qwt_interval.h"
+
+#include <qfile.h>
+#include <qstring.h>
+#include <qvector.h>
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+// Layout of a summary file: a header followed by one block for
+// each blockSize samples. Everything is in native byte order.
+struct QwtMappedSummaryHeader
+{
+    char magic[ 8 ];
+    quint64 sampleCount;
+    quint64 blockSize;
+    quint64 reserved;
+};
+
+struct QwtMappedSummaryBlock
+{
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+}
+
+static const char qwtMappedSummaryMagic[ 8 ] = { 'Q', 'W', 'T', 'S', 'U', 'M', 'M', '1' };
+
+template< typename T >
+static double qwtMappedRead(const uchar* ptr)
+{
+    // the file offset might be unaligned
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+
+    return static_cast< double >(value);
+}
+
+class QwtMappedPointData::PrivateData
+{
+public:
+    PrivateData()
+        : dataType(QwtMappedPointData::Float64)
+        , layout(QwtMappedPointData::Interleaved)
+        , offset(0)
+        , valueSize(sizeof(double))
+        , read(qwtMappedRead< double >)
+        , memory(NULL)
+        , count(0)
+        , x0(0.0)
+        , dx(1.0)
+        , maxSamples(8192)
+        , summary(NULL)
+        , summaryBlockSize(0)
+        , viewFirst(0)
+        , viewCount(0)
+        , decimated(false)
+    {
+    }
+
+    inline double xValue(size_t index) const
+    {
+        switch (layout) {
+        case QwtMappedPointData::Interleaved:
+            return read(memory + 2 * index * valueSize);
+
+        case QwtMappedPointData::Columns:
+            return read(memory + index * valueSize);
+
+        default:
+            return x0 + index * dx;
+        }
+    }
+
+    inline double yValue(size_t index) const
+    {
+        switch (layout) {
+        case QwtMappedPointData::Interleaved:
+            return read(memory + (2 * index + 1) * valueSize);
+
+        case QwtMappedPointData::Columns:
+            return read(memory + (count + index) * valueSize);
+
+        default:
+            return read(memory + index * valueSize);
+        }
+    }
+
+    inline const QwtMappedSummaryBlock* summaryBlocks() const
+    {
+        return reinterpret_cast< const QwtMappedSummaryBlock* >(summary + sizeof(QwtMappedSummaryHeader));
+    }
+
+    size_t lowerBound(double x) const;
+    void scanMinMax(size_t from, size_t to, double& minY, double& maxY) const;
+    void rangeMinMax(size_t from, size_t to, double& minY, double& maxY) const;
+    void closeSummary();
+    void updateView();
+
+    QFile file;
+    QwtMappedPointData::DataType dataType;
+    QwtMappedPointData::Layout layout;
+    qint64 offset;
+
+    size_t valueSize;
+    double (*read)(const uchar*);
+
+    const uchar* memory;
+    size_t count;
+
+    double x0;
+    double dx;
+
+    size_t maxSamples;
+
+    QFile summaryFile;
+    const uchar* summary;
+    size_t summaryBlockSize;
+
+    QRectF rectOfInterest;
+
+    // the samples offered by size()/sample()
+    size_t viewFirst;
+    size_t viewCount;
+    bool decimated;
+    QVector< QPointF > view;
+};
+
+// index of the first sample with x >= value, the x coordinates are increasing
+size_t QwtMappedPointData::PrivateData::lowerBound(double x) const
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (xValue(mid) < x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// NaN values fail all comparisons and are ignored
+void QwtMappedPointData::PrivateData::scanMinMax(size_t from, size_t to, double& minY, double& maxY) const
+{
+    for (size_t i = from; i < to; i++) {
+        const double y = yValue(i);
+        if (y < minY)
+            minY = y;
+        if (y > maxY)
+            maxY = y;
+    }
+}
+
+void QwtMappedPointData::PrivateData::rangeMinMax(size_t from, size_t to, double& minY, double& maxY) const
+{
+    const size_t bs = summaryBlockSize;
+    if (summary == NULL || to - from < 2 * bs) {
+        scanMinMax(from, to, minY, maxY);
+        return;
+    }
+
+    // the complete blocks are taken from the summary,
+    // only the samples at the borders are read from the data file
+
+    const size_t b0 = (from + bs - 1) / bs;
+    const size_t b1 = to / bs;
+
+    scanMinMax(from, b0 * bs, minY, maxY);
+
+    const QwtMappedSummaryBlock* blocks = summaryBlocks();
+    for (size_t b = b0; b < b1; b++) {
+        if (blocks[ b ].minY < minY)
+            minY = blocks[ b ].minY;
+        if (blocks[ b ].maxY > maxY)
+            maxY = blocks[ b ].maxY;
+    }
+
+    scanMinMax(b1 * bs, to, minY, maxY);
+}
+
+void QwtMappedPointData::PrivateData::closeSummary()
+{
+    if (summary) {
+        summaryFile.unmap(const_cast< uchar* >(summary));
+        summary = NULL;
+    }
+
+    summaryFile.close();
+    summaryBlockSize = 0;
+}
+
+void QwtMappedPointData::PrivateData::updateView()
+{
+    view.clear();
+    decimated = false;
+
+    size_t first = 0;
+    size_t last  = count;
+
+    const QwtInterval interval = QwtInterval(rectOfInterest.left(), rectOfInterest.right()).normalized();
+    if (count > 0 && interval.isValid() && interval.width() > 0.0) {
+        // one sample outside on each side, so that the curve
+        // reaches the borders of the canvas
+
+        first = lowerBound(interval.minValue());
+        if (first > 0)
+            first--;
+
+        last = qMin(lowerBound(interval.maxValue()) + 1, count);
+        if (last < first)
+            last = first;
+    }
+
+    viewFirst = first;
+    viewCount = last - first;
+
+    if (viewCount <= maxSamples)
+        return;
+
+    // minimum and maximum of each bucket at the position of its first sample
+
+    decimated = true;
+
+    const size_t numBuckets = qMax(maxSamples / 2, size_t(1));
+    view.reserve(int(2 * numBuckets + 1));
+
+    for (size_t b = 0; b < numBuckets; b++) {
+        const size_t from = first + viewCount * b / numBuckets;
+        const size_t to   = first + viewCount * (b + 1) / numBuckets;
+
+        if (from >= to)
+            continue;
+
+        double minY = std::numeric_limits< double >::max();
+        double maxY = -std::numeric_limits< double >::max();
+
+        rangeMinMax(from, to, minY, maxY);
+
+        if (minY <= maxY) {
+            const double x = xValue(from);
+
+            view += QPointF(x, minY);
+            if (maxY > minY)
+                view += QPointF(x, maxY);
+        }
+    }
+
+    view += QPointF(xValue(last - 1), yValue(last - 1));
+}
+
+/*!
+   \brief Constructor
+
+   Opens and maps the file. The number of samples is calculated from the
+   size of the file, trailing bytes of an incomplete sample are ignored.
+
+   \param fileName Binary file with the samples
+   \param dataType Type of the values
+   \param layout Organization of the values
+   \param offset Number of bytes to skip at the beginning of the file
+
+   \sa isValid()
+ */
+QwtMappedPointData::QwtMappedPointData(const QString& fileName, DataType dataType, Layout layout, qint64 offset)
+{
+    m_data = new PrivateData;
+
+    m_data->dataType = dataType;
+    m_data->layout   = layout;
+    m_data->offset   = qMax(offset, qint64(0));
+
+    switch (dataType) {
+    case Int8:
+        m_data->valueSize = 1;
+        m_data->read      = qwtMappedRead< qint8 >;
+        break;
+    case UInt8:
+        m_data->valueSize = 1;
+        m_data->read      = qwtMappedRead< quint8 >;
+        break;
+    case Int16:
+        m_data->valueSize = 2;
+        m_data->read      = qwtMappedRead< qint16 >;
+        break;
+    case UInt16:
+        m_data->valueSize = 2;
+        m_data->read      = qwtMappedRead< quint16 >;
+        break;
+    case Int32:
+        m_data->valueSize = 4;
+        m_data->read      = qwtMappedRead< qint32 >;
+        break;
+    case UInt32:
+        m_data->valueSize = 4;
+        m_data->read      = qwtMappedRead< quint32 >;
+        break;
+    case Int64:
+        m_data->valueSize = 8;
+        m_data->read      = qwtMappedRead< qint64 >;
+        break;
+    case UInt64:
+        m_data->valueSize = 8;
+        m_data->read      = qwtMappedRead< quint64 >;
+        break;
+    case Float32:
+        m_data->valueSize = 4;
+        m_data->read      = qwtMappedRead< float >;
+        break;
+    case Float64:
+    default:
+        m_data->valueSize = 8;
+        m_data->read      = qwtMappedRead< double >;
+        break;
+    }
+
+    m_data->file.setFileName(fileName);
+    if (!m_data->file.open(QIODevice::ReadOnly))
+        return;
+
+    const qint64 numBytes = m_data->file.size() - m_data->offset;
+    if (numBytes <= 0)
+        return;
+
+    const size_t valuesPerSample = (layout == ValuesOnly) ? 1 : 2;
+    const size_t count           = size_t(numBytes) / (valuesPerSample * m_data->valueSize);
+    if (count == 0)
+        return;
+
+    m_data->memory = m_data->file.map(m_data->offset, qint64(count * valuesPerSample * m_data->valueSize));
+    if (m_data->memory) {
+        m_data->count     = count;
+        m_data->viewCount = count;
+    }
+}
+
+//! Destructor
+QwtMappedPointData::~QwtMappedPointData()
+{
+    m_data->closeSummary();
+    delete m_data;
+}
+
+//! \return True, when the file could be mapped
+bool QwtMappedPointData::isValid() const
+{
+    return m_data->memory != NULL;
+}
+
+//! \return Name of the data file
+QString QwtMappedPointData::fileName() const
+{
+    return m_data->file.fileName();
+}
+
+//! \return Type of the values in the file
+QwtMappedPointData::DataType QwtMappedPointData::dataType() const
+{
+    return m_data->dataType;
+}
+
+//! \return Organization of the values in the file
+QwtMappedPointData::Layout QwtMappedPointData::layout() const
+{
+    return m_data->layout;
+}
+
+//! \return Number of bytes skipped at the beginning of the file
+qint64 QwtMappedPointData::offset() const
+{
+    return m_data->offset;
+}
+
+/*!
+   \return Number of samples in the file
+   \sa size()
+ */
+size_t QwtMappedPointData::sampleCount() const
+{
+    return m_data->count;
+}
+
+/*!
+   \brief Sample from the file, regardless of the rectangle of interest
+
+   \param index Index of the sample in the file
+   \return Sample at index
+   \sa sampleCount(), sample()
+ */
+QPointF QwtMappedPointData::rawSample(size_t index) const
+{
+    return QPointF(m_data->xValue(index), m_data->yValue(index));
+}
+
+/*!
+   \brief Set the x coordinates for the ValuesOnly layout
+
+   The x coordinate of sample i is x0 + i * dx.
+
+   \param x0 x coordinate of the first sample
+   \param dx Distance between two samples, has to be positive
+   \sa xOrigin(), xStep()
+ */
+void QwtMappedPointData::setSampling(double x0, double dx)
+{
+    if (dx <= 0.0)
+        return;
+
+    m_data->x0 = x0;
+    m_data->dx = dx;
+
+    cachedBoundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
+    m_data->updateView();
+}
+
+//! \return x coordinate of the first sample for the ValuesOnly layout
+double QwtMappedPointData::xOrigin() const
+{
+    return m_data->x0;
+}
+
+//! \return Distance between two samples for the ValuesOnly layout
+double QwtMappedPointData::xStep() const
+{
+    return m_data->dx;
+}
+
+/*!
+   \brief Limit the number of samples offered for the rectangle of interest
+
+   When the rectangle of interest contains more samples they are decimated
+   into numSamples / 2 buckets, each represented by its minimum and maximum.
+   A good value is about twice the width of the canvas in pixels.
+
+   \param numSamples Maximum number of samples
+   \sa setRectOfInterest()
+ */
+void QwtMappedPointData::setMaxSamples(size_t numSamples)
+{
+    numSamples = qMax(numSamples, size_t(2));
+    if (numSamples != m_data->maxSamples) {
+        m_data->maxSamples = numSamples;
+        m_data->updateView();
+    }
+}
+
+//! \return Maximum number of samples offered for the rectangle of interest
+size_t QwtMappedPointData::maxSamples() const
+{
+    return m_data->maxSamples;
+}
+
+/*!
+   \brief Write a summary file for the data file
+
+   The summary stores the minimum and maximum of each block of blockSize samples.
+   Writing it reads the complete data file once.
+
+   \param fileName Name of the summary file
+   \param blockSize Number of samples summarized in one block
+   \return True on success
+   \sa setSummaryFile()
+ */
+bool QwtMappedPointData::writeSummary(const QString& fileName, size_t blockSize) const
+{
+    if (!isValid() || blockSize == 0)
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QwtMappedSummaryHeader header;
+    std::memcpy(header.magic, qwtMappedSummaryMagic, sizeof(header.magic));
+    header.sampleCount = m_data->count;
+    header.blockSize   = blockSize;
+    header.reserved    = 0;
+
+    if (file.write(reinterpret_cast< const char* >(&header), sizeof(header)) != qint64(sizeof(header)))
+        return false;
+
+    QVector< QwtMappedSummaryBlock > blocks;
+    blocks.reserve(1024);
+
+    for (size_t from = 0; from < m_data->count; from += blockSize) {
+        const size_t to = qMin(from + blockSize, m_data->count);
+
+        QwtMappedSummaryBlock block;
+        block.minX = block.minY = std::numeric_limits< double >::max();
+        block.maxX = block.maxY = -std::numeric_limits< double >::max();
+
+        for (size_t i = from; i < to; i++) {
+            const double x = m_data->xValue(i);
+            if (x < block.minX)
+                block.minX = x;
+            if (x > block.maxX)
+                block.maxX = x;
+        }
+
+        m_data->scanMinMax(from, to, block.minY, block.maxY);
+
+        blocks += block;
+
+        if (blocks.size() == 1024 || to == m_data->count) {
+            const qint64 numBytes = qint64(blocks.size() * sizeof(QwtMappedSummaryBlock));
+            if (file.write(reinterpret_cast< const char* >(blocks.constData()), numBytes) != numBytes)
+                return false;
+
+            blocks.clear();
+            blocks.reserve(1024);
+        }
+    }
+
+    return true;
+}
+
+/*!
+   \brief Use a summary file written by writeSummary()
+
+   The summary has to match the number of samples of the data file.
+
+   \param fileName Name of the summary file, an empty string removes the summary
+   \return True, when the summary could be mapped
+   \sa writeSummary(), hasSummary()
+ */
+bool QwtMappedPointData::setSummaryFile(const QString& fileName)
+{
+    m_data->closeSummary();
+
+    cachedBoundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
+
+    bool ok = false;
+
+    if (isValid() && !fileName.isEmpty()) {
+        m_data->summaryFile.setFileName(fileName);
+        if (m_data->summaryFile.open(QIODevice::ReadOnly)) {
+            const qint64 fileSize = m_data->summaryFile.size();
+            if (fileSize >= qint64(sizeof(QwtMappedSummaryHeader)))
+                m_data->summary = m_data->summaryFile.map(0, fileSize);
+        }
+
+        if (m_data->summary) {
+            QwtMappedSummaryHeader header;
+            std::memcpy(&header, m_data->summary, sizeof(header));
+
+            if (std::memcmp(header.magic, qwtMappedSummaryMagic, sizeof(header.magic)) == 0
+                && header.sampleCount == m_data->count && header.blockSize > 0) {
+                const quint64 numBlocks = (header.sampleCount + header.blockSize - 1) / header.blockSize;
+                const quint64 numBytes  = sizeof(header) + numBlocks * sizeof(QwtMappedSummaryBlock);
+
+                ok = (quint64(fileSize) == numBytes);
+                if (ok)
+                    m_data->summaryBlockSize = size_t(header.blockSize);
+            }
+        }
+
+        if (!ok)
+            m_data->closeSummary();
+    }
+
+    m_data->updateView();
+    return ok;
+}
+
+//! \return Name of the summary file
+QString QwtMappedPointData::summaryFile() const
+{
+    return hasSummary() ? m_data->summaryFile.fileName() : QString();
+}
+
+//! \return True, when a summary file is in use
+bool QwtMappedPointData::hasSummary() const
+{
+    return m_data->summary != NULL;
+}
+
+//! \return Number of samples summarized in one block of the summary file
+size_t QwtMappedPointData::summaryBlockSize() const
+{
+    return m_data->summaryBlockSize;
+}
+
+/*!
+   \return Number of samples offered for the rectangle of interest
+   \sa setRectOfInterest(), sampleCount()
+ */
+size_t QwtMappedPointData::size() const
+{
+    if (m_data->decimated)
+        return size_t(m_data->view.size());
+
+    return m_data->viewCount;
+}
+
+/*!
+   \param index Index
+   \return Sample at position index of the samples
+           offered for the rectangle of interest
+   \sa rawSample()
+ */
+QPointF QwtMappedPointData::sample(size_t index) const
+{
+    if (m_data->decimated)
+        return m_data->view[ int(index) ];
+
+    return rawSample(m_data->viewFirst + index);
+}
+
+/*!
+   \brief Bounding rectangle of all samples in the file
+
+   The x interval is given by the first and the last sample. The y interval
+   is taken from the summary, if available. Otherwise the complete file
+   has to be read once. The result is cached.
+
+   \return Bounding rectangle
+ */
+QRectF QwtMappedPointData::boundingRect() const
+{
+    if (cachedBoundingRect.width() < 0.0 && m_data->count > 0) {
+        const size_t count = m_data->count;
+
+        double minY = std::numeric_limits< double >::max();
+        double maxY = -std::numeric_limits< double >::max();
+
+        m_data->rangeMinMax(0, count, minY, maxY);
+
+        const double minX = m_data->xValue(0);
+        const double maxX = m_data->xValue(count - 1);
+
+        if (minY <= maxY && minX <= maxX)
+            cachedBoundingRect = QRectF(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    return cachedBoundingRect;
+}
+
+/*!
+   \brief Select the samples for the visible area
+
+   \param rect Rectangle of interest
+   \sa QwtPlotSeriesItem::updateScaleDiv(), setMaxSamples()
+ */
+void QwtMappedPointData::setRectOfInterest(const QRectF& rect)
+{
+    if (rect == m_data->rectOfInterest)
+        return;
+
+    m_data->rectOfInterest = rect;
+    m_data->updateView();
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtMappedPointData::rectOfInterest() const
+{
+    return m_data->rectOfInterest;
+}
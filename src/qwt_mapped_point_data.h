@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_POINT_DATA_H
+#define QWT_MAPPED_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QString;
+
+/*!
+   \brief Point series backed by a memory mapped binary file
+
+   QwtCPointerData and QwtPointArrayData need all samples in memory.
+   QwtMappedPointData maps a binary file instead, so that recordings much
+   larger than the physical memory can be displayed. Only the pages being
+   accessed are loaded by the operating system.
+
+   The file contains raw values of dataType() in native byte order,
+   starting at offset(). The samples are organized according to layout():
+
+   - Interleaved\n
+     x0 y0 x1 y1 x2 y2 ...
+   - Columns\n
+     x0 x1 x2 ... y0 y1 y2 ...
+   - ValuesOnly\n
+     y0 y1 y2 ..., the x coordinates are calculated from setSampling()
+
+   The x coordinates have to be increasing, what is the case for
+   recordings over time.
+
+   In setRectOfInterest() the range of samples inside the visible x interval
+   is found by binary search. When it contains more than maxSamples()
+   samples, the data offers a decimated view: for each bucket of samples
+   the minimum and the maximum are returned. This way a curve can browse
+   the whole recording with a constant amount of memory and without
+   losing peaks.
+
+   A summary file with the minimum and maximum of fixed blocks of samples
+   can be precomputed with writeSummary(). With setSummaryFile() it is used
+   for boundingRect() and for decimating long ranges, so that only the samples
+   at the borders of a bucket need to be read from the data file.
+
+   \note The complete file is mapped into the address space,
+         what requires a 64 bit system for very large files.
+
+   \sa QwtPlotCurve::setData(), QwtCPointerData
+ */
+class QWT_EXPORT QwtMappedPointData : public QwtSeriesData< QPointF >
+{
+public:
+    //! Type of the values in the file
+    enum DataType
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64
+    };
+
+    //! Organization of the values in the file
+    enum Layout
+    {
+        //! x and y values alternate
+        Interleaved,
+
+        //! All x values followed by all y values
+        Columns,
+
+        //! Only y values, x is calculated from setSampling()
+        ValuesOnly
+    };
+
+    explicit QwtMappedPointData(const QString& fileName,
+                                DataType = Float64,
+                                Layout   = Interleaved,
+                                qint64 offset = 0);
+
+    virtual ~QwtMappedPointData();
+
+    bool isValid() const;
+
+    QString fileName() const;
+    DataType dataType() const;
+    Layout layout() const;
+    qint64 offset() const;
+
+    size_t sampleCount() const;
+    QPointF rawSample(size_t index) const;
+
+    void setSampling(double x0, double dx);
+    double xOrigin() const;
+    double xStep() const;
+
+    void setMaxSamples(size_t);
+    size_t maxSamples() const;
+
+    bool writeSummary(const QString& fileName, size_t blockSize = 4096) const;
+
+    bool setSummaryFile(const QString& fileName);
+    QString summaryFile() const;
+    bool hasSummary() const;
+    size_t summaryBlockSize() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample(size_t index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual void setRectOfInterest(const QRectF&) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+private:
+    Q_DISABLE_COPY(QwtMappedPointData)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,359 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mipmap_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qrect.h>
+#include <qsize.h>
+
+namespace
+{
+class QwtMipmapLevel
+{
+public:
+    QwtMipmapLevel()
+        : numColumns(0)
+        , numRows(0)
+    {
+    }
+
+    inline double value(int row, int col) const
+    {
+        return values.constData()[ row * numColumns + col ];
+    }
+
+    QVector< double > values;
+    int numColumns;
+    int numRows;
+};
+}
+
+static double qwtMipmapReduce(QwtMipmapRasterData::Reduction reduction, const double* v, int count)
+{
+    int n        = 0;
+    double value = 0.0;
+
+    for (int i = 0; i < count; i++) {
+        if (qIsNaN(v[ i ]))
+            continue;
+
+        if (n == 0) {
+            value = v[ i ];
+        } else {
+            switch (reduction) {
+            case QwtMipmapRasterData::Minimum:
+                value = qMin(value, v[ i ]);
+                break;
+            case QwtMipmapRasterData::Maximum:
+                value = qMax(value, v[ i ]);
+                break;
+            case QwtMipmapRasterData::Mean:
+            default:
+                value += v[ i ];
+                break;
+            }
+        }
+        n++;
+    }
+
+    if (n == 0)
+        return qQNaN();
+
+    if (reduction == QwtMipmapRasterData::Mean)
+        value /= n;
+
+    return value;
+}
+
+// value of the cell at row/col of level l, reduced from level l - 1
+static double qwtMipmapCell(QwtMipmapRasterData::Reduction reduction, const QwtMipmapLevel& below, int row, int col)
+{
+    const int r0 = 2 * row;
+    const int c0 = 2 * col;
+    const int r1 = qMin(r0 + 1, below.numRows - 1);
+    const int c1 = qMin(c0 + 1, below.numColumns - 1);
+
+    double v[ 4 ];
+    int count = 0;
+
+    v[ count++ ] = below.value(r0, c0);
+    if (c1 != c0)
+        v[ count++ ] = below.value(r0, c1);
+
+    if (r1 != r0) {
+        v[ count++ ] = below.value(r1, c0);
+        if (c1 != c0)
+            v[ count++ ] = below.value(r1, c1);
+    }
+
+    return qwtMipmapReduce(reduction, v, count);
+}
+
+class QwtMipmapRasterData::PrivateData
+{
+public:
+    PrivateData()
+        : reduction(QwtMipmapRasterData::Mean)
+        , currentLevel(0)
+    {
+    }
+
+    QwtMipmapRasterData::Reduction reduction;
+
+    // levels[0] is the original matrix
+    QVector< QwtMipmapLevel > levels;
+    int currentLevel;
+};
+
+//! Constructor
+QwtMipmapRasterData::QwtMipmapRasterData()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtMipmapRasterData::~QwtMipmapRasterData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the reduction of 2x2 values into a value of the next level
+
+   Maximum is a good choice for showing peaks in an overview, Mean for
+   smooth images. Changing the reduction rebuilds the pyramid.
+
+   \param reduction Reduction
+   \sa reduction()
+ */
+void QwtMipmapRasterData::setReduction(Reduction reduction)
+{
+    if (reduction != m_data->reduction) {
+        m_data->reduction = reduction;
+        buildPyramid();
+    }
+}
+
+/*!
+   \return Reduction of 2x2 values into a value of the next level
+   \sa setReduction()
+ */
+QwtMipmapRasterData::Reduction QwtMipmapRasterData::reduction() const
+{
+    return m_data->reduction;
+}
+
+/*!
+   \brief Assign a value matrix and build the pyramid
+
+   \param values Vector of values
+   \param numColumns Number of columns
+
+   \sa QwtMatrixRasterData::setValueMatrix()
+ */
+void QwtMipmapRasterData::setValueMatrix(const QVector< double >& values, int numColumns)
+{
+    QwtMatrixRasterData::setValueMatrix(values, numColumns);
+    buildPyramid();
+}
+
+/*!
+   \brief Change a single value in the matrix
+
+   The cells of the pyramid covering the value are updated.
+
+   \param row Row index
+   \param col Column index
+   \param value New value
+
+   \sa QwtMatrixRasterData::setValue()
+ */
+void QwtMipmapRasterData::setValue(int row, int col, double value)
+{
+    if (row < 0 || row >= numRows() || col < 0 || col >= numColumns())
+        return;
+
+    QVector< QwtMipmapLevel >& levels = m_data->levels;
+    if (levels.isEmpty()) {
+        QwtMatrixRasterData::setValue(row, col, value);
+        return;
+    }
+
+    // release the shared copy, so that the matrix is not detached
+    levels[ 0 ].values = QVector< double >();
+    QwtMatrixRasterData::setValue(row, col, value);
+    levels[ 0 ].values = valueMatrix();
+
+    for (int l = 1; l < levels.size(); l++) {
+        row /= 2;
+        col /= 2;
+
+        QwtMipmapLevel& level = levels[ l ];
+        level.values[ row * level.numColumns + col ] =
+            qwtMipmapCell(m_data->reduction, levels[ l - 1 ], row, col);
+    }
+}
+
+/*!
+   \return Number of levels including the original matrix
+   \sa levelSize()
+ */
+int QwtMipmapRasterData::levelCount() const
+{
+    return m_data->levels.size();
+}
+
+/*!
+   \param level Level, 0 is the original matrix
+   \return Number of columns and rows of a level
+   \sa levelCount()
+ */
+QSize QwtMipmapRasterData::levelSize(int level) const
+{
+    if (level < 0 || level >= m_data->levels.size())
+        return QSize();
+
+    const QwtMipmapLevel& l = m_data->levels[ level ];
+    return QSize(l.numColumns, l.numRows);
+}
+
+/*!
+   \return Level selected by initRaster(), 0 outside of a rendering pass
+   \sa initRaster()
+ */
+int QwtMipmapRasterData::currentLevel() const
+{
+    return m_data->currentLevel;
+}
+
+/*!
+   \brief Select the level for rendering
+
+   The coarsest level is selected, whose values are not larger than
+   a pixel of the raster in both directions.
+
+   \param area Area to be rendered
+   \param raster Size of the image
+   \sa discardRaster(), currentLevel()
+ */
+void QwtMipmapRasterData::initRaster(const QRectF& area, const QSize& raster)
+{
+    QwtMatrixRasterData::initRaster(area, raster);
+
+    m_data->currentLevel = 0;
+
+    if (m_data->levels.size() <= 1 || raster.isEmpty() || numColumns() <= 0 || numRows() <= 0)
+        return;
+
+    const QwtInterval xInterval = interval(Qt::XAxis);
+    const QwtInterval yInterval = interval(Qt::YAxis);
+    if (!xInterval.isValid() || !yInterval.isValid())
+        return;
+
+    const double pixelWidth  = qAbs(area.width()) / raster.width();
+    const double pixelHeight = qAbs(area.height()) / raster.height();
+
+    double cellWidth  = xInterval.width() / numColumns();
+    double cellHeight = yInterval.width() / numRows();
+
+    while (m_data->currentLevel + 1 < m_data->levels.size()) {
+        cellWidth *= 2.0;
+        cellHeight *= 2.0;
+
+        if (cellWidth > pixelWidth || cellHeight > pixelHeight)
+            break;
+
+        m_data->currentLevel++;
+    }
+}
+
+/*!
+   \brief Return to the original matrix after rendering
+   \sa initRaster()
+ */
+void QwtMipmapRasterData::discardRaster()
+{
+    m_data->currentLevel = 0;
+    QwtMatrixRasterData::discardRaster();
+}
+
+/*!
+   \return Value at a raster position
+
+   On level 0 the value is resampled by QwtMatrixRasterData, on the
+   coarser levels the value of the cell containing the position is returned.
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+ */
+double QwtMipmapRasterData::value(double x, double y) const
+{
+    const int levelIndex = m_data->currentLevel;
+    if (levelIndex <= 0 || levelIndex >= m_data->levels.size())
+        return QwtMatrixRasterData::value(x, y);
+
+    const QwtInterval xInterval = interval(Qt::XAxis);
+    const QwtInterval yInterval = interval(Qt::YAxis);
+
+    if (!(xInterval.contains(x) && yInterval.contains(y)))
+        return qQNaN();
+
+    // cell j of level l covers the cells [j * 2^l, ( j + 1 ) * 2^l[ of level 0
+    const double scale = double(1 << levelIndex);
+    const double dx    = scale * xInterval.width() / numColumns();
+    const double dy    = scale * yInterval.width() / numRows();
+
+    const QwtMipmapLevel& level = m_data->levels[ levelIndex ];
+
+    int row = int((y - yInterval.minValue()) / dy);
+    int col = int((x - xInterval.minValue()) / dx);
+
+    if (row >= level.numRows)
+        row = level.numRows - 1;
+
+    if (col >= level.numColumns)
+        col = level.numColumns - 1;
+
+    return level.value(row, col);
+}
+
+void QwtMipmapRasterData::buildPyramid()
+{
+    QVector< QwtMipmapLevel >& levels = m_data->levels;
+
+    levels.clear();
+    m_data->currentLevel = 0;
+
+    if (numColumns() <= 0 || numRows() <= 0)
+        return;
+
+    QwtMipmapLevel base;
+    base.values     = valueMatrix();
+    base.numColumns = numColumns();
+    base.numRows    = numRows();
+    levels += base;
+
+    while (levels.last().numColumns > 1 || levels.last().numRows > 1) {
+        const QwtMipmapLevel& below = levels.last();
+
+        QwtMipmapLevel level;
+        level.numColumns = (below.numColumns + 1) / 2;
+        level.numRows    = (below.numRows + 1) / 2;
+        level.values.resize(level.numColumns * level.numRows);
+
+        double* values = level.values.data();
+        for (int row = 0; row < level.numRows; row++) {
+            for (int col = 0; col < level.numColumns; col++)
+                *values++ = qwtMipmapCell(m_data->reduction, below, row, col);
+        }
+
+        levels += level;
+    }
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MIPMAP_RASTER_DATA_H
+#define QWT_MIPMAP_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_matrix_raster_data.h"
+
+class QSize;
+
+/*!
+   \brief Matrix raster data with a pyramid of downsampled levels
+
+   When a spectrogram is zoomed out, so that a pixel of the canvas covers
+   many values of the matrix, QwtMatrixRasterData picks a single value for
+   each pixel. Narrow features get lost or flicker depending on the
+   position, and the cost is the same as for a zoomed in raster.
+
+   QwtMipmapRasterData builds a pyramid of levels in setValueMatrix().
+   Each level has half of the columns and rows of the level below, where
+   a value is the reduction() - mean, minimum or maximum - of the
+   corresponding 2x2 values.
+
+   In initRaster() the coarsest level is selected, whose values are still
+   not larger than a pixel of the image to be rendered. value() then
+   returns the value from this level, while outside of a rendering pass
+   and when being zoomed in the original matrix is used with the
+   resampling mode of QwtMatrixRasterData.
+
+   The pyramid needs about a third of the memory of the matrix.
+
+   \note setValueMatrix() and setValue() hide the non virtual methods
+         of QwtMatrixRasterData. Calling them through a pointer to
+         the base class leaves the pyramid outdated.
+
+   \sa QwtPlotSpectrogram, QwtMatrixRasterData
+ */
+class QWT_EXPORT QwtMipmapRasterData : public QwtMatrixRasterData
+{
+public:
+    //! Reduction of 2x2 values into a value of the next level
+    enum Reduction
+    {
+        //! Mean of the values, NaN values are ignored
+        Mean,
+
+        //! Minimum of the values
+        Minimum,
+
+        //! Maximum of the values
+        Maximum
+    };
+
+    QwtMipmapRasterData();
+    virtual ~QwtMipmapRasterData();
+
+    void setReduction(Reduction);
+    Reduction reduction() const;
+
+    void setValueMatrix(const QVector< double >& values, int numColumns);
+    void setValue(int row, int col, double value);
+
+    int levelCount() const;
+    QSize levelSize(int level) const;
+    int currentLevel() const;
+
+    virtual void initRaster(const QRectF&, const QSize& raster) QWT_OVERRIDE;
+    virtual void discardRaster() QWT_OVERRIDE;
+
+    virtual double value(double x, double y) const QWT_OVERRIDE;
+
+private:
+    Q_DISABLE_COPY(QwtMipmapRasterData)
+
+    void buildPyramid();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -45,8 +45,14 @@
 #include "qwt_plot_transparent_canvas.h"
 #include "qwt_parasite_plot_layout.h"
 #include "qwt_plot_scale_event_dispatcher.h"
+#include "qwt_painter.h"
+#include "qwt_render_stats.h"
 // qt
 #include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qmap.h>
+#include <qscopedpointer.h>
 #include <qpointer.h>
 #include <qapplication.h>
 #include <qcoreevent.h>
@@ -112,6 +118,42 @@ static void qwtSetTabOrder(QWidget* first, QWidget* second, bool withChildren)
     }
 }
 
+static void qwtDrawPlotItem(QPainter* painter,
+                            QwtPlotItem* item,
+                            const QRectF& canvasRect,
+                            const QwtScaleMap maps[ QwtAxis::AxisPositions ])
+{
+    painter->save();
+
+    painter->setRenderHint(QPainter::Antialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
+
+#if QT_VERSION < 0x050100
+    painter->setRenderHint(QPainter::HighQualityAntialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
+#endif
+
+    QwtRenderStats* stats = QwtRenderStats::active();
+    if (stats)
+        stats->beginItem(item->title().text(), item->rtti());
+
+    item->draw(painter, maps[ item->xAxis() ], maps[ item->yAxis() ], canvasRect);
+
+    if (stats)
+        stats->endItem();
+
+    painter->restore();
+}
+
+static inline bool qwtCanCompositeLayers(const QPainter* painter)
+{
+    // the layer images are aligned to the pixels of the canvas, what
+    // is only the case for unscaled raster paint devices
+    const QPaintEngine* engine = painter->paintEngine();
+    if (engine == NULL || engine->type() != QPaintEngine::Raster)
+        return false;
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
 class QwtPlot::PrivateData
 {
     QWT_DECLARE_PUBLIC(QwtPlot)
@@ -129,6 +171,19 @@ public:
 
     bool isParasitePlot { false };                                ///< 标记这个绘图是寄生绘图
     QMetaObject::Connection shareConn[ QwtAxis::AxisPositions ];  // 记录寄生轴和宿主轴坐标同步的信号槽，仅仅针对寄生轴有用
+
+    // 分层缓存合成
+    struct CacheLayer
+    {
+        QImage image;
+        bool isDirty { true };
+    };
+    bool layeredCompositing { false };
+    QMap< int, CacheLayer > cacheLayers;
+    QVector< double > cacheLayersKey;  ///< 缓存层对应的画布尺寸和坐标映射，变化时所有层都需要重绘
+
+    // 渲染统计，未启用时为nullptr
+    QScopedPointer< QwtRenderStats > renderStats;
 };
 
 QwtPlot::PrivateData::PrivateData(QwtPlot* p) : q_ptr(p)
@@ -814,8 +869,9 @@ void QwtPlot::updateCanvasMargins()
 
    \warning drawCanvas calls drawItems what is also used
            for printing. Applications that like to add individual
-           plot items better overload drawItems()
-   \sa drawItems()
+           plot items better overload drawItems(). When layered compositing
+           is enabled drawItems() is bypassed on the screen.
+   \sa drawItems(), setLayeredCompositing()
  */
 void QwtPlot::drawCanvas(QPainter* painter)
 {
@@ -823,7 +879,27 @@ void QwtPlot::drawCanvas(QPainter* painter)
     for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++)
         maps[ axisPos ] = canvasMap(axisPos);
 
-    drawItems(painter, m_data->canvas->contentsRect(), maps);
+    const QRectF canvasRect = m_data->canvas->contentsRect();
+
+    QwtRenderStats* stats = m_data->renderStats.data();
+    QwtRenderStats* previousStats = NULL;
+    if (stats) {
+        // parasite plots are drawn while the host is rendering
+        previousStats = QwtRenderStats::setActive(stats);
+        stats->beginRender();
+    }
+
+    if (m_data->layeredCompositing && qwtCanCompositeLayers(painter))
+        drawCacheLayers(painter, canvasRect, maps);
+    else
+        drawItems(painter, canvasRect, maps);
+
+    if (stats) {
+        stats->endRender();
+        QwtRenderStats::setActive(previousStats);
+
+        Q_EMIT renderStatsUpdated(*stats);
+    }
 }
 
 /*!
@@ -844,25 +920,222 @@ void QwtPlot::drawItems(QPainter* painter, const QRectF& canvasRect, const QwtSc
     const QwtPlotItemList& itmList = itemList();
     for (QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it) {
         QwtPlotItem* item = *it;
-        if (item && item->isVisible()) {
-            const QwtAxisId xAxis = item->xAxis();
-            const QwtAxisId yAxis = item->yAxis();
+        if (item && item->isVisible())
+            qwtDrawPlotItem(painter, item, canvasRect, maps);
+    }
+}
 
-            painter->save();
+/*!
+   \brief Enable/Disable layered compositing of the canvas
+
+   In layered compositing mode the visible items are grouped by their
+   cache layer ( QwtPlotItem::cacheLayer() ). Each layer is rendered into
+   an image of its own, that is composited in increasing layer order on the canvas.
+   On a replot only the layers are rendered again, that have been
+   invalidated - usually by QwtPlotItem::itemChanged() - while the others are
+   composited from their images. Changing the geometry of the canvas, one of
+   the scales or the scale engine of an axis invalidates all layers.
+
+   This is useful when a few items are updated frequently on top
+   of expensive, but static content: f.e. a spectrogram in layer 0 with
+   a cursor marker in layer 1.
+
+   \param on On/Off
+   \note The z order of the items is respected inside of a layer only.
+   \note Items, whose data is modified without calling itemChanged(),
+         need an explicit invalidateCacheLayer().
+   \note The layers are not invalidated, when the transformation of the current
+         scale engine is replaced by QwtScaleEngine::setTransformation().
+         Call invalidateCacheLayers() then, or use setAxisScaleEngine().
+   \note The layers are bypassed for painters, that can't be composited
+         pixel aligned ( f.e printing ) - and drawItems() is used instead.
+
+   \sa isLayeredCompositing(), invalidateCacheLayer(), QwtPlotItem::setCacheLayer()
+ */
+void QwtPlot::setLayeredCompositing(bool on)
+{
+    if (on == m_data->layeredCompositing)
+        return;
 
-            painter->setRenderHint(QPainter::Antialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
+    m_data->layeredCompositing = on;
+    if (!on) {
+        m_data->cacheLayers.clear();
+        m_data->cacheLayersKey.clear();
+    }
+}
 
-#if QT_VERSION < 0x050100
-            painter->setRenderHint(QPainter::HighQualityAntialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
-#endif
+/*!
+   \return True, when layered compositing is enabled
+   \sa setLayeredCompositing()
+ */
+bool QwtPlot::isLayeredCompositing() const
+{
+    return m_data->layeredCompositing;
+}
+
+/*!
+   \brief Mark a cache layer to be rendered again on the next replot
+   \param layer Cache layer
+   \sa invalidateCacheLayers(), QwtPlotItem::setCacheLayer()
+ */
+void QwtPlot::invalidateCacheLayer(int layer)
+{
+    QMap< int, PrivateData::CacheLayer >::iterator it = m_data->cacheLayers.find(layer);
+    if (it != m_data->cacheLayers.end())
+        it.value().isDirty = true;
+}
+
+/*!
+   \brief Mark all cache layers to be rendered again on the next replot
+   \sa invalidateCacheLayer()
+ */
+void QwtPlot::invalidateCacheLayers()
+{
+    for (QMap< int, PrivateData::CacheLayer >::iterator it = m_data->cacheLayers.begin();
+         it != m_data->cacheLayers.end();
+         ++it) {
+        it.value().isDirty = true;
+    }
+}
+
+/*!
+   \brief Composite the cache layers on the canvas
+
+   Dirty layers are rendered into their images first.
+
+   \param painter Painter of the canvas
+   \param canvasRect Contents rectangle of the canvas
+   \param maps Maps, mapping between plot and paint device coordinates
+
+   \sa setLayeredCompositing()
+ */
+void QwtPlot::drawCacheLayers(QPainter* painter, const QRectF& canvasRect, const QwtScaleMap maps[ QwtAxis::AxisPositions ])
+{
+    const QSize size       = m_data->canvas->size();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio(painter->device());
+
+    QVector< double > key;
+    key.reserve(3 + 4 * QwtAxis::AxisPositions);
+    key << size.width() << size.height() << pixelRatio;
+    for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+        const QwtScaleMap& map = maps[ axisPos ];
+        key << map.s1() << map.s2() << map.p1() << map.p2();
+    }
+
+    if (key != m_data->cacheLayersKey) {
+        m_data->cacheLayersKey = key;
+        invalidateCacheLayers();
+    }
+
+    // sort the visible items into their layers, keeping the z order
+    QMap< int, QwtPlotItemList > layerItems;
+
+    const QwtPlotItemList& itmList = itemList();
+    for (QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it) {
+        QwtPlotItem* item = *it;
+        if (item && item->isVisible())
+            layerItems[ item->cacheLayer() ] += item;
+    }
+
+    // release the images of layers without visible items
+    for (QMap< int, PrivateData::CacheLayer >::iterator it = m_data->cacheLayers.begin();
+         it != m_data->cacheLayers.end();) {
+        if (layerItems.contains(it.key()))
+            ++it;
+        else
+            it = m_data->cacheLayers.erase(it);
+    }
+
+    for (QMap< int, QwtPlotItemList >::const_iterator it = layerItems.constBegin(); it != layerItems.constEnd(); ++it) {
+        PrivateData::CacheLayer& layer = m_data->cacheLayers[ it.key() ];
+
+        const bool isValid = !(layer.isDirty || layer.image.isNull());
+        if (m_data->renderStats)
+            m_data->renderStats->addCacheAccess(QwtRenderStats::LayerCache, isValid);
+
+        if (!isValid) {
+            layer.image = QImage(size * pixelRatio, QImage::Format_ARGB32_Premultiplied);
+            layer.image.setDevicePixelRatio(pixelRatio);
+            layer.image.fill(Qt::transparent);
 
-            item->draw(painter, maps[ xAxis ], maps[ yAxis ], canvasRect);
+            QPainter p(&layer.image);
+            p.setFont(painter->font());
+            p.setRenderHints(painter->renderHints());
 
-            painter->restore();
+            const QwtPlotItemList& items = it.value();
+            for (int i = 0; i < items.size(); i++)
+                qwtDrawPlotItem(&p, items[ i ], canvasRect, maps);
+
+            p.end();
+
+            layer.isDirty = false;
         }
+
+        painter->drawImage(QPointF(0.0, 0.0), layer.image);
     }
 }
 
+/*!
+   \brief Enable/Disable the render statistics
+
+   When enabled each render pass of the canvas is recorded: the time of the pass
+   and of each item, the number of samples mapped by QwtPointMapper and the hits
+   and misses of the caches. After each pass renderStatsUpdated() is emitted.
+
+   The statistics cost a few timer calls per item only, but are disabled
+   by default.
+
+   \param on On/Off
+   \sa isRenderStatsEnabled(), renderStats(), QwtRenderStats
+ */
+void QwtPlot::setRenderStatsEnabled(bool on)
+{
+    if (on == isRenderStatsEnabled())
+        return;
+
+    if (on)
+        m_data->renderStats.reset(new QwtRenderStats());
+    else
+        m_data->renderStats.reset();
+}
+
+/*!
+   \return True, when the render statistics are enabled
+   \sa setRenderStatsEnabled()
+ */
+bool QwtPlot::isRenderStatsEnabled() const
+{
+    return !m_data->renderStats.isNull();
+}
+
+/*!
+   \return Render statistics, or NULL when they are disabled
+   \sa setRenderStatsEnabled(), resetRenderStats()
+ */
+QwtRenderStats* QwtPlot::renderStats()
+{
+    return m_data->renderStats.data();
+}
+
+/*!
+   \return Render statistics, or NULL when they are disabled
+   \sa setRenderStatsEnabled(), resetRenderStats()
+ */
+const QwtRenderStats* QwtPlot::renderStats() const
+{
+    return m_data->renderStats.data();
+}
+
+/*!
+   \brief Clear all timings and counters of the render statistics
+   \sa renderStats()
+ */
+void QwtPlot::resetRenderStats()
+{
+    if (m_data->renderStats)
+        m_data->renderStats->reset();
+}
+
 /*!
    \param axisId Axis
    \return Map for the axis on the canvas. With this map pixel coordinates can
@@ -1572,16 +1845,22 @@ void QwtPlot::rescaleAxes(bool onlyVisibleItems, double marginPercent, QwtAxisId
     double maxY  = std::numeric_limits< double >::lowest();
     bool hasData = false;
 
+    // 如果只处理可见项/If only processing visible items
+    QwtPlotItemList items;
+    const QwtPlotItemList& allItems = itemList();
+    for (QwtPlotItemIterator it = allItems.begin(); it != allItems.end(); ++it) {
+        if (!onlyVisibleItems || (*it)->isVisible()) {
+            items += *it;
+        }
+    }
+
+    // 大数据量的曲线并行计算边界矩形，与updateAxes()相同/Large series are calculated in parallel, like in updateAxes()
+    cacheBoundingRects(items);
+
     // 遍历所有绘图项/Iterate through all plot items
-    const QwtPlotItemList& items = itemList();
     for (QwtPlotItemIterator it = items.begin(); it != items.end(); ++it) {
         QwtPlotItem* item = *it;
 
-        // 如果只处理可见项/If only processing visible items
-        if (onlyVisibleItems && !item->isVisible()) {
-            continue;
-        }
-
         // 获取该项的边界矩形/Get bounding rectangle of the item
         QRectF boundingRect = item->boundingRect();
 
@@ -1960,6 +2239,8 @@ void QwtPlot::attachItem(QwtPlotItem* plotItem, bool on)
     else
         removeItem(plotItem);
 
+    invalidateCacheLayer(plotItem->cacheLayer());
+
     Q_EMIT itemAttached(plotItem, on);
 
     if (plotItem->testItemAttribute(QwtPlotItem::Legend)) {
@@ -30,6 +30,7 @@
 #include "qwt_global.h"
 #include "qwt_axis_id.h"
 #include "qwt_plot_dict.h"
+#include "qwt_render_stats.h"
 
 #include <qframe.h>
 
@@ -44,6 +45,7 @@ class QwtTextLabel;
 class QwtInterval;
 class QwtText;
 class QwtPlotScaleEventDispatcher;
+class QwtPlotAxisLink;
 
 template< typename T >
 class QList;
@@ -223,6 +225,9 @@ public:
     void setAxisMaxMajor(QwtAxisId, int maxMajor);
     int axisMaxMajor(QwtAxisId) const;
 
+    // 坐标轴所在的联动组，没有则返回nullptr
+    QwtPlotAxisLink* axisLink(QwtAxisId) const;
+
     // Legend
 
     void insertLegend(QwtAbstractLegend*, LegendPosition = QwtPlot::RightLegend, double ratio = -1.0);
@@ -340,6 +345,18 @@ public:
     void panCanvas(const QPoint& offset);
     // 对坐标轴进行缩放，注意，需要手动replot
     void zoomAxis(QwtAxisId axisId, double factor, const QPoint& centerPosPixels);
+    // 分层缓存合成：每个缓存层的items单独缓存为图片，replot时只重绘发生变化的层
+    void setLayeredCompositing(bool on);
+    bool isLayeredCompositing() const;
+    // 标记缓存层需要重绘，item调用itemChanged时会自动标记其所在的层
+    void invalidateCacheLayer(int layer);
+    void invalidateCacheLayers();
+    // 渲染统计：记录每次画布绘制及每个item的耗时、采样点数、缓存命中情况
+    void setRenderStatsEnabled(bool on);
+    bool isRenderStatsEnabled() const;
+    QwtRenderStats* renderStats();
+    const QwtRenderStats* renderStats() const;
+    void resetRenderStats();
 #if QWT_AXIS_COMPAT
     enum Axis
     {
@@ -389,6 +406,13 @@ Q_SIGNALS:
      * @note This signal is emitted only by the host plot.
      */
     void parasitePlotAttached(QwtPlot* parasitePlot, bool on);
+
+    /**
+     * @brief Emitted after each render pass of the canvas, when the render statistics are enabled
+     * @param stats Render statistics
+     * @sa setRenderStatsEnabled()
+     */
+    void renderStatsUpdated(const QwtRenderStats& stats);
 public Q_SLOTS:
     virtual void replot();
     void autoRefresh();
@@ -404,6 +428,8 @@ protected:
     void initParasiteAxes(QwtPlot* parasitePlot) const;
     // updateLayout的具体实现
     void doLayout();
+    // 分层缓存合成的绘制实现
+    void drawCacheLayers(QPainter*, const QRectF&, const QwtScaleMap maps[ QwtAxis::AxisPositions ]);
 private Q_SLOTS:
     void updateLegendItems(const QVariant& itemInfo, const QList< QwtLegendData >& legendData);
     void yLeftRequestScaleRangeUpdate(double min, double max);
@@ -415,8 +441,12 @@ private:
     friend class QwtPlotItem;
     void attachItem(QwtPlotItem*, bool);
 
+    friend class QwtPlotAxisLink;
+    void setAxisLink(QwtAxisId, QwtPlotAxisLink*);
+
     void initAxesData();
     void deleteAxesData();
+    void cacheBoundingRects(const QwtPlotItemList&) const;
 
     void initPlot(const QwtText& title);
     // 最顶部的寄生绘图对宿主绘图调用updateAllAxisEdgeMargin
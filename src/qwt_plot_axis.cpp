@@ -24,6 +24,7 @@
  *   8. Amalgamated build: single QwtPlot.h / QwtPlot.cpp pair in src-amalgamate.
  *****************************************************************************/
 #include <QtDebug>
+#include <QPointer>
 #include "qwt_plot.h"
 #include "qwt_scale_widget.h"
 #include "qwt_scale_map.h"
@@ -31,6 +32,132 @@
 #include "qwt_scale_engine.h"
 #include "qwt_interval.h"
 #include "qwt_plot_scale_event_dispatcher.h"
+#include "qwt_plot_axis_link.h"
+#include "qwt_plot_curve.h"
+#include "qwt_plot_spectrocurve.h"
+#include "qwt_plot_intervalcurve.h"
+#include "qwt_plot_histogram.h"
+#include "qwt_plot_tradingcurve.h"
+#include "qwt_point_data.h"
+#include "qwt_shared_point_data.h"
+
+#include <qvector.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+#include <typeinfo>
+
+// items with less samples are not worth a thread
+static const size_t qwtParallelBoundingRectSize = 100000;
+
+/*
+   The bounding rectangle of these series data classes is calculated
+   from samples in memory without calling any application code.
+   The exact type is checked, as derived classes - like QwtSyntheticPointData -
+   might calculate their samples.
+ */
+static bool qwtIsArraySeriesData(const QwtSeriesData< QPointF >* data)
+{
+    const std::type_info& type = typeid(*data);
+
+    return type == typeid(QwtPointSeriesData) || type == typeid(QwtPointArrayData< double >)
+           || type == typeid(QwtPointArrayData< float >) || type == typeid(QwtCPointerData< double >)
+           || type == typeid(QwtCPointerData< float >) || type == typeid(QwtSharedPointData);
+}
+
+static bool qwtIsArraySeriesData(const QwtSeriesData< QwtPoint3D >* data)
+{
+    return typeid(*data) == typeid(QwtPoint3DSeriesData);
+}
+
+static bool qwtIsArraySeriesData(const QwtSeriesData< QwtIntervalSample >* data)
+{
+    return typeid(*data) == typeid(QwtIntervalSeriesData);
+}
+
+static bool qwtIsArraySeriesData(const QwtSeriesData< QwtOHLCSample >* data)
+{
+    return typeid(*data) == typeid(QwtTradingChartData);
+}
+
+// the series data of the item, when it is one of the classes above
+template< typename T >
+static const QwtSeriesData< T >* qwtArraySeriesData(const QwtSeriesStore< T >* store)
+{
+    const QwtSeriesData< T >* data = store->data();
+    return (data && qwtIsArraySeriesData(data)) ? data : NULL;
+}
+
+template< typename T >
+static size_t qwtArraySeriesSize(const QwtSeriesStore< T >* store)
+{
+    const QwtSeriesData< T >* data = qwtArraySeriesData(store);
+    return data ? data->size() : 0;
+}
+
+template< typename T >
+static void qwtCacheArraySeriesRect(const QwtSeriesStore< T >* store)
+{
+    const QwtSeriesData< T >* data = qwtArraySeriesData(store);
+    if (data)
+        (void)data->boundingRect();
+}
+
+/*
+   Number of samples of the built-in series items with array based data,
+   whose bounding rectangle can be calculated in a worker thread.
+   0 for all other items.
+ */
+static size_t qwtBoundingRectWorkload(const QwtPlotItem* item)
+{
+    switch (item->rtti()) {
+    case QwtPlotItem::Rtti_PlotCurve:
+        return qwtArraySeriesSize< QPointF >(static_cast< const QwtPlotCurve* >(item));
+    case QwtPlotItem::Rtti_PlotSpectroCurve:
+        return qwtArraySeriesSize< QwtPoint3D >(static_cast< const QwtPlotSpectroCurve* >(item));
+    case QwtPlotItem::Rtti_PlotIntervalCurve:
+        return qwtArraySeriesSize< QwtIntervalSample >(static_cast< const QwtPlotIntervalCurve* >(item));
+    case QwtPlotItem::Rtti_PlotHistogram:
+        return qwtArraySeriesSize< QwtIntervalSample >(static_cast< const QwtPlotHistogram* >(item));
+    case QwtPlotItem::Rtti_PlotTradingCurve:
+        return qwtArraySeriesSize< QwtOHLCSample >(static_cast< const QwtPlotTradingCurve* >(item));
+    default:
+        return 0;
+    }
+}
+
+/*
+   Fill the cached bounding rectangle of the series data. Only the data is
+   touched - QwtPlotItem::boundingRect() might be overloaded and is called
+   later from the GUI thread, then returning the cached rectangle.
+ */
+static void qwtCacheBoundingRect(const QwtPlotItem* item)
+{
+    switch (item->rtti()) {
+    case QwtPlotItem::Rtti_PlotCurve:
+        qwtCacheArraySeriesRect< QPointF >(static_cast< const QwtPlotCurve* >(item));
+        break;
+    case QwtPlotItem::Rtti_PlotSpectroCurve:
+        qwtCacheArraySeriesRect< QwtPoint3D >(static_cast< const QwtPlotSpectroCurve* >(item));
+        break;
+    case QwtPlotItem::Rtti_PlotIntervalCurve:
+        qwtCacheArraySeriesRect< QwtIntervalSample >(static_cast< const QwtPlotIntervalCurve* >(item));
+        break;
+    case QwtPlotItem::Rtti_PlotHistogram:
+        qwtCacheArraySeriesRect< QwtIntervalSample >(static_cast< const QwtPlotHistogram* >(item));
+        break;
+    case QwtPlotItem::Rtti_PlotTradingCurve:
+        qwtCacheArraySeriesRect< QwtOHLCSample >(static_cast< const QwtPlotTradingCurve* >(item));
+        break;
+    default:
+        break;
+    }
+}
 
 namespace
 {
@@ -92,6 +219,7 @@ public:
     QwtScaleDiv scaleDiv;
     QwtScaleEngine* scaleEngine;
     QwtScaleWidget* scaleWidget;
+    QPointer< QwtPlotAxisLink > link;  ///< 坐标轴所在的联动组
 };
 }
 
@@ -272,6 +400,9 @@ void QwtPlot::setAxisScaleEngine(QwtAxisId axisId, QwtScaleEngine* scaleEngine)
 
         d.isValid = false;
 
+        // the scale maps might differ in their transformation only
+        invalidateCacheLayers();
+
         autoRefresh();
     }
 }
@@ -354,6 +485,29 @@ int QwtPlot::axisMaxMajor(QwtAxisId axisId) const
         return 0;
 }
 
+/**
+ * @brief Return the link group of an axis/返回坐标轴所在的联动组
+ * @param axisId Axis/轴 ID
+ * @return 坐标轴所在的联动组，没有则返回nullptr
+ * @sa QwtPlotAxisLink
+ */
+QwtPlotAxisLink* QwtPlot::axisLink(QwtAxisId axisId) const
+{
+    if (isAxisValid(axisId))
+        return m_scaleData->axisData(axisId).link.data();
+    else
+        return nullptr;
+}
+
+/**
+ * @brief 记录坐标轴所在的联动组，由QwtPlotAxisLink调用
+ */
+void QwtPlot::setAxisLink(QwtAxisId axisId, QwtPlotAxisLink* link)
+{
+    if (isAxisValid(axisId))
+        m_scaleData->axisData(axisId).link = link;
+}
+
 /*!
    \brief Return the maximum number of minor ticks for a specified axis/返回指定轴副刻度的最大数量
    \param axisId Axis/轴 ID
@@ -565,9 +719,22 @@ void QwtPlot::setAxisFont(QwtAxisId axisId, const QFont& font)
  *        ( called by replot() ).
  *
  *       自动缩放标志在执行 updateAxes() 函数（由 replot() 调用）之前不会生效。
+ *
+ * @note For an axis in a QwtPlotAxisLink enabling autoscaling enables the autoscaling
+ *       of the group ( QwtPlotAxisLink::setAutoScale() ).
+ *
+ *       对于联动组中的坐标轴，启用自动缩放会启用整个联动组的自动缩放
  */
 void QwtPlot::setAxisAutoScale(QwtAxisId axisId, bool on)
 {
+    if (on && isAxisValid(axisId)) {
+        // 联动的坐标轴由组统一自动缩放
+        if (QwtPlotAxisLink* link = m_scaleData->axisData(axisId).link.data()) {
+            link->setAutoScale(true);
+            return;
+        }
+    }
+
     if (isAxisValid(axisId) && (m_scaleData->axisData(axisId).doAutoScale != on)) {
         m_scaleData->axisData(axisId).doAutoScale = on;
         autoRefresh();
@@ -769,6 +936,37 @@ void QwtPlot::setAxisTitle(QwtAxisId axisId, const QwtText& title)
         axisWidget(axisId)->setTitle(title);
 }
 
+/*
+   The first call of boundingRect() after the samples have been
+   changed iterates over all samples. For large series items with
+   array based data this is done in parallel, so that the following
+   calls of QwtPlotItem::boundingRect() return the cached rectangles.
+   Used by updateAxes() and rescaleAxes().
+ */
+void QwtPlot::cacheBoundingRects(const QwtPlotItemList& items) const
+{
+#if QWT_USE_THREADS
+    QwtPlotItemList heavyItems;
+    for (int i = 0; i < items.size(); i++) {
+        if (qwtBoundingRectWorkload(items[ i ]) >= qwtParallelBoundingRectSize)
+            heavyItems += items[ i ];
+    }
+
+    if (heavyItems.size() > 1 && QThread::idealThreadCount() > 1) {
+        QList< QFuture< void > > futures;
+        for (int j = 1; j < heavyItems.size(); j++)
+            futures += QtConcurrent::run(&qwtCacheBoundingRect, heavyItems[ j ]);
+
+        qwtCacheBoundingRect(heavyItems[ 0 ]);
+
+        for (int j = 0; j < futures.size(); j++)
+            futures[ j ].waitForFinished();
+    }
+#else
+    Q_UNUSED(items);
+#endif
+}
+
 /**
  * @brief Rebuild the axes scales/重建坐标轴刻度
  *
@@ -803,6 +1001,15 @@ void QwtPlot::setAxisTitle(QwtAxisId axisId, const QwtText& title)
  *
  * updateAxes() 方法通常由 replot() 方法调用。
  *
+ * The bounding rectangles of the data of curves, spectro curves, interval curves,
+ * histograms and trading curves with many samples are calculated in parallel.
+ * This is done only for the array based series data classes of Qwt ( f.e. QwtPointSeriesData,
+ * QwtPointArrayData, QwtCPointerData, QwtSharedPointData ), that don't call any application code.
+ * QwtPlotItem::boundingRect() is always called from the GUI thread.
+ *
+ * 样本数很多的曲线、直方图等内置序列绘图项，若其数据为Qwt内置的基于数组的序列数据类（不调用任何应用代码），
+ * 数据的边界矩形会并行计算；QwtPlotItem::boundingRect()始终在GUI线程调用。
+ *
  * @sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot(),
  *     QwtPlotItem::boundingRect()
  */
@@ -815,25 +1022,26 @@ void QwtPlot::updateAxes()
 
     const QwtPlotItemList& itmList = itemList();
 
-    QwtPlotItemIterator it;
-    for (it = itmList.begin(); it != itmList.end(); ++it) {
-        const QwtPlotItem* item = *it;
+    QwtPlotItemList relevantItems;
+    for (int i = 0; i < itmList.size(); i++) {
+        QwtPlotItem* item = itmList[ i ];
 
-        if (!item->testItemAttribute(QwtPlotItem::AutoScale))
-            continue;
+        if (item->testItemAttribute(QwtPlotItem::AutoScale) && item->isVisible()
+            && (axisAutoScale(item->xAxis()) || axisAutoScale(item->yAxis())))
+            relevantItems += item;
+    }
 
-        if (!item->isVisible())
-            continue;
+    cacheBoundingRects(relevantItems);
 
-        if (axisAutoScale(item->xAxis()) || axisAutoScale(item->yAxis())) {
-            const QRectF rect = item->boundingRect();
+    for (int i = 0; i < relevantItems.size(); i++) {
+        const QwtPlotItem* item = relevantItems[ i ];
+        const QRectF rect       = item->boundingRect();
 
-            if (rect.width() >= 0.0)
-                boundingIntervals[ item->xAxis() ] |= QwtInterval(rect.left(), rect.right());
+        if (rect.width() >= 0.0)
+            boundingIntervals[ item->xAxis() ] |= QwtInterval(rect.left(), rect.right());
 
-            if (rect.height() >= 0.0)
-                boundingIntervals[ item->yAxis() ] |= QwtInterval(rect.top(), rect.bottom());
-        }
+        if (rect.height() >= 0.0)
+            boundingIntervals[ item->yAxis() ] |= QwtInterval(rect.top(), rect.bottom());
     }
 
     // Adjust scales
@@ -863,6 +1071,13 @@ void QwtPlot::updateAxes()
                 d.isValid  = true;
             }
 
+            // 联动的坐标轴直接使用组按所有成员计算的刻度，避免先按自身范围绘制一次
+            if (d.link && d.link->autoScale()) {
+                QwtScaleDiv linkDiv;
+                if (d.link->syncScaleDiv(linkDiv))
+                    d.scaleDiv = linkDiv;
+            }
+
             QwtScaleWidget* scaleWidget = axisWidget(axisId);
             scaleWidget->setScaleDiv(d.scaleDiv);
 
@@ -872,6 +1087,7 @@ void QwtPlot::updateAxes()
         }
     }
 
+    QwtPlotItemIterator it;
     for (it = itmList.begin(); it != itmList.end(); ++it) {
         QwtPlotItem* item = *it;
         if (item->testItemInterest(QwtPlotItem::ScaleInterest)) {
@@ -0,0 +1,443 @@
+﻿#include "qwt_plot_axis_link.h"
+// Qt
+#include <QPointer>
+#include <QTimer>
+// qwt
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_widget.h"
+#include "qwt_scale_engine.h"
+#include "qwt_interval.h"
+
+class QwtPlotAxisLink::PrivateData
+{
+    QWT_DECLARE_PUBLIC(QwtPlotAxisLink)
+public:
+    PrivateData(QwtPlotAxisLink* p);
+    struct Member
+    {
+        QPointer< QwtPlot > plot;
+        QwtAxisId axisId { QwtAxis::XBottom };
+    };
+    int indexOf(const QwtPlot* plot) const;
+    // 合并所有成员的item范围，返回自动缩放的区间
+    QwtInterval boundingInterval() const;
+    // 按所有成员的范围重新计算scaleDiv，改变了返回true
+    bool updateAutoScaleDiv();
+    // 把scaleDiv同步到所有成员，只重绘刻度改变的绘图
+    void apply();
+
+public:
+    QList< Member > members;
+    QwtScaleDiv scaleDiv;
+    bool isScaleDivValid { false };  ///< scaleDiv是否已经计算或设置过
+    bool autoScale { true };
+    bool applying { false };
+    QTimer* replotTimer { nullptr };
+};
+
+QwtPlotAxisLink::PrivateData::PrivateData(QwtPlotAxisLink* p) : q_ptr(p)
+{
+}
+
+int QwtPlotAxisLink::PrivateData::indexOf(const QwtPlot* plot) const
+{
+    for (int i = 0; i < members.size(); ++i) {
+        if (members[ i ].plot.data() == plot) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QwtInterval QwtPlotAxisLink::PrivateData::boundingInterval() const
+{
+    QwtInterval interval;
+    for (const Member& m : members) {
+        if (!m.plot) {
+            continue;
+        }
+        const bool isXAxis           = QwtAxis::isXAxis(m.axisId);
+        const QwtPlotItemList& items = m.plot->itemList();
+        for (const QwtPlotItem* item : items) {
+            if (!item->testItemAttribute(QwtPlotItem::AutoScale) || !item->isVisible()) {
+                continue;
+            }
+            if ((isXAxis ? item->xAxis() : item->yAxis()) != m.axisId) {
+                continue;
+            }
+            const QRectF rect = item->boundingRect();
+            if (isXAxis) {
+                if (rect.width() >= 0.0) {
+                    interval |= QwtInterval(rect.left(), rect.right());
+                }
+            } else {
+                if (rect.height() >= 0.0) {
+                    interval |= QwtInterval(rect.top(), rect.bottom());
+                }
+            }
+        }
+    }
+    return interval;
+}
+
+bool QwtPlotAxisLink::PrivateData::updateAutoScaleDiv()
+{
+    const QwtInterval interval = boundingInterval();
+    if (members.isEmpty() || !interval.isValid()) {
+        return false;
+    }
+
+    const Member& m = members.first();
+    if (!m.plot) {
+        return false;
+    }
+
+    const QwtScaleEngine* engine = m.plot->axisScaleEngine(m.axisId);
+    const int maxMajor           = m.plot->axisMaxMajor(m.axisId);
+
+    double minValue = interval.minValue();
+    double maxValue = interval.maxValue();
+    double stepSize = 0.0;
+    engine->autoScale(maxMajor, minValue, maxValue, stepSize);
+
+    const QwtScaleDiv div = engine->divideScale(minValue, maxValue, maxMajor, m.plot->axisMaxMinor(m.axisId), stepSize);
+    if (isScaleDivValid && scaleDiv.fuzzyCompare(div)) {
+        return false;
+    }
+
+    scaleDiv        = div;
+    isScaleDivValid = true;
+    return true;
+}
+
+void QwtPlotAxisLink::PrivateData::apply()
+{
+    if (!isScaleDivValid) {
+        return;
+    }
+    applying = true;
+    for (const Member& m : qAsConst(members)) {
+        QwtPlot* plot = m.plot.data();
+        if (!plot || plot->axisScaleDiv(m.axisId).fuzzyCompare(scaleDiv)) {
+            continue;
+        }
+        // setAxisScaleDiv会在autoReplot时自行重绘
+        plot->setAxisScaleDiv(m.axisId, scaleDiv);
+        if (!plot->autoReplot()) {
+            plot->replot();
+        }
+    }
+    applying = false;
+}
+
+//----------------------------------------------------
+// QwtPlotAxisLink
+//----------------------------------------------------
+
+/**
+ * @brief 构造函数
+ * @param par 父对象
+ */
+QwtPlotAxisLink::QwtPlotAxisLink(QObject* par) : QObject(par), QWT_PIMPL_CONSTRUCT
+{
+    m_data->replotTimer = new QTimer(this);
+    m_data->replotTimer->setSingleShot(true);
+    m_data->replotTimer->setInterval(0);
+    connect(m_data->replotTimer, &QTimer::timeout, this, &QwtPlotAxisLink::updateAxes);
+}
+
+/**
+ * @brief 析构函数，恢复自动缩放的成员坐标轴
+ */
+QwtPlotAxisLink::~QwtPlotAxisLink()
+{
+    QWT_D(d);
+    for (const PrivateData::Member& m : qAsConst(d->members)) {
+        if (m.plot && m.plot->axisLink(m.axisId) == this) {
+            m.plot->setAxisLink(m.axisId, nullptr);
+            if (d->autoScale) {
+                m.plot->setAxisAutoScale(m.axisId, true);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Add an axis of a plot to the group/添加绘图的坐标轴到组中
+ *
+ * The axis gives up its own autoscaling, its scale is controlled by the group from now on.
+ * A plot can only be member of the group with one axis and an axis can only be member of one group.
+ *
+ * 坐标轴会放弃自身的自动缩放，此后由组控制其刻度。一个绘图只能有一个坐标轴在组中，一个坐标轴也只能属于一个组
+ *
+ * @param plot 绘图
+ * @param axisId 坐标轴
+ * @return 成功添加返回true
+ */
+bool QwtPlotAxisLink::addPlot(QwtPlot* plot, QwtAxisId axisId)
+{
+    QWT_D(d);
+    if (!plot || !plot->isAxisValid(axisId) || d->indexOf(plot) >= 0) {
+        return false;
+    }
+    QwtPlotAxisLink* other = plot->axisLink(axisId);
+    if (other && other != this) {
+        other->removePlot(plot);
+    }
+
+    PrivateData::Member m;
+    m.plot   = plot;
+    m.axisId = axisId;
+    if (d->members.isEmpty() && !d->autoScale) {
+        d->scaleDiv        = plot->axisScaleDiv(axisId);
+        d->isScaleDivValid = true;
+    }
+    d->members.append(m);
+
+    plot->setAxisLink(axisId, this);
+    plot->setAxisAutoScale(axisId, false);
+    connect(plot->axisWidget(axisId), &QwtScaleWidget::scaleDivChanged, this, &QwtPlotAxisLink::onMemberScaleDivChanged);
+    connect(plot, &QObject::destroyed, this, &QwtPlotAxisLink::onMemberDestroyed);
+
+    replot();
+    return true;
+}
+
+/**
+ * @brief Remove a plot from the group/从组中移除绘图
+ *
+ * If the group is autoscaling, the autoscaling of the axis is restored.
+ *
+ * 如果组是自动缩放的，会恢复坐标轴的自动缩放
+ * @param plot 绘图
+ * @return 成功移除返回true
+ */
+bool QwtPlotAxisLink::removePlot(QwtPlot* plot)
+{
+    QWT_D(d);
+    const int index = d->indexOf(plot);
+    if (index < 0) {
+        return false;
+    }
+    const QwtAxisId axisId = d->members[ index ].axisId;
+    d->members.removeAt(index);
+
+    disconnect(plot->axisWidget(axisId), &QwtScaleWidget::scaleDivChanged, this, &QwtPlotAxisLink::onMemberScaleDivChanged);
+    disconnect(plot, &QObject::destroyed, this, &QwtPlotAxisLink::onMemberDestroyed);
+    plot->setAxisLink(axisId, nullptr);
+    if (d->autoScale) {
+        plot->setAxisAutoScale(axisId, true);
+    }
+    return true;
+}
+
+/**
+ * @brief 组中的绘图
+ * @return
+ */
+QList< QwtPlot* > QwtPlotAxisLink::plots() const
+{
+    QList< QwtPlot* > res;
+    for (const PrivateData::Member& m : qAsConst(m_data->members)) {
+        if (m.plot) {
+            res.append(m.plot.data());
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief 绘图在组中的坐标轴
+ * @param plot 绘图
+ * @return 如果绘图不在组中，返回-1
+ */
+QwtAxisId QwtPlotAxisLink::axisId(const QwtPlot* plot) const
+{
+    const int index = m_data->indexOf(plot);
+    return (index < 0) ? -1 : m_data->members[ index ].axisId;
+}
+
+/**
+ * @brief 判断绘图是否在组中
+ * @param plot
+ * @return
+ */
+bool QwtPlotAxisLink::contains(const QwtPlot* plot) const
+{
+    return m_data->indexOf(plot) >= 0;
+}
+
+/**
+ * @brief Enable or disable autoscaling of the group/设置组的自动缩放
+ *
+ * When enabled, the union of the bounding rectangles of the items of all members
+ * is used to calculate the scale division. Autoscaling is disabled, when the scale
+ * of a member is changed directly, f.e. by a zoomer, and has to be enabled here again.
+ *
+ * 启用时，使用所有成员item范围的并集计算刻度划分。直接修改成员的刻度（例如缩放）会关闭自动缩放，需要在此重新启用
+ * @param on
+ */
+void QwtPlotAxisLink::setAutoScale(bool on)
+{
+    if (m_data->autoScale == on) {
+        return;
+    }
+    m_data->autoScale = on;
+    if (on) {
+        replot();
+    }
+}
+
+/**
+ * @brief 组是否自动缩放
+ * @return
+ */
+bool QwtPlotAxisLink::autoScale() const
+{
+    return m_data->autoScale;
+}
+
+/**
+ * @brief Set a fixed interval for all members/为所有成员设置固定范围
+ *
+ * The scale division is calculated once by the scale engine of the first member.
+ * Autoscaling is disabled.
+ *
+ * 刻度划分只用第一个成员的刻度引擎计算一次，此操作会关闭自动缩放
+ * @param min 最小值
+ * @param max 最大值
+ * @param stepSize 步长，为0时由刻度引擎计算
+ */
+void QwtPlotAxisLink::setInterval(double min, double max, double stepSize)
+{
+    QWT_D(d);
+    d->autoScale = false;
+
+    QwtScaleDiv div(min, max);
+    if (!d->members.isEmpty() && d->members.first().plot) {
+        const PrivateData::Member& m = d->members.first();
+        const QwtScaleEngine* engine = m.plot->axisScaleEngine(m.axisId);
+        div = engine->divideScale(min, max, m.plot->axisMaxMajor(m.axisId), m.plot->axisMaxMinor(m.axisId), stepSize);
+    }
+    if (d->isScaleDivValid && d->scaleDiv.fuzzyCompare(div)) {
+        return;
+    }
+    d->scaleDiv        = div;
+    d->isScaleDivValid = true;
+    d->apply();
+    Q_EMIT scaleDivChanged(d->scaleDiv);
+}
+
+/**
+ * @brief 组当前的刻度划分
+ * @return
+ */
+QwtScaleDiv QwtPlotAxisLink::scaleDiv() const
+{
+    return m_data->scaleDiv;
+}
+
+/**
+ * @brief Calculate the scale division and propagate it to all members/立即计算并同步刻度
+ *
+ * When autoscaling, the bounding interval of all members is united and the scale division
+ * is calculated once by the scale engine of the first member. Only the members
+ * whose scale division changed are replotted.
+ *
+ * 自动缩放时，合并所有成员的范围，用第一个成员的刻度引擎计算一次刻度划分。只有刻度改变了的成员才会重绘
+ *
+ * @sa replot
+ */
+void QwtPlotAxisLink::updateAxes()
+{
+    QWT_D(d);
+    d->replotTimer->stop();
+    if (d->members.isEmpty()) {
+        return;
+    }
+
+    const bool changed = d->autoScale && d->updateAutoScaleDiv();
+    d->apply();
+    if (changed) {
+        Q_EMIT scaleDivChanged(d->scaleDiv);
+    }
+}
+
+/**
+ * @brief Request an update of the group/请求一次合并的更新和重绘
+ *
+ * All requests within one event loop cycle are coalesced into a single updateAxes().
+ * Requests triggered by the group itself while propagating the scale are ignored.
+ *
+ * 同一个事件循环内的所有请求会合并为一次updateAxes()，组自身同步刻度时触发的请求会被忽略
+ */
+void QwtPlotAxisLink::replot()
+{
+    if (!m_data->applying) {
+        m_data->replotTimer->start();
+    }
+}
+
+/**
+ * @brief Scale division for a member being updated/成员更新坐标轴时同步获取组的刻度
+ *
+ * Called by QwtPlot::updateAxes() of an autoscaling group. The scale division is calculated
+ * synchronously from the items of all members, so that the member is painted with the final
+ * scale at once. When the scale division has changed, the other members are updated
+ * by the next coalesced updateAxes().
+ *
+ * 由自动缩放组成员的QwtPlot::updateAxes()调用，同步按所有成员的item计算刻度划分，使该成员直接按最终刻度绘制。
+ * 刻度改变时，其它成员在下一次合并的updateAxes()中更新
+ *
+ * @param div 组的刻度划分
+ * @return 组还没有有效的刻度划分时返回false
+ */
+bool QwtPlotAxisLink::syncScaleDiv(QwtScaleDiv& div)
+{
+    QWT_D(d);
+    if (d->autoScale && !d->applying && d->updateAutoScaleDiv()) {
+        replot();
+        Q_EMIT scaleDivChanged(d->scaleDiv);
+    }
+
+    if (!d->isScaleDivValid) {
+        return false;
+    }
+    div = d->scaleDiv;
+    return true;
+}
+
+void QwtPlotAxisLink::onMemberScaleDivChanged()
+{
+    QWT_D(d);
+    if (d->applying) {
+        return;
+    }
+    QwtScaleWidget* w = qobject_cast< QwtScaleWidget* >(sender());
+    for (const PrivateData::Member& m : qAsConst(d->members)) {
+        if (m.plot && m.plot->axisWidget(m.axisId) == w) {
+            // 成员的刻度被外部修改（例如平移缩放），组采用此刻度
+            const QwtScaleDiv& div = m.plot->axisScaleDiv(m.axisId);
+            if (d->isScaleDivValid && d->scaleDiv.fuzzyCompare(div)) {
+                return;
+            }
+            d->autoScale       = false;
+            d->scaleDiv        = div;
+            d->isScaleDivValid = true;
+            d->replotTimer->start();
+            Q_EMIT scaleDivChanged(d->scaleDiv);
+            return;
+        }
+    }
+}
+
+void QwtPlotAxisLink::onMemberDestroyed(QObject* obj)
+{
+    QWT_D(d);
+    for (int i = d->members.size() - 1; i >= 0; --i) {
+        if (d->members[ i ].plot.isNull() || static_cast< QObject* >(d->members[ i ].plot.data()) == obj) {
+            d->members.removeAt(i);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+﻿#ifndef QWT_PLOT_AXIS_LINK_H
+#define QWT_PLOT_AXIS_LINK_H
+// Qt
+#include <QObject>
+#include <QList>
+// qwt
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+#include "qwt_scale_div.h"
+class QwtPlot;
+
+/**
+ * @brief A group of plot axes sharing one scale
+ * @brief 共享同一刻度的一组坐标轴
+ *
+ * All axes of the group show the same QwtScaleDiv. When autoscaling is enabled,
+ * the bounding interval of the items of all plots is united once, a single scale division
+ * is calculated with the scale engine of the first plot and propagated to every member.
+ * Changes of the group are coalesced, so that any number of requests within one event loop
+ * cycle results in one pass and one replot of the plots whose scale really changed.
+ *
+ * 组内的所有坐标轴显示相同的QwtScaleDiv。启用自动缩放时，所有绘图的item范围只合并一次，
+ * 使用第一个绘图的刻度引擎计算一次刻度划分，再同步到所有成员。
+ * 组的变更会被合并，同一个事件循环内的多次请求只会执行一次计算，并且只重绘刻度真正改变的绘图
+ *
+ * A member being replotted takes the scale division of the group, that is updated synchronously
+ * from the items of all members. So it is painted once with the final scale, and only the other
+ * members, whose scale changed, are replotted later.
+ *
+ * 成员重绘时直接使用组按所有成员的item同步计算的刻度划分，因此只按最终的刻度绘制一次，
+ * 之后只重绘刻度改变了的其它成员
+ *
+ * If the scale of a member is changed directly (e.g. by a panner or zoomer), the group adopts
+ * this scale division, disables autoscaling and propagates it to the other members.
+ * Autoscaling stays disabled until it is enabled again by setAutoScale() or
+ * QwtPlot::setAxisAutoScale() of a member.
+ *
+ * 如果直接改变了某个成员的刻度（例如通过平移或缩放），组会采用此刻度划分，关闭自动缩放，并同步到其它成员。
+ * 自动缩放保持关闭，直到通过setAutoScale()或成员的QwtPlot::setAxisAutoScale()重新启用
+ *
+ * @code
+ * QwtPlotAxisLink* link = new QwtPlotAxisLink(figure);
+ * for (QwtPlot* plot : plots) {
+ *     link->addPlot(plot, QwtAxis::XBottom);
+ * }
+ * @endcode
+ *
+ * @sa QwtFigure::linkAxes, QwtPlot::axisLink
+ */
+class QWT_EXPORT QwtPlotAxisLink : public QObject
+{
+    Q_OBJECT
+    QWT_DECLARE_PRIVATE(QwtPlotAxisLink)
+public:
+    explicit QwtPlotAxisLink(QObject* par = nullptr);
+    ~QwtPlotAxisLink();
+
+    // 添加绘图的坐标轴到组中，一个绘图只能有一个坐标轴在组中
+    bool addPlot(QwtPlot* plot, QwtAxisId axisId);
+    // 从组中移除绘图
+    bool removePlot(QwtPlot* plot);
+    // 组中的绘图
+    QList< QwtPlot* > plots() const;
+    // 绘图在组中的坐标轴，如果绘图不在组中，返回-1
+    QwtAxisId axisId(const QwtPlot* plot) const;
+    // 判断绘图是否在组中
+    bool contains(const QwtPlot* plot) const;
+
+    // 自动缩放
+    void setAutoScale(bool on = true);
+    bool autoScale() const;
+    // 设置固定范围，此操作会关闭自动缩放
+    void setInterval(double min, double max, double stepSize = 0.0);
+    // 组当前的刻度划分
+    QwtScaleDiv scaleDiv() const;
+
+    // 立即计算并同步刻度
+    void updateAxes();
+
+public Q_SLOTS:
+    // 请求一次合并的更新和重绘
+    void replot();
+
+Q_SIGNALS:
+    /**
+     * @brief 组的刻度划分发生了改变
+     * @param div 新的刻度划分
+     */
+    void scaleDivChanged(const QwtScaleDiv& div);
+
+private:
+    friend class QwtPlot;
+    // 成员在updateAxes中同步获取组的刻度
+    bool syncScaleDiv(QwtScaleDiv& div);
+
+private Q_SLOTS:
+    void onMemberScaleDivChanged();
+    void onMemberDestroyed(QObject* obj);
+};
+
+#endif  // QWT_PLOT_AXIS_LINK_H
@@ -27,6 +27,8 @@
 #include "qwt_plot_canvas.h"
 #include "qwt_painter.h"
 #include "qwt_plot.h"
+#include "qwt_plot_transparent_canvas.h"
+#include "qwt_render_stats.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
@@ -183,7 +185,12 @@ void QwtPlotCanvas::paintEvent(QPaintEvent* event)
 
     if (testPaintAttribute(QwtPlotCanvas::BackingStore) && m_data->backingStore != NULL) {
         QPixmap& bs = *m_data->backingStore;
-        if (bs.size() != size() * QwtPainter::devicePixelRatio(&bs)) {
+
+        const bool isValid = (bs.size() == size() * QwtPainter::devicePixelRatio(&bs));
+        if (plot() && plot()->renderStats())
+            plot()->renderStats()->addCacheAccess(QwtRenderStats::CanvasCache, isValid);
+
+        if (!isValid) {
             bs = QwtPainter::backingStore(this, size());
             // 先初始化为完全透明
             bs.fill(Qt::transparent);
@@ -243,6 +250,9 @@ void QwtPlotCanvas::paintEvent(QPaintEvent* event)
         }
     }
 
+    // 寄生绘图的画布由宿主画布合成
+    QwtPlotTransparentCanvas::compositeParasites(&painter, plot());
+
     if (hasFocus() && focusIndicator() == CanvasFocusIndicator)
         drawFocusIndicator(&painter);
 }
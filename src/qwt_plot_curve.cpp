@@ -26,6 +26,7 @@
 
 #include "qwt_plot_curve.h"
 #include "qwt_point_data.h"
+#include "qwt_shared_point_data.h"
 #include "qwt_math.h"
 #include "qwt_clipper.h"
 #include "qwt_painter.h"
@@ -36,9 +37,12 @@
 #include "qwt_point_mapper.h"
 #include "qwt_text.h"
 #include "qwt_graphic.h"
+#include "qwt_color_map.h"
+#include "qwt_symbol_renderer.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qpaintengine.h>
 
 static inline QRectF qwtIntersectedClipRect(const QRectF& rect, QPainter* painter)
 {
@@ -49,6 +53,72 @@ static inline QRectF qwtIntersectedClipRect(const QRectF& rect, QPainter* painte
     return clipRect;
 }
 
+static inline void qwtDrawClippedPolyline(QPainter* painter, const QRectF& clipRect, const QPolygonF& polyline)
+{
+    // only the visible runs of the polyline are passed to the painter
+    const QVector< QPolygonF > runs = QwtClipper::clippedPolylinesF(clipRect, polyline);
+    for (int i = 0; i < runs.size(); i++)
+        QwtPainter::drawPolyline(painter, runs[ i ]);
+}
+
+static inline bool qwtCanRasterizeLines(const QPainter* painter)
+{
+    // an image would be a bitmap in vector formats and printouts
+    const QPaintEngine* engine = painter->paintEngine();
+    if (engine == NULL || engine->type() != QPaintEngine::Raster)
+        return false;
+
+    // QwtPointMapper::toLineImage rasterizes thin solid lines in device pixels only
+    const QPen pen = painter->pen();
+    if (pen.style() != Qt::SolidLine || pen.brush().style() != Qt::SolidPattern)
+        return false;
+
+    if (pen.widthF() > 1.0 || pen.color().alpha() == 0)
+        return false;
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
+namespace
+{
+// first sample with value <= x
+class QwtSortedXLessEqual
+{
+public:
+    inline bool operator()(const double value, const QPointF& sample) const
+    {
+        return value <= sample.x();
+    }
+};
+
+// first sample with value < x
+class QwtSortedXLess
+{
+public:
+    inline bool operator()(const double value, const QPointF& sample) const
+    {
+        return value < sample.x();
+    }
+};
+}
+
+/*
+   Limit [from, to] to the samples inside [xMin, xMax] of a series
+   sorted by x, including the nearest sample on each side
+ */
+static void qwtLimitSortedXRange(const QwtSeriesData< QPointF >& series, double xMin, double xMax, int& from, int& to)
+{
+    const size_t lower = qwtUpperSampleIndex< QPointF >(series, xMin, QwtSortedXLessEqual());
+    const size_t upper = qwtUpperSampleIndex< QPointF >(series, xMax, QwtSortedXLess());
+
+    // the indices are <= size(), what fits into an int as the range does
+    const int first = (lower > 0) ? int(lower) - 1 : 0;
+    const int last  = int(upper);
+
+    from = qMax(from, first);
+    to   = qMin(to, last);
+}
+
 static void qwtUpdateLegendIconSize(QwtPlotCurve* curve)
 {
     if (curve->symbol() && curve->testLegendAttribute(QwtPlotCurve::LegendShowSymbol)) {
@@ -78,6 +148,9 @@ public:
         , symbol(NULL)
         , pen(Qt::black)
         , paintAttributes(QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints)
+        , densityColorMap(NULL)
+        , densityScaling(QwtPointMapper::LogarithmicDensity)
+        , symbolRenderer(NULL)
     {
         curveFitter = new QwtSplineCurveFitter;
     }
@@ -86,6 +159,8 @@ public:
     {
         delete symbol;
         delete curveFitter;
+        delete densityColorMap;
+        delete symbolRenderer;
     }
 
     QwtPlotCurve::CurveStyle style;
@@ -101,6 +176,13 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    QwtColorMap* densityColorMap;
+    QwtPointMapper::DensityScaling densityScaling;
+
+    QwtSymbolRenderer* symbolRenderer;
+    QVector< double > symbolColorValues;
+    QVector< double > symbolSizeValues;
 };
 
 /*!
@@ -280,6 +362,80 @@ const QwtSymbol* QwtPlotCurve::symbol() const
     return m_data->symbol;
 }
 
+/*!
+   \brief Assign a renderer for symbols with a per sample color and size
+
+   When a renderer with a valid symbol is assigned it is used instead
+   of symbol(). The values for the color and size channels are taken from
+   symbolColorValues() and symbolSizeValues(), where the value at index i
+   belongs to the sample at index i.
+
+   The curve takes the ownership of the renderer.
+
+   \param renderer Symbol renderer
+   \sa symbolRenderer(), setSymbolColorValues(), setSymbolSizeValues()
+ */
+void QwtPlotCurve::setSymbolRenderer(QwtSymbolRenderer* renderer)
+{
+    if (renderer != m_data->symbolRenderer) {
+        delete m_data->symbolRenderer;
+        m_data->symbolRenderer = renderer;
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return Renderer for symbols with a per sample color and size
+   \sa setSymbolRenderer()
+ */
+QwtSymbolRenderer* QwtPlotCurve::symbolRenderer() const
+{
+    return m_data->symbolRenderer;
+}
+
+/*!
+   Assign the values for the color channel of the symbol renderer
+
+   \param values Color values, one for each sample
+   \sa symbolColorValues(), setSymbolRenderer(), QwtSymbolRenderer::setColorInterval()
+ */
+void QwtPlotCurve::setSymbolColorValues(const QVector< double >& values)
+{
+    m_data->symbolColorValues = values;
+    itemChanged();
+}
+
+/*!
+   \return Values for the color channel of the symbol renderer
+   \sa setSymbolColorValues()
+ */
+QVector< double > QwtPlotCurve::symbolColorValues() const
+{
+    return m_data->symbolColorValues;
+}
+
+/*!
+   Assign the values for the size channel of the symbol renderer
+
+   \param values Size values, one for each sample
+   \sa symbolSizeValues(), setSymbolRenderer(), QwtSymbolRenderer::setSizeInterval()
+ */
+void QwtPlotCurve::setSymbolSizeValues(const QVector< double >& values)
+{
+    m_data->symbolSizeValues = values;
+    itemChanged();
+}
+
+/*!
+   \return Values for the size channel of the symbol renderer
+   \sa setSymbolSizeValues()
+ */
+QVector< double > QwtPlotCurve::symbolSizeValues() const
+{
+    return m_data->symbolSizeValues;
+}
+
 /*!
    Build and assign a pen
 
@@ -385,6 +541,38 @@ void QwtPlotCurve::drawSeries(QPainter* painter,
     if (to < 0)
         to = numSamples - 1;
 
+    if ((m_data->paintAttributes & SortedX) && !(m_data->attributes & Fitted)) {
+        const bool hasBrush = (m_data->brush.style() != Qt::NoBrush);
+        if (orientation() == Qt::Vertical || (m_data->style != Sticks && !hasBrush)) {
+            const QRectF rect = qwtIntersectedClipRect(canvasRect, painter);
+
+            // lines and symbols might be partly visible, even when the position is outside
+            double margin = QwtPainter::effectivePenWidth(m_data->pen) + 1.0;
+
+            const QwtSymbol* symbol = NULL;
+            if (m_data->symbolRenderer && m_data->symbolRenderer->symbol()) {
+                symbol = m_data->symbolRenderer->symbol();
+                margin += m_data->symbolRenderer->maxSymbolExtent();
+            } else if (m_data->symbol && (m_data->symbol->style() != QwtSymbol::NoSymbol)) {
+                symbol = m_data->symbol;
+            }
+
+            if (symbol) {
+                const QRect br = symbol->boundingRect();
+                margin += qMax(br.width(), br.height());
+            }
+
+            double x1 = xMap.invTransform(rect.left() - margin);
+            double x2 = xMap.invTransform(rect.right() + margin);
+            if (x1 > x2)
+                qSwap(x1, x2);
+
+            qwtLimitSortedXRange(*data(), x1, x2, from, to);
+            if (from > to)
+                return;
+        }
+    }
+
     if (qwtVerifyRange(numSamples, from, to) > 0) {
         painter->save();
         painter->setPen(m_data->pen);
@@ -398,7 +586,11 @@ void QwtPlotCurve::drawSeries(QPainter* painter,
         drawCurve(painter, m_data->style, xMap, yMap, canvasRect, from, to);
         painter->restore();
 
-        if (m_data->symbol && (m_data->symbol->style() != QwtSymbol::NoSymbol)) {
+        if (m_data->symbolRenderer && m_data->symbolRenderer->symbol()) {
+            painter->save();
+            drawBatchedSymbols(painter, *m_data->symbolRenderer, xMap, yMap, canvasRect, from, to);
+            painter->restore();
+        } else if (m_data->symbol && (m_data->symbol->style() != QwtSymbol::NoSymbol)) {
             painter->save();
             drawSymbols(painter, *m_data->symbol, xMap, yMap, canvasRect, from, to);
             painter->restore();
@@ -500,6 +692,25 @@ void QwtPlotCurve::drawLines(QPainter* painter,
 
     mapper.setBoundingRect(canvasRect);
 
+    if ((m_data->paintAttributes & LineImageBuffer) && !doFit && qwtCanRasterizeLines(painter)) {
+        if (doFill) {
+            QPolygonF filled = mapper.toPolygonF(xMap, yMap, data(), from, to);
+            fillCurve(painter, xMap, yMap, canvasRect, filled);
+        }
+
+        const QImage image = mapper.toLineImage(xMap,
+                                                yMap,
+                                                data(),
+                                                from,
+                                                to,
+                                                painter->pen(),
+                                                painter->testRenderHint(QPainter::Antialiasing),
+                                                renderThreadCount());
+
+        painter->drawImage(canvasRect.toAlignedRect(), image);
+        return;
+    }
+
     QPolygonF polyline = mapper.toPolygonF(xMap, yMap, data(), from, to);
 
     if (doFill) {
@@ -520,18 +731,20 @@ void QwtPlotCurve::drawLines(QPainter* painter,
             filled.clear();
 
             if (m_data->paintAttributes & ClipPolygons)
-                QwtClipper::clipPolygonF(clipRect, polyline, false);
-
-            QwtPainter::drawPolyline(painter, polyline);
+                qwtDrawClippedPolyline(painter, clipRect, polyline);
+            else
+                QwtPainter::drawPolyline(painter, polyline);
         } else {
             fillCurve(painter, xMap, yMap, canvasRect, polyline);
         }
     } else {
-        if (testPaintAttribute(ClipPolygons)) {
-            QwtClipper::clipPolygonF(clipRect, polyline, false);
-        }
-
         if (doFit) {
+            // the fitter needs the complete polyline, including
+            // the points along the border of the clip rectangle
+            if (testPaintAttribute(ClipPolygons)) {
+                QwtClipper::clipPolygonF(clipRect, polyline, false);
+            }
+
             if (m_data->curveFitter->mode() == QwtCurveFitter::Path) {
                 const QPainterPath curvePath = m_data->curveFitter->fitCurvePath(polyline);
 
@@ -541,7 +754,10 @@ void QwtPlotCurve::drawLines(QPainter* painter,
                 QwtPainter::drawPolyline(painter, polyline);
             }
         } else {
-            QwtPainter::drawPolyline(painter, polyline);
+            if (testPaintAttribute(ClipPolygons))
+                qwtDrawClippedPolyline(painter, clipRect, polyline);
+            else
+                QwtPainter::drawPolyline(painter, polyline);
         }
     }
 }
@@ -646,6 +862,19 @@ void QwtPlotCurve::drawDots(QPainter* painter,
 
         QwtPainter::drawPoints(painter, points);
         fillCurve(painter, xMap, yMap, canvasRect, points);
+    } else if (m_data->paintAttributes & DensityBuffer) {
+        QImage image;
+        if (m_data->densityColorMap) {
+            image = mapper.toDensityImage(
+                xMap, yMap, data(), from, to, *m_data->densityColorMap, m_data->densityScaling, renderThreadCount());
+        } else {
+            // without a color map the density is indicated by the opacity of the pen color
+            QwtAlphaColorMap colorMap(color);
+            colorMap.setAlphaInterval(32, 255);
+            image = mapper.toDensityImage(xMap, yMap, data(), from, to, colorMap, m_data->densityScaling, renderThreadCount());
+        }
+
+        painter->drawImage(canvasRect.toAlignedRect(), image);
     } else if (m_data->paintAttributes & ImageBuffer) {
         const QImage image = mapper.toImage(xMap,
                                             yMap,
@@ -829,6 +1058,61 @@ QwtCurveFitter* QwtPlotCurve::curveFitter() const
     return m_data->curveFitter;
 }
 
+/*!
+   Assign the color map for the DensityBuffer paint attribute
+
+   The counts of points per pixel are normalized to [0.0, 1.0]
+   and mapped into colors by the color map. The curve takes
+   the ownership of the color map. When no color map is assigned
+   the opacity of the pen color is varied.
+
+   \param colorMap Color map
+   \sa densityColorMap(), setDensityScaling(), DensityBuffer
+ */
+void QwtPlotCurve::setDensityColorMap(QwtColorMap* colorMap)
+{
+    if (colorMap != m_data->densityColorMap) {
+        delete m_data->densityColorMap;
+        m_data->densityColorMap = colorMap;
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return Color map for the DensityBuffer paint attribute
+   \sa setDensityColorMap()
+ */
+const QwtColorMap* QwtPlotCurve::densityColorMap() const
+{
+    return m_data->densityColorMap;
+}
+
+/*!
+   Set the scaling of the counts for the DensityBuffer paint attribute
+
+   The default setting is QwtPointMapper::LogarithmicDensity.
+
+   \param scaling Linear or logarithmic scaling
+   \sa densityScaling(), setDensityColorMap(), DensityBuffer
+ */
+void QwtPlotCurve::setDensityScaling(QwtPointMapper::DensityScaling scaling)
+{
+    if (scaling != m_data->densityScaling) {
+        m_data->densityScaling = scaling;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Scaling of the counts for the DensityBuffer paint attribute
+   \sa setDensityScaling()
+ */
+QwtPointMapper::DensityScaling QwtPlotCurve::densityScaling() const
+{
+    return m_data->densityScaling;
+}
+
 /*!
    Fill the area between the curve and the baseline with
    the curve brush
@@ -954,6 +1238,82 @@ void QwtPlotCurve::drawSymbols(QPainter* painter,
     }
 }
 
+/*!
+   Draw symbols with a per sample color and size
+
+   The symbols are composited into an image by the renderer,
+   that is painted to the canvas in one operation.
+
+   \param painter Painter
+   \param renderer Symbol renderer
+   \param xMap x map
+   \param yMap y map
+   \param canvasRect Contents rectangle of the canvas
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+
+   \sa setSymbolRenderer(), drawSeries(), drawSymbols()
+ */
+void QwtPlotCurve::drawBatchedSymbols(QPainter* painter,
+                                      const QwtSymbolRenderer& renderer,
+                                      const QwtScaleMap& xMap,
+                                      const QwtScaleMap& yMap,
+                                      const QRectF& canvasRect,
+                                      int from,
+                                      int to) const
+{
+    const QRect rect = qwtIntersectedClipRect(canvasRect, painter).toAlignedRect();
+    if (rect.isEmpty() || from > to)
+        return;
+
+    const int numPoints                    = to - from + 1;
+    const QwtSeriesData< QPointF >* series = data();
+
+    // the symbol might be partly visible, even when its position is outside
+    const QRect br       = renderer.symbol()->boundingRect();
+    const int margin     = qMax(renderer.maxSymbolExtent(), qMax(br.width(), br.height()));
+    const QRectF visible = QRectF(rect).adjusted(-margin, -margin, margin, margin);
+
+    const bool hasColors = m_data->symbolColorValues.size() >= to + 1;
+    const bool hasSizes  = m_data->symbolSizeValues.size() >= to + 1;
+
+    QVector< QPointF > points;
+    QVector< double > colorValues;
+    QVector< double > sizeValues;
+
+    points.reserve(numPoints);
+    if (hasColors)
+        colorValues.reserve(numPoints);
+    if (hasSizes)
+        sizeValues.reserve(numPoints);
+
+    for (int i = from; i <= to; i++) {
+        const QPointF sample = series->sample(i);
+        const QPointF pos(xMap.transform(sample.x()), yMap.transform(sample.y()));
+
+        if (!visible.contains(pos))
+            continue;
+
+        points += pos - rect.topLeft();
+        if (hasColors)
+            colorValues += m_data->symbolColorValues[ i ];
+        if (hasSizes)
+            sizeValues += m_data->symbolSizeValues[ i ];
+    }
+
+    QImage image(rect.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    renderer.render(&image,
+                    points.constData(),
+                    hasColors ? colorValues.constData() : NULL,
+                    hasSizes ? sizeValues.constData() : NULL,
+                    points.size(),
+                    renderThreadCount());
+
+    painter->drawImage(rect, image);
+}
+
 /*!
    \brief Set the value of the baseline
 
@@ -1132,6 +1492,20 @@ void QwtPlotCurve::setSamples(QVector< QPointF >&& samples)
     setData(new QwtPointSeriesData(samples));
 }
 
+/*!
+   Initialize data with a shared buffer of points.
+
+   No samples are copied, the same buffer can be assigned to
+   many curves.
+
+   \param buffer Shared buffer
+   \sa QwtSharedPointData, QwtSharedPointSource
+ */
+void QwtPlotCurve::setSamples(const QwtSharedPointBuffer& buffer)
+{
+    setData(new QwtSharedPointData(buffer));
+}
+
 /*!
    \brief Initialize the data by pointing to memory blocks which
          are not managed by QwtPlotCurve.
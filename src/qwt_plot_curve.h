@@ -29,12 +29,16 @@
 
 #include "qwt_global.h"
 #include "qwt_plot_seriesitem.h"
+#include "qwt_point_mapper.h"
 
 #include <qstring.h>
 
 class QwtScaleMap;
 class QwtSymbol;
 class QwtCurveFitter;
+class QwtColorMap;
+class QwtSymbolRenderer;
+class QwtSharedPointBuffer;
 template< typename T >
 class QwtSeriesData;
 class QwtText;
@@ -219,6 +223,8 @@ public:
            having a huge amount of points.
            With a reasonable number of points QPainter::drawPoints()
            will be faster.
+
+           \sa LineImageBuffer
          */
         ImageBuffer = 0x08,
 
@@ -245,6 +251,50 @@ public:
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+           Render the points as a density heatmap. Instead of setting
+           a pixel to the pen color the number of points mapped to each
+           pixel is counted and translated into a color using densityColorMap().
+           Overplotted areas remain distinguishable, what is useful for
+           scatter plots with millions of points.
+
+           \note Implemented for QwtPlotCurve::Dots without a brush only
+           \sa setDensityColorMap(), setDensityScaling(), QwtPointMapper::toDensityImage()
+         */
+        DensityBuffer = 0x20,
+
+        /*!
+           Declares, that the x coordinates of the samples are in increasing
+           order. Before mapping the points the index range of the samples
+           inside the visible x interval is found by binary search - plus one
+           neighbor on each side for the continuity of lines and steps.
+           The cost of a replot, f.e. when panning, depends on the number of
+           visible points only.
+
+           \note The order of the samples is not checked. With unsorted data
+                 samples might disappear.
+           \note Has no effect for QwtPlotCurve::Fitted curves and for curves
+                 with sticks or a brush in Qt::Horizontal orientation,
+                 where samples outside of the x interval can be visible.
+         */
+        SortedX = 0x40,
+
+        /*!
+           Rasterize the polyline of the Lines style into an image
+           without QPainter ( QwtPointMapper::toLineImage() ) and paint the image.
+           This is an optimization for curves with millions of points.
+
+           The polyline is rasterized only, when the pen is solid and not wider
+           than 1 pixel, the curve is not fitted and the painter is a raster
+           paint engine ( f.e. widgets on screen or a QImage ) without scaling or
+           rotation. Otherwise the curve is painted by QPainter.
+
+           \note Lines rasterized into the image are not exactly the same as those
+                 of QPainter, f.e. at the joins of the line segments
+           \sa ImageBuffer, QwtPointMapper::toLineImage()
+         */
+        LineImageBuffer = 0x80
     };
 
     Q_DECLARE_FLAGS(PaintAttributes, PaintAttribute)
@@ -287,6 +337,7 @@ public:
 
     void setSamples(QVector< QPointF >&&);
     void setSamples(const QVector< QPointF >&);
+    void setSamples(const QwtSharedPointBuffer&);
     void setSamples(QwtSeriesData< QPointF >*);
 
     virtual int closestPoint(const QPointF& pos, double* dist = NULL) const;
@@ -315,9 +366,24 @@ public:
     void setSymbol(QwtSymbol*);
     const QwtSymbol* symbol() const;
 
+    void setSymbolRenderer(QwtSymbolRenderer*);
+    QwtSymbolRenderer* symbolRenderer() const;
+
+    void setSymbolColorValues(const QVector< double >&);
+    QVector< double > symbolColorValues() const;
+
+    void setSymbolSizeValues(const QVector< double >&);
+    QVector< double > symbolSizeValues() const;
+
     void setCurveFitter(QwtCurveFitter*);
     QwtCurveFitter* curveFitter() const;
 
+    void setDensityColorMap(QwtColorMap*);
+    const QwtColorMap* densityColorMap() const;
+
+    void setDensityScaling(QwtPointMapper::DensityScaling);
+    QwtPointMapper::DensityScaling densityScaling() const;
+
     virtual void drawSeries(QPainter*,
                             const QwtScaleMap& xMap,
                             const QwtScaleMap& yMap,
@@ -346,6 +412,14 @@ protected:
                              int from,
                              int to) const;
 
+    virtual void drawBatchedSymbols(QPainter*,
+                                    const QwtSymbolRenderer&,
+                                    const QwtScaleMap& xMap,
+                                    const QwtScaleMap& yMap,
+                                    const QRectF& canvasRect,
+                                    int from,
+                                    int to) const;
+
     virtual void
     drawLines(QPainter*, const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QRectF& canvasRect, int from, int to) const;
 
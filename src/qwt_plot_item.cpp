@@ -41,6 +41,7 @@ class QwtPlotItem::PrivateData
         , isVisible( true )
         , renderThreadCount( 1 )
         , z( 0.0 )
+        , cacheLayer( 0 )
         , xAxisId( QwtAxis::XBottom )
         , yAxisId( QwtAxis::YLeft )
         , legendIconSize( 8, 8 )
@@ -58,6 +59,7 @@ class QwtPlotItem::PrivateData
     uint renderThreadCount;
 
     double z;
+    int cacheLayer;
 
     QwtAxisId xAxisId;
     QwtAxisId yAxisId;
@@ -195,6 +197,37 @@ void QwtPlotItem::setZ( double z )
     }
 }
 
+/*!
+   \brief Assign the item to a cache layer
+
+   When layered compositing is enabled, the items of each cache layer
+   are rendered into an image of their own, that is rendered again only
+   when one of its items has changed. The default layer is 0.
+
+   \param layer Cache layer
+   \sa cacheLayer(), QwtPlot::setLayeredCompositing()
+ */
+void QwtPlotItem::setCacheLayer( int layer )
+{
+    if ( m_data->cacheLayer != layer )
+    {
+        if ( m_data->plot )
+            m_data->plot->invalidateCacheLayer( m_data->cacheLayer );
+
+        m_data->cacheLayer = layer;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Cache layer of the item
+   \sa setCacheLayer(), QwtPlot::setLayeredCompositing()
+ */
+int QwtPlotItem::cacheLayer() const
+{
+    return m_data->cacheLayer;
+}
+
 /*!
    Set a new title
 
@@ -498,7 +531,10 @@ bool QwtPlotItem::isVisible() const
 void QwtPlotItem::itemChanged()
 {
     if ( m_data->plot )
+    {
+        m_data->plot->invalidateCacheLayer( m_data->cacheLayer );
         m_data->plot->autoRefresh();
+    }
 }
 
 /*!
@@ -262,6 +262,9 @@ public:
     double z() const;
     void setZ(double z);
 
+    void setCacheLayer(int layer);
+    int cacheLayer() const;
+
     void show();
     void hide();
     virtual void setVisible(bool);
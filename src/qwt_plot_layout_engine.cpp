@@ -223,6 +223,36 @@ void QwtPlotLayoutEngine::LayoutData::ScaleData::init(const QwtScaleWidget* axis
 		dimWithoutTitle -= axisWidget->titleHeightForWidth(QWIDGETSIZE_MAX);
 }
 
+/**
+ * @brief Initialize scale data from a QwtScaleDraw / 从QwtScaleDraw初始化刻度数据
+ *
+ * Used for scales without a widget ( f.e. QwtLightweightAxes ). The scale is laid out like
+ * a QwtScaleWidget with the given margin, no title and no color bar.
+ *
+ * 用于没有刻度窗口的坐标轴（如QwtLightweightAxes），按给定margin、无标题、无颜色条的QwtScaleWidget计算。
+ *
+ * @param scaleDraw Scale draw / 刻度绘制对象
+ * @param font Font of the tick labels / 刻度标签字体
+ * @param margin Distance between the backbone and the border / 骨架线与边界的距离
+ */
+void QwtPlotLayoutEngine::LayoutData::ScaleData::init(const QwtScaleDraw* scaleDraw, const QFont& font, int margin)
+{
+	isVisible = true;
+
+	scaleWidget = nullptr;
+	scaleFont   = font;
+
+	scaleDraw->getBorderDistHint(font, start, end);
+
+	baseLineOffset = margin;
+	edgeMargin     = 0;
+	tickOffset     = margin;
+	if (scaleDraw->hasComponent(QwtAbstractScaleDraw::Ticks))
+		tickOffset += scaleDraw->maxTickLength();
+
+	dimWithoutTitle = margin + qwtCeil(scaleDraw->extent(font)) + 1;
+}
+
 /**
  * @brief Reset scale data to default values / 将刻度数据重置为默认值
  *
@@ -268,6 +298,32 @@ void QwtPlotLayoutEngine::LayoutData::CanvasData::init(const QWidget* canvas)
 // QwtPlotLayoutEngine::LayoutData
 //----------------------------------------------------
 
+/**
+ * @brief Construct empty LayoutData / 构造空的LayoutData
+ *
+ * No legend, no labels, all axes hidden and no canvas margins. The data is filled in by
+ * layouts without widgets ( f.e. QwtLightweightAxes ).
+ *
+ * 无图例、无标签、所有轴隐藏且画布无边距，由不依赖窗口的布局（如QwtLightweightAxes）自行填充。
+ */
+QwtPlotLayoutEngine::LayoutData::LayoutData()
+{
+	legendData.frameWidth    = 0;
+	legendData.hScrollExtent = 0;
+	legendData.vScrollExtent = 0;
+
+	for (int i = 0; i < NumLabels; i++)
+		labelData[ i ].frameWidth = 0;
+
+	for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+		m_scaleData[ axisPos ].reset();
+		m_scaleData[ axisPos ].scaleWidget = nullptr;
+		m_scaleData[ axisPos ].edgeMargin  = 0;
+
+		canvasData.contentsMargins[ axisPos ] = 0;
+	}
+}
+
 /**
  * @brief Construct LayoutData from a QwtPlot / 从QwtPlot构造LayoutData
  *
@@ -1005,7 +1061,7 @@ QwtPlotLayoutEngine::Dimensions QwtPlotLayoutEngine::layoutDimensions(int plotLa
 					}
 
 					int d = scaleData.dimWithoutTitle;
-					if (!scaleData.scaleWidget->title().isEmpty()) {
+					if (scaleData.scaleWidget && !scaleData.scaleWidget->title().isEmpty()) {
 						d += scaleData.scaleWidget->titleHeightForWidth(qwtFloor(length));
 					}
 
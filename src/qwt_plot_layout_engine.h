@@ -12,6 +12,7 @@ class QWidget;
 class QwtAbstractLegend;
 class QwtTextLabel;
 class QwtScaleWidget;
+class QwtScaleDraw;
 /**
  * @brief The QwtPlotLayoutEngine class
  *
@@ -60,6 +61,7 @@ public:
         struct ScaleData
         {
             void init(const QwtScaleWidget* axisWidget);
+            void init(const QwtScaleDraw* scaleDraw, const QFont& font, int margin);
             void reset();
             bool isVisible;
             const QwtScaleWidget* scaleWidget;
@@ -87,6 +89,7 @@ public:
             NumLabels
         };
 
+        LayoutData();
         LayoutData(const QwtPlot* plot);
         bool hasSymmetricYAxes() const;
         ScaleData& axisData(QwtAxisId axisId);
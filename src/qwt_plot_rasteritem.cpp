@@ -30,6 +30,7 @@
 #include "qwt_text.h"
 #include "qwt_interval.h"
 #include "qwt_math.h"
+#include "qwt_render_stats.h"
 
 #include <qpainter.h>
 #include <qpaintengine.h>
@@ -858,6 +859,10 @@ QImage QwtPlotRasterItem::compose(
         {
             image = m_data->cache.image;
         }
+
+        QwtRenderStats* stats = QwtRenderStats::active();
+        if ( stats )
+            stats->addCacheAccess( QwtRenderStats::RasterCache, !image.isNull() );
     }
 
     if ( image.isNull() )
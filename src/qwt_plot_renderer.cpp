@@ -785,6 +785,10 @@ void QwtPlotRenderer::renderScale(const QwtPlot* plot,
 /*!
    Render the canvas into a given rectangle.
 
+   The items are clipped to the intersection of the canvas and the clip region
+   of the painter. So rendering a part of a plot, like a band of a tiled export,
+   doesn't paint the items outside of it.
+
    \param plot Plot widget
    \param painter Painter
    \param maps Maps mapping between plot and paint device coordinates
@@ -819,7 +823,7 @@ void QwtPlotRenderer::renderCanvas(const QwtPlot* plot, QPainter* painter, const
         painter->restore();
         painter->save();
 
-        painter->setClipRect(canvasRect);
+        painter->setClipRect(canvasRect, Qt::IntersectClip);
         plot->drawItems(painter, canvasRect, maps);
 
         painter->restore();
@@ -837,9 +841,9 @@ void QwtPlotRenderer::renderCanvas(const QwtPlot* plot, QPainter* painter, const
         painter->save();
 
         if (clipPath.isEmpty())
-            painter->setClipRect(canvasRect);
+            painter->setClipRect(canvasRect, Qt::IntersectClip);
         else
-            painter->setClipPath(clipPath);
+            painter->setClipPath(clipPath, Qt::IntersectClip);
 
         plot->drawItems(painter, canvasRect, maps);
 
@@ -862,9 +866,9 @@ void QwtPlotRenderer::renderCanvas(const QwtPlot* plot, QPainter* painter, const
         painter->save();
 
         if (clipPath.isEmpty()) {
-            painter->setClipRect(innerRect);
+            painter->setClipRect(innerRect, Qt::IntersectClip);
         } else {
-            painter->setClipPath(clipPath);
+            painter->setClipPath(clipPath, Qt::IntersectClip);
         }
 
         if (!(m_data->discardFlags & DiscardCanvasBackground)) {
@@ -20,6 +20,14 @@
 #include <QtMath>
 #include <QDebug>
 #include <QHash>
+#include <QEvent>
+#include <QThread>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
 
 // 使用表格性能会非常低下
 #ifndef QwtPlotSeriesDataPicker_UseTable
@@ -163,6 +171,88 @@ calculateSearchWindow(size_t curveSize, double targetX, const QwtSeriesData< QPo
     return qMakePair(startIndex, endIndex);
 }
 
+/**
+ * @brief 以上一次的结果作为起点查找upper index
+ *
+ * 结果与qwtUpperSampleIndex一致：返回第一个x大于value的点的索引，没有则返回count。
+ * 鼠标移动时目标点通常就在上一次结果的附近，从hint开始按1,2,4...的步长向两侧扩展，
+ * 找到包含结果的区间后再二分，相邻移动只需要很少的sample()调用
+ *
+ * @param series 曲线数据，必须按x升序排列
+ * @param count 数据点数
+ * @param value 目标x值
+ * @param hint 上一次的结果
+ */
+static size_t qwtPickerUpperSampleIndex(const QwtSeriesData< QPointF >& series, size_t count, double value, size_t hint)
+{
+    if (count == 0 || !(value < series.sample(count - 1).x())) {
+        return count;
+    }
+
+    if (hint >= count) {
+        hint = count - 1;
+    }
+
+    // 结果在[lo,hi]之间，且sample(hi).x() > value
+    size_t lo = 0;
+    size_t hi = count - 1;
+
+    if (value < series.sample(hint).x()) {
+        hi = hint;
+        for (size_t step = 1; step <= hint; step <<= 1) {
+            const size_t probe = hint - step;
+            if (value < series.sample(probe).x()) {
+                hi = probe;
+            } else {
+                lo = probe + 1;
+                break;
+            }
+        }
+    } else {
+        lo = hint + 1;
+        for (size_t step = 1; hint + step < hi; step <<= 1) {
+            const size_t probe = hint + step;
+            if (value < series.sample(probe).x()) {
+                hi = probe;
+                break;
+            }
+            lo = probe + 1;
+        }
+    }
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (value < series.sample(mid).x()) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+namespace
+{
+// 一条曲线的查找任务，可以在工作线程中执行
+struct QwtPickerLookupJob
+{
+    const QwtSeriesData< QPointF >* series;
+    size_t size;
+    double x;
+    size_t hint;
+    size_t index;
+};
+}
+
+static void qwtPickerLookup(QwtPickerLookupJob* jobs, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        QwtPickerLookupJob& job = jobs[ i ];
+        job.index               = qwtPickerUpperSampleIndex(*job.series, job.size, job.x, job.hint);
+    }
+}
+
 class QwtPlotSeriesDataPicker::PrivateData
 {
     QWT_DECLARE_PUBLIC(QwtPlotSeriesDataPicker)
@@ -214,6 +304,31 @@ public:
         QList< const FeaturePoint* > fps;
     };
 
+    // 缓存的曲线信息，避免每次鼠标移动都重新收集曲线和计算boundingRect
+    struct CurveEntry
+    {
+        QwtPlotCurve* curve;
+        QwtAxisId xAxis;
+        const QwtSeriesData< QPointF >* series;
+        size_t size;
+        double xMin;
+        double xMax;
+        bool boundsDirty;
+        size_t hint;  ///< 上一次查找的结果，作为下一次查找的起点
+    };
+
+    // 共用一个x轴的曲线
+    struct CurveGroup
+    {
+        GroupKey key;
+        QVector< int > entries;
+    };
+
+    // 曲线增删、寄生绘图变化时调用
+    void invalidateCurveCache();
+    // 检查并更新曲线缓存
+    void updateCurveCache(const QwtPlot* plot);
+
 public:
     QwtPlotSeriesDataPicker::PickSeriesMode pickMode { QwtPlotSeriesDataPicker::PickYValue };
     QwtPlotSeriesDataPicker::TextPlacement textArea { QwtPlotSeriesDataPicker::TextPlaceAuto };
@@ -229,12 +344,101 @@ public:
     QPoint mousePos;
     bool enableShowXOnPicker { true };
     QVector< XGroup > xGroups;
+    // 曲线缓存
+    const QwtPlot* cachePlot { nullptr };
+    bool cacheValid { false };
+    QVector< CurveEntry > curveEntries;
+    QVector< CurveGroup > curveGroups;
+    int parallelPickThreshold { 64 };
 };
 
 QwtPlotSeriesDataPicker::PrivateData::PrivateData(QwtPlotSeriesDataPicker* p) : q_ptr(p)
 {
 }
 
+void QwtPlotSeriesDataPicker::PrivateData::invalidateCurveCache()
+{
+    cacheValid = false;
+    curveEntries.clear();
+    curveGroups.clear();
+}
+
+/**
+ * @brief 检查并更新曲线缓存
+ *
+ * 曲线列表和按x轴的分组只在曲线增删或者曲线的x轴改变时重建，
+ * 曲线的x范围只在数据改变或画布重绘后重新获取
+ * @param plot 绘图
+ */
+void QwtPlotSeriesDataPicker::PrivateData::updateCurveCache(const QwtPlot* plot)
+{
+    if (cacheValid && cachePlot == plot) {
+        for (const CurveEntry& e : qAsConst(curveEntries)) {
+            if (e.curve->xAxis() != e.xAxis) {
+                cacheValid = false;
+                break;
+            }
+        }
+    }
+
+    if (!cacheValid || cachePlot != plot) {
+        invalidateCurveCache();
+        cachePlot = plot;
+
+        QHash< GroupKey, int > groupIndex;
+        const QList< QwtPlot* > plotList = plot->plotList();
+        for (QwtPlot* oneplot : plotList) {
+            const QwtPlotItemList& items = oneplot->itemList();
+            for (QwtPlotItem* item : items) {
+                if (item->rtti() != QwtPlotItem::Rtti_PlotCurve) {
+                    continue;
+                }
+
+                QwtPlotCurve* curve = static_cast< QwtPlotCurve* >(item);
+
+                CurveEntry e;
+                e.curve       = curve;
+                e.xAxis       = curve->xAxis();
+                e.series      = nullptr;
+                e.size        = 0;
+                e.xMin        = 0.0;
+                e.xMax        = -1.0;
+                e.boundsDirty = true;
+                e.hint        = 0;
+
+                const GroupKey key { curve->plot(), e.xAxis };
+                auto it = groupIndex.find(key);
+                if (it == groupIndex.end()) {
+                    CurveGroup group;
+                    group.key = key;
+                    it        = groupIndex.insert(key, curveGroups.size());
+                    curveGroups.append(group);
+                }
+                curveGroups[ it.value() ].entries.append(curveEntries.size());
+                curveEntries.append(e);
+            }
+        }
+        cacheValid = true;
+    }
+
+    for (CurveEntry& e : curveEntries) {
+        const QwtSeriesData< QPointF >* series = e.curve->data();
+        const size_t size                      = e.curve->dataSize();
+        if (series != e.series || size != e.size) {
+            e.series      = series;
+            e.size        = size;
+            e.boundsDirty = true;
+        }
+
+        if (e.boundsDirty) {
+            const QRectF br = e.curve->boundingRect();
+            e.xMin          = br.left();
+            e.xMax          = br.right();
+            e.boundsDirty   = false;
+        }
+    }
+}
+
 //===============================================================
 // QwtPlotSeriesDataPicker
 //===============================================================
@@ -456,6 +660,30 @@ bool QwtPlotSeriesDataPicker::isEnableShowXValue() const
     return m_data->enableShowXOnPicker;
 }
 
+/**
+ * @brief 设置并行拾取的曲线数量阈值
+ *
+ * PickYValue模式下，可拾取的曲线数量达到此值时，各条曲线的查找分配到多个线程中执行，
+ * 默认为64。
+ *
+ * @note 并行查找时曲线数据的sample()会在工作线程中调用，如果自定义的QwtSeriesData不是线程安全的，
+ * 需要设置为0关闭并行查找
+ * @param curveCount 曲线数量，0表示不使用并行
+ */
+void QwtPlotSeriesDataPicker::setParallelPickThreshold(int curveCount)
+{
+    m_data->parallelPickThreshold = qMax(curveCount, 0);
+}
+
+/**
+ * @brief 并行拾取的曲线数量阈值
+ * @return
+ */
+int QwtPlotSeriesDataPicker::parallelPickThreshold() const
+{
+    return m_data->parallelPickThreshold;
+}
+
 /**
  * @brief trackerText的重载
  *
@@ -870,6 +1098,25 @@ void QwtPlotSeriesDataPicker::setTrackerPosition(const QPoint& pos)
     QwtPicker::setTrackerPosition(pos);
 }
 
+/**
+ * @brief 事件过滤
+ *
+ * 画布重绘说明曲线数据可能发生了变化，缓存的曲线x范围在下一次拾取时重新获取
+ * @param object
+ * @param event
+ * @return
+ */
+bool QwtPlotSeriesDataPicker::eventFilter(QObject* object, QEvent* event)
+{
+    if (object && object == parentWidget() && event->type() == QEvent::Paint) {
+        QWT_D(d);
+        for (PrivateData::CurveEntry& e : d->curveEntries) {
+            e.boundsDirty = true;
+        }
+    }
+    return QwtCanvasPicker::eventFilter(object, event);
+}
+
 /**
  * @brief 获取绘图区域指定屏幕位置上所有可拾取的Y值
  * @param plot 绘图对象
@@ -888,170 +1135,143 @@ int QwtPlotSeriesDataPicker::pickYValue(const QwtPlot* plot, const QPoint& pos,
     QList< QwtPlotSeriesDataPicker::FeaturePoint >& featurePoints = d->featurePoints;
     featurePoints.clear();
     d->xGroups.clear();
-    const QList< QwtPlot* > plotList = plot->plotList();
 
-    // 收集所有曲线
-    QList< QwtPlotCurve* > allCurves;
-    for (QwtPlot* oneplot : plotList) {
-        const QwtPlotItemList& items = oneplot->itemList();
-        for (QwtPlotItem* item : items) {
-            if (item->rtti() == QwtPlotItem::Rtti_PlotCurve) {
-                QwtPlotCurve* curve = static_cast< QwtPlotCurve* >(item);
-                if (curve->isVisible() && curve->dataSize() > 0) {
-                    allCurves.append(curve);
-                }
-            }
-        }
-    }
+    // 曲线列表、分组和x范围来自缓存，只有在变化时才重新收集
+    d->updateCurveCache(plot);
 
-    if (pickMode() == PickYValue && isEnableShowXValue()) {
-        // 按X轴分组（同一个plot中的同一个X轴为一组）
-        QHash< PrivateData::GroupKey, QList< QwtPlotCurve* > > curvesByAxis;
+    // 每个X轴组只计算一次坐标映射（同一个plot中的同一个X轴为一组）
+    QVector< double > groupX(d->curveGroups.size());
+    QVector< int > groupJobEnd(d->curveGroups.size());
+    QVector< QwtPickerLookupJob > jobs;
+    QVector< int > jobEntries;
+    jobs.reserve(d->curveEntries.size());
+    jobEntries.reserve(d->curveEntries.size());
 
-        for (QwtPlotCurve* curve : allCurves) {
-            QwtPlot* p = curve->plot();
-            PrivateData::GroupKey key { p, curve->xAxis() };
-            curvesByAxis[ key ].append(curve);
+    for (int ig = 0; ig < d->curveGroups.size(); ++ig) {
+        const PrivateData::CurveGroup& group = d->curveGroups[ ig ];
+
+        // 获取该X轴对应的plot
+        QwtPlot* plotForAxis = group.key.plot;
+        groupJobEnd[ ig ]    = jobs.size();
+        if (!plotForAxis) {
+            continue;
         }
 
-        // 处理每个X轴组
-        for (auto it = curvesByAxis.begin(); it != curvesByAxis.end(); ++it) {
-            const PrivateData::GroupKey& key     = it.key();
-            const QList< QwtPlotCurve* >& curves = it.value();
+        // 计算鼠标位置对应的X值（这是该组所有曲线共享的X值）
+        const QwtScaleMap xMap = plotForAxis->canvasMap(group.key.axis);
+        const double x         = xMap.invTransform(pos.x());
+        groupX[ ig ]           = x;
 
-            if (curves.isEmpty()) {
+        for (int ie : group.entries) {
+            const PrivateData::CurveEntry& e = d->curveEntries[ ie ];
+            if (e.size == 0 || !e.series || !e.curve->isVisible()) {
                 continue;
             }
 
-            // 创建分组
-            PrivateData::XGroup group;
-            group.key = key;
-
-            // 获取该X轴对应的plot
-            QwtPlot* plotForAxis = key.plot;
-            if (!plotForAxis) {
+            // 边界检查：鼠标X值是否在曲线X范围内
+            if (!(x >= e.xMin && x <= e.xMax)) {
                 continue;
             }
 
-            // 获取该X轴的映射
-            const QwtScaleMap xMap = plotForAxis->canvasMap(key.axis);
-
-            // 计算鼠标位置对应的X值（这是该组所有曲线共享的X值）
-            double mouseXValue = xMap.invTransform(pos.x());
-
-            // 格式化X值，作为该组的公共X值
-            group.xValue = formatAxisValue(mouseXValue, key.axis, plotForAxis);
+            QwtPickerLookupJob job;
+            job.series = e.series;
+            job.size   = e.size;
+            job.x      = x;
+            job.hint   = e.hint;
+            job.index  = e.size;
 
-            // 处理该组内的所有曲线
-            for (QwtPlotCurve* curve : curves) {
-                const size_t curveSize = curve->dataSize();
-                if (curveSize == 0) {
-                    continue;
-                }
+            jobs.append(job);
+            jobEntries.append(ie);
+        }
+        groupJobEnd[ ig ] = jobs.size();
+    }
 
-                // 获取曲线的边界矩形
-                const QRectF br = curve->boundingRect();
-                // 边界检查：鼠标X值是否在曲线X范围内
-                if (mouseXValue < br.left() || mouseXValue > br.right()) {
-                    continue;
-                }
+    // 在曲线数据中查找对应的点，曲线较多时并行查找
+    const int numJobs = jobs.size();
+    int numThreads    = 1;
+#if QWT_USE_THREADS
+    if (d->parallelPickThreshold > 0 && numJobs >= d->parallelPickThreshold) {
+        numThreads = qBound(1, QThread::idealThreadCount(), numJobs / qMax(d->parallelPickThreshold / 2, 1));
+    }
+#endif
 
-                // 在曲线数据中查找对应的点
-                size_t index = qwtUpperSampleIndex< QPointF >(
-                    *curve->data(), mouseXValue, [](const double x, const QPointF& pos) -> bool { return (x < pos.x()); });
+    if (numThreads > 1) {
+#if QWT_USE_THREADS
+        QList< QFuture< void > > futures;
+        const int chunkSize = numJobs / numThreads;
 
-                if (index == curveSize) {
-                    continue;
-                }
+        for (int i = 0; i < numThreads; ++i) {
+            const int from = i * chunkSize;
+            const int to   = (i == numThreads - 1) ? numJobs : from + chunkSize;
 
-                // 创建特征点
-                FeaturePoint fp;
-                fp.item  = curve;
-                fp.index = index;
-
-                if (interpolate && curveSize > 2 && index > 0) {
-                    // 插值计算
-                    const QPointF& p2 = curve->sample(index);
-                    const QPointF& p1 = curve->sample(index - 1);
-                    if (qFuzzyCompare(p1.x(), p2.x())) {
-                        fp.feature = p2;
-                    } else {
-                        double t = (mouseXValue - p1.x()) / (p2.x() - p1.x());
-                        QPointF interPoint;
-                        interPoint.setX(mouseXValue);  // 使用统一的X值
-                        interPoint.setY(p1.y() + t * (p2.y() - p1.y()));
-                        fp.feature = interPoint;
-                    }
-                } else {
-                    QPointF point = curve->sample(index);
-                    // 使用统一的X值，而不是曲线上的实际X值
-                    fp.feature = QPointF(mouseXValue, point.y());
-                }
-
-                featurePoints.append(fp);
-                group.fps.append(&featurePoints.last());
+            if (i == numThreads - 1) {
+                qwtPickerLookup(jobs.data(), from, to);
+            } else {
+                futures += QtConcurrent::run(&qwtPickerLookup, jobs.data(), from, to);
             }
+        }
 
-            // 如果该组有特征点，添加到分组列表
-            if (!group.fps.isEmpty()) {
-                d->xGroups.append(group);
-            }
+        for (int i = 0; i < futures.size(); ++i) {
+            futures[ i ].waitForFinished();
         }
+#endif
     } else {
-        // 不分组显示X值，或不是PickYValue模式
-        for (QwtPlotCurve* curve : allCurves) {
-            const size_t curveSize = curve->dataSize();
-            if (curveSize == 0)
-                continue;
+        qwtPickerLookup(jobs.data(), 0, numJobs);
+    }
 
-            QwtPlot* oneplot = curve->plot();
+    // xGroups记录的是featurePoints中元素的地址，预留空间避免追加时重新分配
+    featurePoints.reserve(numJobs);
+    const bool groupByAxis = (pickMode() == PickYValue && isEnableShowXValue());
 
-            // 获取曲线的坐标轴映射
-            const QwtScaleMap xMap = oneplot->canvasMap(curve->xAxis());
+    int iJob = 0;
+    for (int ig = 0; ig < d->curveGroups.size(); ++ig) {
+        const PrivateData::CurveGroup& group = d->curveGroups[ ig ];
+        const double mouseXValue             = groupX[ ig ];
 
-            // 将屏幕坐标转换为曲线坐标系的坐标
-            double x = xMap.invTransform(pos.x());
+        PrivateData::XGroup xGroup;
+        xGroup.key = group.key;
 
-            // 提前计算并缓存边界矩形
-            const QRectF br = curve->boundingRect();
-            if (!br.isValid()) {
-                continue;
-            }
+        for (; iJob < groupJobEnd[ ig ]; ++iJob) {
+            PrivateData::CurveEntry& e = d->curveEntries[ jobEntries[ iJob ] ];
 
-            // 快速边界检查
-            if (x < br.left() || x > br.right()) {
+            const size_t index = jobs[ iJob ].index;
+            if (index == e.size) {
                 continue;
             }
+            e.hint = index;
 
-            size_t index = qwtUpperSampleIndex< QPointF >(
-                *curve->data(), x, [](const double x, const QPointF& pos) -> bool { return (x < pos.x()); });
-
-            if (index == curveSize) {
-                continue;
-            }
+            QwtPlotCurve* curve = e.curve;
 
+            // 创建特征点
             FeaturePoint fp;
             fp.item  = curve;
             fp.index = index;
 
-            if (interpolate && curveSize > 2 && index > 0) {
+            if (interpolate && e.size > 2 && index > 0) {
                 // 插值计算
-                const QPointF& p2 = curve->sample(index);
-                const QPointF& p1 = curve->sample(index - 1);
+                const QPointF p2 = curve->sample(index);
+                const QPointF p1 = curve->sample(index - 1);
                 if (qFuzzyCompare(p1.x(), p2.x())) {
                     fp.feature = p2;
                 } else {
-                    double t = (x - p1.x()) / (p2.x() - p1.x());
-                    QPointF interPoint;
-                    interPoint.setX(x);
-                    interPoint.setY(p1.y() + t * (p2.y() - p1.y()));
-                    fp.feature = interPoint;
+                    const double t = (mouseXValue - p1.x()) / (p2.x() - p1.x());
+                    fp.feature     = QPointF(mouseXValue, p1.y() + t * (p2.y() - p1.y()));
                 }
+            } else if (groupByAxis) {
+                // 使用统一的X值，而不是曲线上的实际X值
+                fp.feature = QPointF(mouseXValue, curve->sample(index).y());
             } else {
                 fp.feature = curve->sample(index);
             }
 
             featurePoints.append(fp);
+            xGroup.fps.append(&featurePoints.last());
+        }
+
+        // 如果该组有特征点，添加到分组列表
+        if (groupByAxis && !xGroup.fps.isEmpty()) {
+            xGroup.xValue = formatAxisValue(mouseXValue, group.key.axis, group.key.plot);
+            d->xGroups.append(xGroup);
         }
     }
     return featurePoints.size();
@@ -1141,6 +1361,8 @@ void QwtPlotSeriesDataPicker::onPlotItemDetached(QwtPlotItem* item, bool on)
 {
     // 遍历看看是否有此item
     QWT_D(d);
+    // item增删，需要重建曲线缓存（item析构时rtti()已经无法区分曲线）
+    d->invalidateCurveCache();
     if (!on) {
         QList< QwtPlotSeriesDataPicker::FeaturePoint >& pickedFeatureDatas = d->featurePoints;
         for (int i = pickedFeatureDatas.size() - 1; i >= 0; --i) {
@@ -1163,6 +1385,7 @@ void QwtPlotSeriesDataPicker::onPlotItemDetached(QwtPlotItem* item, bool on)
 
 void QwtPlotSeriesDataPicker::onParasitePlotAttached(QwtPlot* parasiteplot, bool on)
 {
+    m_data->invalidateCurveCache();
 
     if (on) {
         // 寄生轴新增，需要绑定寄生轴的onPlotItemDetached
@@ -102,6 +102,10 @@ public:
     void setEnableShowXValue(bool on);
     bool isEnableShowXValue() const;
 
+    // 曲线数量达到此值时，PickYValue模式下并行查找各条曲线，0表示不使用并行
+    void setParallelPickThreshold(int curveCount);
+    int parallelPickThreshold() const;
+
     // 顶部矩形文字
     QwtText trackerText(const QPoint& pos) const QWT_OVERRIDE;
 
@@ -114,6 +118,9 @@ public:
     // 手动设置位置
     virtual void setTrackerPosition(const QPoint& pos) QWT_OVERRIDE;
 
+    // 画布重绘时标记缓存的曲线范围需要更新
+    virtual bool eventFilter(QObject* object, QEvent* event) QWT_OVERRIDE;
+
 private:
     // 获取绘图区域屏幕坐标pos上，的所有可拾取的y值,返回获取的个数
     int pickYValue(const QwtPlot* plot, const QPoint& pos, bool interpolate = false);
@@ -26,11 +26,76 @@
 
 #include "qwt_plot_spectrocurve.h"
 #include "qwt_color_map.h"
+#include "qwt_interval.h"
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
 #include "qwt_text.h"
 
 #include <qpainter.h>
+#include <qvector.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // points of a chunk of samples, grouped by their color index
+    class QwtSpectroDotBuckets
+    {
+      public:
+        QwtSpectroDotBuckets()
+            : points( 256 )
+        {
+        }
+
+        QVector< QVector< QPointF > > points;
+    };
+}
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtSpectroDotsCommand
+{
+  public:
+    const QwtSeriesData< QwtPoint3D >* series;
+    const QwtColorMap* colorMap;
+    QwtInterval colorRange;
+    QRectF clipRect;
+    bool doClip;
+    bool doAlign;
+    int from;
+    int to;
+};
+
+static void qwtMapSpectroDots( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSpectroDotsCommand& command, QwtSpectroDotBuckets* buckets )
+{
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtPoint3D sample = command.series->sample( i );
+
+        double xi = xMap.transform( sample.x() );
+        double yi = yMap.transform( sample.y() );
+        if ( command.doAlign )
+        {
+            xi = qRound( xi );
+            yi = qRound( yi );
+        }
+
+        if ( command.doClip && !command.clipRect.contains( xi, yi ) )
+            continue;
+
+        const uint index = command.colorMap->colorIndex(
+            256, command.colorRange, sample.z() );
+
+        buckets->points[ index & 0xff ] += QPointF( xi, yi );
+    }
+}
 
 class QwtPlotSpectroCurve::PrivateData
 {
@@ -291,6 +356,12 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
     if ( !m_data->colorRange.isValid() )
         return;
 
+    if ( m_data->paintAttributes & QwtPlotSpectroCurve::BatchedDots )
+    {
+        drawBatchedDots( painter, xMap, yMap, canvasRect, from, to );
+        return;
+    }
+
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
     const QwtColorMap::Format format = m_data->colorMap->format();
@@ -299,6 +370,13 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
 
     const QwtSeriesData< QwtPoint3D >* series = data();
 
+    // the pen is only changed, when the color differs from the previous point
+    QPen pen;
+    pen.setWidthF( m_data->penWidth );
+
+    bool hasColor = false;
+    QRgb lastRgb = 0;
+
     for ( int i = from; i <= to; i++ )
     {
         const QwtPoint3D sample = series->sample( i );
@@ -317,20 +395,26 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
                 continue;
         }
 
+        QRgb rgb;
         if ( format == QwtColorMap::RGB )
         {
-            const QRgb rgb = m_data->colorMap->rgb(
-                m_data->colorRange, sample.z() );
-
-            painter->setPen( QPen( QColor::fromRgba( rgb ), m_data->penWidth ) );
+            rgb = m_data->colorMap->rgb( m_data->colorRange, sample.z() );
         }
         else
         {
             const unsigned char index = m_data->colorMap->colorIndex(
                 256, m_data->colorRange, sample.z() );
 
-            painter->setPen( QPen( QColor::fromRgba( m_data->colorTable[index] ),
-                m_data->penWidth ) );
+            rgb = m_data->colorTable[index];
+        }
+
+        if ( !hasColor || rgb != lastRgb )
+        {
+            pen.setColor( QColor::fromRgba( rgb ) );
+            painter->setPen( pen );
+
+            lastRgb = rgb;
+            hasColor = true;
         }
 
         QwtPainter::drawPoint( painter, QPointF( xi, yi ) );
@@ -338,3 +422,109 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
 
     m_data->colorTable.clear();
 }
+
+/*!
+   Draw a subset of the points grouped by color
+
+   The samples are mapped in chunks - in parallel for large series,
+   according to renderThreadCount() - into 256 buckets, one for each
+   color of QwtColorMap::colorTable256(). Then all points of a bucket
+   are painted with one drawPoints() call.
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas
+   \param from Index of the first sample to be painted
+   \param to Index of the last sample to be painted
+
+   \sa BatchedDots, drawDots()
+ */
+void QwtPlotSpectroCurve::drawBatchedDots( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    QwtSpectroDotsCommand command;
+    command.series = data();
+    command.colorMap = m_data->colorMap;
+    command.colorRange = m_data->colorRange;
+    command.clipRect = canvasRect;
+    command.doClip = m_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints;
+    command.doAlign = QwtPainter::roundingAlignment( painter );
+
+    uint numThreads = renderThreadCount();
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    // no need for more threads, than we have chunks of a reasonable size
+    const int minChunkSize = 10000;
+    numThreads = qBound( 1u, numThreads, uint( ( to - from + 1 ) / minChunkSize + 1 ) );
+#else
+    numThreads = 1;
+#endif
+
+    QVector< QwtSpectroDotBuckets > buckets( int( numThreads ) );
+
+    if ( numThreads > 1 )
+    {
+#if QWT_USE_THREADS
+        const int numSamples = ( to - from + 1 ) / numThreads;
+
+        QList< QFuture< void > > futures;
+        for ( uint i = 0; i < numThreads; i++ )
+        {
+            command.from = from + i * numSamples;
+            command.to = ( i == numThreads - 1 ) ? to : command.from + numSamples - 1;
+
+            if ( i == numThreads - 1 )
+            {
+                qwtMapSpectroDots( xMap, yMap, command, &buckets[i] );
+            }
+            else
+            {
+                futures += QtConcurrent::run( &qwtMapSpectroDots,
+                    xMap, yMap, command, &buckets[i] );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#endif
+    }
+    else
+    {
+        command.from = from;
+        command.to = to;
+
+        qwtMapSpectroDots( xMap, yMap, command, &buckets[0] );
+    }
+
+    const QVector< QRgb > colorTable = m_data->colorMap->colorTable256();
+
+    QPen pen;
+    pen.setWidthF( m_data->penWidth );
+
+    for ( int index = 0; index < 256; index++ )
+    {
+        bool hasPen = false;
+
+        // chunks in the order of the samples
+        for ( int i = 0; i < buckets.size(); i++ )
+        {
+            const QVector< QPointF >& points = buckets[i].points[index];
+            if ( points.isEmpty() )
+                continue;
+
+            if ( !hasPen )
+            {
+                pen.setColor( QColor::fromRgba( colorTable[index] ) );
+                painter->setPen( pen );
+                hasPen = true;
+            }
+
+            QwtPainter::drawPoints( painter, points.constData(), points.size() );
+        }
+    }
+}
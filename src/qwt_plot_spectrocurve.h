@@ -45,7 +45,18 @@ class QWT_EXPORT QwtPlotSpectroCurve
     enum PaintAttribute
     {
         //! Clip points outside the canvas rectangle
-        ClipPoints = 1
+        ClipPoints = 1,
+
+        /*!
+            BatchedDots maps the z values to the 256 colors of
+            QwtColorMap::colorTable256() - in parallel for large series - and
+            paints all points of the same color in one drawPoints() call.
+
+            This is significantly faster than setting a pen for each point,
+            but RGB color maps are quantized to 256 colors and points are
+            painted grouped by color instead of in the order of the samples.
+         */
+        BatchedDots = 2
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -85,6 +96,10 @@ class QWT_EXPORT QwtPlotSpectroCurve
   private:
     void init();
 
+    void drawBatchedDots( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
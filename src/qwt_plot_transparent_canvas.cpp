@@ -2,16 +2,36 @@
 // qt
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qpixmap.h>
 #include <qevent.h>
 // qwt
 #include "qwt_painter.h"
 #include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
+#include "qwt_scale_map.h"
 
 #ifndef QWTPLOTTRANSPARENTCANVAS_DEBUG_DRAW
 #define QWTPLOTTRANSPARENTCANVAS_DEBUG_DRAW 0
 #endif
 
-QwtPlotTransparentCanvas::QwtPlotTransparentCanvas(QwtPlot* plot) : QFrame(plot), QwtPlotAbstractCanvas(this)
+class QwtPlotTransparentCanvas::PrivateData
+{
+    QWT_DECLARE_PUBLIC(QwtPlotTransparentCanvas)
+public:
+    PrivateData(QwtPlotTransparentCanvas* p);
+
+    QwtPlotTransparentCanvas::PaintAttributes paintAttributes;
+    QPixmap backingStore;
+    QVector< double > mapsKey;  ///< 缓存对应的坐标映射，坐标轴变化后缓存失效
+};
+
+QwtPlotTransparentCanvas::PrivateData::PrivateData(QwtPlotTransparentCanvas* p) : q_ptr(p)
+{
+    paintAttributes = QwtPlotTransparentCanvas::BackingStore | QwtPlotTransparentCanvas::HostCompositing;
+}
+
+QwtPlotTransparentCanvas::QwtPlotTransparentCanvas(QwtPlot* plot)
+    : QFrame(plot), QwtPlotAbstractCanvas(this), QWT_PIMPL_CONSTRUCT
 {
     // 设置透明相关属性
     setAttribute(Qt::WA_TranslucentBackground);
@@ -37,13 +57,146 @@ QwtPlotTransparentCanvas::~QwtPlotTransparentCanvas()
 {
 }
 
+/**
+ * @brief Changing the paint attributes/设置绘制属性
+ * @param attribute Paint attribute
+ * @param on On/Off
+ * @sa testPaintAttribute(), backingStore()
+ */
+void QwtPlotTransparentCanvas::setPaintAttribute(PaintAttribute attribute, bool on)
+{
+    QWT_D(d);
+    if (bool(d->paintAttributes & attribute) == on)
+        return;
+
+    if (on)
+        d->paintAttributes |= attribute;
+    else
+        d->paintAttributes &= ~attribute;
+
+    invalidateBackingStore();
+
+    // 合成方式变化，画布和宿主画布都需要重绘
+    update();
+    if (QWidget* canvas = hostCanvas())
+        canvas->update();
+}
+
+/**
+ * @brief Test whether a paint attribute is enabled/测试绘制属性
+ * @param attribute Paint attribute
+ * @return true, when attribute is enabled
+ * @sa setPaintAttribute()
+ */
+bool QwtPlotTransparentCanvas::testPaintAttribute(PaintAttribute attribute) const
+{
+    return d_func()->paintAttributes & attribute;
+}
+
+/**
+ * @brief Backing store, might be null/缓存，可能为空
+ */
+const QPixmap* QwtPlotTransparentCanvas::backingStore() const
+{
+    return &d_func()->backingStore;
+}
+
+/**
+ * @brief Invalidate the backing store/使缓存失效
+ *
+ * The items are rendered again, when the canvas is painted the next time.
+ */
+void QwtPlotTransparentCanvas::invalidateBackingStore()
+{
+    QWT_D(d);
+    d->backingStore = QPixmap();
+    d->mapsKey.clear();
+}
+
+/**
+ * @brief Check if the canvas is composited by the canvas of the host plot/是否由宿主画布合成
+ * @return true, when HostCompositing is enabled and the canvas of the host plot is a QwtPlotCanvas
+ */
+bool QwtPlotTransparentCanvas::isHostComposited() const
+{
+    if (!testPaintAttribute(HostCompositing))
+        return false;
+
+    return qobject_cast< QwtPlotCanvas* >(hostCanvas()) != nullptr;
+}
+
+/**
+ * @brief Draw the content of the canvas on the canvas of the host plot/把画布内容绘制到宿主画布
+ * @param painter Painter of the host canvas
+ * @param pos Position of this canvas in coordinates of the host canvas
+ */
+void QwtPlotTransparentCanvas::drawComposited(QPainter* painter, const QPoint& pos)
+{
+    if (testPaintAttribute(BackingStore)) {
+        updateBackingStore();
+        painter->drawPixmap(pos, d_func()->backingStore);
+    } else {
+        painter->save();
+        painter->translate(pos);
+        drawCanvas(painter);
+        painter->restore();
+    }
+}
+
+/**
+ * @brief Composite the canvases of all parasite plots/合成所有寄生绘图的画布
+ *
+ * Called by the canvas of the host plot after painting its own content.
+ * The parasite plots are composited in the order they have been added.
+ *
+ * @param painter Painter of the host canvas
+ * @param hostPlot Host plot
+ */
+void QwtPlotTransparentCanvas::compositeParasites(QPainter* painter, const QwtPlot* hostPlot)
+{
+    if (!hostPlot || !hostPlot->isHostPlot())
+        return;
+
+    const QWidget* canvas = hostPlot->canvas();
+    if (!canvas)
+        return;
+
+    const QList< QwtPlot* > parasites = hostPlot->parasitePlots();
+    for (QwtPlot* parasite : parasites) {
+        if (!parasite->isParasitePlot() || !parasite->isVisible())
+            continue;
+
+        QwtPlotTransparentCanvas* c = qobject_cast< QwtPlotTransparentCanvas* >(parasite->canvas());
+        if (c && c->isVisible() && c->isHostComposited()) {
+            const QPoint pos = canvas->mapFrom(hostPlot, c->mapTo(hostPlot, QPoint(0, 0)));
+            c->drawComposited(painter, pos);
+        }
+    }
+}
+
+/**
+ * @brief Invalidate the backing store and repaint/缓存失效并重绘
+ *
+ * When the canvas is composited by the host canvas only the host canvas
+ * is updated, what doesn't render its own items again.
+ */
 void QwtPlotTransparentCanvas::replot()
 {
-    update(contentsRect());
+    invalidateBackingStore();
+
+    if (isHostComposited())
+        hostCanvas()->update();
+    else
+        update(contentsRect());
 }
 
 void QwtPlotTransparentCanvas::paintEvent(QPaintEvent* event)
 {
+    Q_UNUSED(event);
+
+    if (isHostComposited())
+        return;  // 由宿主画布合成
+
     QPainter painter(this);
 #if QWTPLOTTRANSPARENTCANVAS_DEBUG_DRAW
     painter.setPen(QPen(Qt::red, 1, Qt::DashLine));
@@ -53,7 +206,15 @@ void QwtPlotTransparentCanvas::paintEvent(QPaintEvent* event)
 
     // 对于透明画布，我们不需要填充背景
     // 直接绘制内容到画布
-    drawCanvas(&painter);
+    drawComposited(&painter, QPoint(0, 0));
+}
+
+void QwtPlotTransparentCanvas::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange)
+        invalidateBackingStore();
+
+    QFrame::changeEvent(event);
 }
 
 void QwtPlotTransparentCanvas::drawBorder(QPainter* painter)
@@ -67,3 +228,41 @@ QPainterPath QwtPlotTransparentCanvas::borderPath(const QRect& rect) const
     Q_UNUSED(rect);
     return QPainterPath();
 }
+
+/**
+ * @brief Render the items into the backing store, when it is outdated/缓存过期时重新渲染
+ */
+void QwtPlotTransparentCanvas::updateBackingStore()
+{
+    QWT_D(d);
+
+    QVector< double > key;
+    if (const QwtPlot* plt = plot()) {
+        key.reserve(4 * QwtAxis::AxisPositions);
+        for (int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++) {
+            const QwtScaleMap map = plt->canvasMap(axisPos);
+            key << map.s1() << map.s2() << map.p1() << map.p2();
+        }
+    }
+
+    QPixmap& bs = d->backingStore;
+    if (bs.isNull() || bs.size() != size() * QwtPainter::devicePixelRatio(&bs) || key != d->mapsKey) {
+        bs = QwtPainter::backingStore(this, size());
+        bs.fill(Qt::transparent);
+
+        QPainter p(&bs);
+        drawCanvas(&p);
+
+        d->mapsKey = key;
+    }
+}
+
+QWidget* QwtPlotTransparentCanvas::hostCanvas() const
+{
+    const QwtPlot* plt = plot();
+    if (!plt || !plt->isParasitePlot())
+        return nullptr;
+
+    QwtPlot* host = plt->hostPlot();
+    return host ? host->canvas() : nullptr;
+}
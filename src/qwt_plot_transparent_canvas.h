@@ -5,19 +5,75 @@
 #include "qwt_plot_abstract_canvas.h"
 #include <qframe.h>
 
+class QPixmap;
+
+/**
+ * @brief Transparent canvas of a parasite plot/寄生绘图的透明画布
+ *
+ * The items of the parasite plot are rendered into a transparent backing store, that is
+ * only rendered again on replot() of the parasite plot. With HostCompositing the canvas doesn't
+ * paint itself, but the canvas of the host plot composites the backing stores of all its parasite
+ * plots on top of its own content, so that repainting the host doesn't repaint any parasite items.
+ *
+ * 寄生绘图的items渲染到透明的缓存中，只有寄生绘图replot时才重新渲染。
+ * 开启HostCompositing时，画布自身不绘制，而是由宿主绘图的画布在绘制完自身内容后一次性合成所有寄生绘图的缓存，
+ * 宿主重绘时不需要重绘寄生绘图的items
+ */
 class QWT_EXPORT QwtPlotTransparentCanvas : public QFrame, public QwtPlotAbstractCanvas
 {
     Q_OBJECT
+    QWT_DECLARE_PRIVATE(QwtPlotTransparentCanvas)
 public:
+    /**
+     * @brief Paint attributes/绘制属性
+     *
+     * The default setting enables BackingStore and HostCompositing.
+     */
+    enum PaintAttribute
+    {
+        //! Render the items into a transparent backing store, that is reused until the next replot/缓存绘制结果
+        BackingStore = 0x01,
+
+        /**
+         * Let the canvas of the host plot composite this canvas. Only available, when the
+         * canvas of the host plot is a QwtPlotCanvas - otherwise the canvas paints itself.
+         * 由宿主画布合成此画布，仅在宿主画布为QwtPlotCanvas时有效
+         */
+        HostCompositing = 0x02
+    };
+
+    Q_DECLARE_FLAGS(PaintAttributes, PaintAttribute)
+
     explicit QwtPlotTransparentCanvas(QwtPlot* plot = nullptr);
     virtual ~QwtPlotTransparentCanvas();
+
+    void setPaintAttribute(PaintAttribute, bool on = true);
+    bool testPaintAttribute(PaintAttribute) const;
+
+    const QPixmap* backingStore() const;
+    void invalidateBackingStore();
+
+    // 是否由宿主画布合成
+    bool isHostComposited() const;
+    // 把画布内容合成到宿主画布，pos为此画布在宿主画布中的位置
+    void drawComposited(QPainter* painter, const QPoint& pos);
+
+    // 宿主画布合成所有寄生绘图的画布
+    static void compositeParasites(QPainter* painter, const QwtPlot* hostPlot);
 public Q_SLOTS:
     virtual void replot();
 
 protected:
     virtual void paintEvent(QPaintEvent* event) override;
+    virtual void changeEvent(QEvent* event) override;
     virtual void drawBorder(QPainter* painter) override;
     virtual QPainterPath borderPath(const QRect& rect) const;
+
+private:
+    void updateBackingStore();
+    QWidget* hostCanvas() const;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QwtPlotTransparentCanvas::PaintAttributes)
+
 #endif  // QWT_PLOT_TRANSPARENT_CANVAS_H
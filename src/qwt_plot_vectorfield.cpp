@@ -39,6 +39,14 @@
 #include <cstdlib>
 #include <limits>
 
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
 #define DEBUG_RENDER 0
 
 #if DEBUG_RENDER
@@ -224,7 +232,7 @@ namespace
         inline void addSample( double x, double y,
             double u, double v )
         {
-            if ( x >= m_x0 && x < m_x1
+            if ( m_entries != NULL && x >= m_x0 && x < m_x1
                 && y >= m_y0 && y < m_y1 )
             {
                 Entry& entry = m_entries[ indexOf( x, y ) ];
@@ -237,6 +245,28 @@ namespace
             return m_entries;
         }
 
+        // add the entries of a matrix with the same geometry
+        void merge( const FilterMatrix& other )
+        {
+            if ( m_entries == NULL || other.m_entries == NULL )
+                return;
+
+            const int numEntries = m_numRows * m_numColumns;
+            for ( int i = 0; i < numEntries; i++ )
+            {
+                const Entry& from = other.m_entries[i];
+                if ( from.count == 0 )
+                    continue;
+
+                Entry& to = m_entries[i];
+                to.count += from.count;
+                to.x += from.x;
+                to.y += from.y;
+                to.vx += from.vx;
+                to.vy += from.vy;
+            }
+        }
+
       private:
         inline int indexOf( qreal x, qreal y ) const
         {
@@ -254,6 +284,30 @@ namespace
     };
 }
 
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtVectorFieldFilterCommand
+{
+  public:
+    const QwtSeriesData< QwtVectorFieldSample >* series;
+    int from;
+    int to;
+};
+
+static void qwtFilterVectors( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtVectorFieldFilterCommand& command, FilterMatrix* matrix )
+{
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtVectorFieldSample sample = command.series->sample( i );
+        if ( !sample.isNull() )
+        {
+            matrix->addSample( xMap.transform( sample.x ),
+                yMap.transform( sample.y ), sample.vx, sample.vy );
+        }
+    }
+}
+
 class QwtPlotVectorField::PrivateData
 {
   public:
@@ -266,6 +320,7 @@ class QwtPlotVectorField::PrivateData
         , minArrowLength( 0.0 )
         , maxArrowLength( std::numeric_limits< short >::max() )
         , magnitudeModes( MagnitudeAsLength )
+        , boundingRect( 0.0, 0.0, -1.0, -1.0 )
     {
         colorMap = NULL;
         symbol = new QwtVectorFieldThinArrow();
@@ -300,6 +355,9 @@ class QwtPlotVectorField::PrivateData
 
     PaintAttributes paintAttributes;
     MagnitudeModes magnitudeModes;
+
+    // cached, as QwtSeriesData::boundingRect() might iterate over all samples
+    QRectF boundingRect;
 };
 
 /*!
@@ -763,6 +821,12 @@ double QwtPlotVectorField::arrowLength( double magnitude ) const
     return length;
 }
 
+/*!
+   \return Bounding rectangle of the positions of the samples
+
+   The rectangle is cached until the data has been changed.
+   \sa dataChanged()
+ */
 QRectF QwtPlotVectorField::boundingRect() const
 {
 #if 0
@@ -773,7 +837,10 @@ QRectF QwtPlotVectorField::boundingRect() const
      */
 #endif
 
-    return QwtPlotSeriesItem::boundingRect();
+    if ( m_data->boundingRect.width() < 0.0 )
+        m_data->boundingRect = QwtPlotSeriesItem::boundingRect();
+
+    return m_data->boundingRect;
 }
 
 /*!
@@ -873,6 +940,13 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
 
     const QwtSeriesData< QwtVectorFieldSample >* series = data();
 
+    const bool doBatch = ( m_data->paintAttributes & BatchedSymbols )
+        && !m_data->symbol->path().isEmpty();
+
+    // positions and vectors for BatchedSymbols
+    QVector< QPointF > points;
+    QVector< QPointF > vectors;
+
     if ( m_data->magnitudeModes & MagnitudeAsColor )
     {
         // user input error, can't draw without color map
@@ -913,14 +987,66 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
         FilterMatrix matrix( dataRect, canvasRect, canvasRasterSize );
 #endif
 
-        for ( int i = from; i <= to; i++ )
+        uint numThreads = renderThreadCount();
+
+#if QWT_USE_THREADS
+        if ( numThreads == 0 )
+            numThreads = QThread::idealThreadCount();
+
+        // no need for more matrices, than we have chunks of a reasonable size
+        const int minChunkSize = 10000;
+        numThreads = qBound( 1u, numThreads, uint( ( to - from + 1 ) / minChunkSize + 1 ) );
+#else
+        numThreads = 1;
+#endif
+
+        QwtVectorFieldFilterCommand command;
+        command.series = series;
+
+        if ( numThreads > 1 )
         {
-            const QwtVectorFieldSample sample = series->sample( i );
-            if ( !sample.isNull() )
+#if QWT_USE_THREADS
+            // each thread bins into its own matrix, that are merged at the end
+
+            QVector< FilterMatrix* > matrices;
+            for ( uint i = 1; i < numThreads; i++ )
+                matrices += new FilterMatrix( dataRect, canvasRect, m_data->rasterSize );
+
+            const int numSamples = ( to - from + 1 ) / numThreads;
+
+            QList< QFuture< void > > futures;
+            for ( uint i = 0; i < numThreads; i++ )
             {
-                matrix.addSample( xMap.transform( sample.x ),
-                    yMap.transform( sample.y ), sample.vx, sample.vy );
+                command.from = from + i * numSamples;
+
+                if ( i == numThreads - 1 )
+                {
+                    command.to = to;
+                    qwtFilterVectors( xMap, yMap, command, &matrix );
+                }
+                else
+                {
+                    command.to = command.from + numSamples - 1;
+                    futures += QtConcurrent::run( &qwtFilterVectors,
+                        xMap, yMap, command, matrices[i] );
+                }
             }
+
+            for ( int i = 0; i < futures.size(); i++ )
+                futures[i].waitForFinished();
+
+            for ( int i = 0; i < matrices.size(); i++ )
+                matrix.merge( *matrices[i] );
+
+            qDeleteAll( matrices );
+#endif
+        }
+        else
+        {
+            command.from = from;
+            command.to = to;
+
+            qwtFilterVectors( xMap, yMap, command, &matrix );
         }
 
         const int numEntries = matrix.numRows() * matrix.numColumns();
@@ -945,8 +1071,16 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
             const double vx = entry.vx / entry.count;
             const double vy = entry.vy / entry.count;
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
+            if ( doBatch )
+            {
+                points += QPointF( xi, yi );
+                vectors += QPointF( isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
+            }
+            else
+            {
+                drawSymbol( painter, xi, yi,
+                    isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
+            }
         }
     }
     else
@@ -974,11 +1108,23 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
                     continue;
             }
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -sample.vx : sample.vx,
-                isInvertingY ? -sample.vy : sample.vy );
+            if ( doBatch )
+            {
+                points += QPointF( xi, yi );
+                vectors += QPointF( isInvertingX ? -sample.vx : sample.vx,
+                    isInvertingY ? -sample.vy : sample.vy );
+            }
+            else
+            {
+                drawSymbol( painter, xi, yi,
+                    isInvertingX ? -sample.vx : sample.vx,
+                    isInvertingY ? -sample.vy : sample.vy );
+            }
         }
     }
+
+    if ( doBatch )
+        drawBatchedSymbols( painter, points, vectors );
 }
 
 /*!
@@ -1048,8 +1194,103 @@ void QwtPlotVectorField::drawSymbol( QPainter* painter,
     painter->setWorldTransform( oldTransform, false );
 }
 
+/*!
+   Draw arrows collected in one path, or one path for each color
+   in MagnitudeAsColor mode.
+
+   \param painter Painter
+   \param points Positions of the arrows in paint device coordinates
+   \param vectors Vectors of the corresponding samples
+
+   \sa BatchedSymbols, drawSymbol()
+ */
+void QwtPlotVectorField::drawBatchedSymbols( QPainter* painter,
+    const QVector< QPointF >& points, const QVector< QPointF >& vectors ) const
+{
+    QwtVectorFieldSymbol* symbol = m_data->symbol;
+
+    const bool doColor = m_data->magnitudeModes & MagnitudeAsColor;
+
+    /*
+        Colors are quantized to a table, so that arrows with the
+        same color can be collected in the same path
+     */
+    const int numColors = doColor ? 256 : 1;
+
+    QwtInterval range;
+    QVector< QRgb > colorTable;
+
+    if ( doColor )
+    {
+        range = m_data->magnitudeRange;
+        if ( !range.isValid() )
+        {
+            if ( !m_data->boundingMagnitudeRange.isValid() )
+                m_data->boundingMagnitudeRange = qwtMagnitudeRange( data() );
+
+            range = m_data->boundingMagnitudeRange;
+        }
+
+        colorTable = m_data->colorMap->colorTable( numColors );
+    }
+
+    QVector< QPainterPath > paths( numColors );
+    for ( int i = 0; i < numColors; i++ )
+        paths[i].setFillRule( Qt::WindingFill );
+
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const double vx = vectors[i].x();
+        const double vy = vectors[i].y();
+
+        const double magnitude = qwtVector2Magnitude( vx, vy );
+
+        QTransform transform = qwtSymbolTransformation( QTransform(),
+            points[i].x(), points[i].y(), vx, vy, magnitude );
+
+        double length = 0.0;
+        if ( m_data->magnitudeModes & MagnitudeAsLength )
+            length = arrowLength( magnitude );
+
+        symbol->setLength( length );
+
+        if( m_data->indicatorOrigin == OriginTail )
+            transform.translate( symbol->length(), 0.0 );
+        else if ( m_data->indicatorOrigin == OriginCenter )
+            transform.translate( 0.5 * symbol->length(), 0.0 );
+
+        int index = 0;
+        if ( doColor && range.width() > 0.0 )
+        {
+            double ratio = ( magnitude - range.minValue() ) / range.width();
+            ratio = qBound( 0.0, ratio, 1.0 );
+
+            index = qRound( ratio * ( numColors - 1 ) );
+        }
+
+        paths[index].addPath( transform.map( symbol->path() ) );
+    }
+
+    for ( int i = 0; i < numColors; i++ )
+    {
+        if ( paths[i].isEmpty() )
+            continue;
+
+        if ( doColor )
+        {
+            const QColor c = QColor::fromRgba( colorTable[i] );
+
+            painter->setBrush( c );
+            painter->setPen( c );
+        }
+
+        painter->drawPath( paths[i] );
+    }
+}
+
 void QwtPlotVectorField::dataChanged()
 {
     m_data->boundingMagnitudeRange.invalidate();
+    m_data->boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     QwtPlotSeriesItem::dataChanged();
 }
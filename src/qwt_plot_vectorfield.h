@@ -78,7 +78,19 @@ class QWT_EXPORT QwtPlotVectorField
 
             \sa setRasterSize()
          */
-        FilterVectors        = 0x01
+        FilterVectors        = 0x01,
+
+        /*
+            BatchedSymbols collects the arrows in one QPainterPath,
+            that is painted in one operation - or one path for each
+            color in MagnitudeAsColor mode.
+
+            This is significantly faster for large fields, but only possible
+            for symbols implementing QwtVectorFieldSymbol::path().
+            Overlapping arrows are united, what might have a minor visual
+            effect for arrows with an outline.
+         */
+        BatchedSymbols       = 0x02
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -176,6 +188,9 @@ class QWT_EXPORT QwtPlotVectorField
   private:
     void init();
 
+    void drawBatchedSymbols( QPainter*, const QVector< QPointF >& points,
+        const QVector< QPointF >& vectors ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -31,6 +31,7 @@
 #include "qwt_series_data.h"
 
 #include <cstring>
+#include <typeinfo>
 
 /*!
    \brief Interface for iterating over two QVector<T> objects.
@@ -45,6 +46,7 @@ public:
 
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample(size_t index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
 
     const QVector< T >& xData() const;
     const QVector< T >& yData() const;
@@ -65,6 +67,7 @@ public:
 
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample(size_t index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
 
     const T* xData() const;
     const T* yData() const;
@@ -270,6 +273,28 @@ QPointF QwtPointArrayData< T >::sample(size_t index) const
     return QPointF(m_x[ int(index) ], m_y[ int(index) ]);
 }
 
+/*!
+   \brief Calculate the bounding rectangle
+
+   The bounding rectangle is calculated once from the coordinate
+   arrays and is stored for all following requests.
+
+   \return Bounding rectangle
+ */
+template< typename T >
+QRectF QwtPointArrayData< T >::boundingRect() const
+{
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample()
+        if (typeid(*this) == typeid(QwtPointArrayData< T >))
+            cachedBoundingRect = qwtBoundingRect(m_x.constData(), m_y.constData(), size());
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
+
+    return cachedBoundingRect;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const QVector< T >& QwtPointArrayData< T >::xData() const
@@ -374,6 +399,28 @@ QPointF QwtCPointerData< T >::sample(size_t index) const
     return QPointF(m_x[ int(index) ], m_y[ int(index) ]);
 }
 
+/*!
+   \brief Calculate the bounding rectangle
+
+   The bounding rectangle is calculated once from the coordinate
+   arrays and is stored for all following requests.
+
+   \return Bounding rectangle
+ */
+template< typename T >
+QRectF QwtCPointerData< T >::boundingRect() const
+{
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample()
+        if (typeid(*this) == typeid(QwtCPointerData< T >))
+            cachedBoundingRect = qwtBoundingRect(m_x, m_y, m_size);
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
+
+    return cachedBoundingRect;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const T* QwtCPointerData< T >::xData() const
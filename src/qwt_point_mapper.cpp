@@ -29,6 +29,9 @@
 #include "qwt_pixel_matrix.h"
 #include "qwt_series_data.h"
 #include "qwt_math.h"
+#include "qwt_color_map.h"
+#include "qwt_clipper.h"
+#include "qwt_render_stats.h"
 
 #include <qpolygon.h>
 #include <qimage.h>
@@ -323,6 +326,323 @@ qwtRenderDots(const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QwtDotsCom
     }
 }
 
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtDensityCommand
+{
+public:
+    const QwtSeriesData< QPointF >* series;
+    int from;
+    int to;
+    QRect rect;
+};
+
+static void
+qwtAccumulateDensity(const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QwtDensityCommand& command, quint32* counts)
+{
+    const int w = command.rect.width();
+    const int h = command.rect.height();
+
+    const int x0 = command.rect.x();
+    const int y0 = command.rect.y();
+
+    for (int i = command.from; i <= command.to; i++) {
+        const QPointF sample = command.series->sample(i);
+        // check nan/检查 NaN
+        if (qwt_is_nan_or_inf(sample)) {
+            continue;
+        }
+        const int x = static_cast< int >(xMap.transform(sample.x()) + 0.5) - x0;
+        const int y = static_cast< int >(yMap.transform(sample.y()) + 0.5) - y0;
+
+        if (x >= 0 && x < w && y >= 0 && y < h)
+            counts[ y * w + x ]++;
+    }
+}
+
+static void qwtMergeDensity(QVector< quint32 >* buffers, int numBuffers, int from, int to)
+{
+    quint32* counts = buffers[ 0 ].data();
+
+    for (int i = 1; i < numBuffers; i++) {
+        const quint32* other = buffers[ i ].constData();
+        for (int j = from; j < to; j++)
+            counts[ j ] += other[ j ];
+    }
+}
+
+class QwtDensityMapCommand
+{
+public:
+    const quint32* counts;
+    const QVector< double >* levels;
+    const QVector< QRgb >* colorTable;
+    QRgb* bits;
+};
+
+static void qwtMapDensity(const QwtDensityMapCommand& command, int from, int to)
+{
+    const QRgb* table   = command.colorTable->constData();
+    const double* steps = command.levels->constData();
+    const int numLevels = command.levels->size();
+
+    for (int i = from; i < to; i++) {
+        const quint32 count = command.counts[ i ];
+        if (count == 0)
+            continue;
+
+        if (count < static_cast< quint32 >(numLevels)) {
+            command.bits[ i ] = table[ qRound(steps[ count ]) ];
+        } else {
+            command.bits[ i ] = table[ 255 ];
+        }
+    }
+}
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtLinesCommand
+{
+public:
+    const QVector< QPolygonF >* runs;
+    QRgb* bits;
+    int width;
+    QRgb rgb;  // premultiplied
+    bool antialiased;
+};
+
+// A band of rows of an image, where a thread is allowed to write to
+class QwtLineBand
+{
+public:
+    inline void plot(int x, int y, double coverage) const
+    {
+        if (x < 0 || x >= width || y < top || y >= bottom)
+            return;
+
+        const uint c = static_cast< uint >(coverage * 256.0 + 0.5);
+        if (c == 0)
+            return;
+
+        blend(bits + y * width + x, qMin(c, 256u));
+    }
+
+    // plot in coordinates, where x is the major axis of the line
+    inline void plot(bool steep, int major, int minor, double coverage) const
+    {
+        if (steep)
+            plot(minor, major, coverage);
+        else
+            plot(major, minor, coverage);
+    }
+
+    QRgb* bits;
+    int width;
+    int top;
+    int bottom;
+    QRgb rgb;
+
+private:
+    inline void blend(QRgb* pixel, uint coverage) const
+    {
+        const uint a   = (qAlpha(rgb) * coverage) >> 8;
+        const uint inv = 255 - a;
+
+        const QRgb dst = *pixel;
+        *pixel         = qRgba(((qRed(rgb) * coverage) >> 8) + (qRed(dst) * inv + 127) / 255,
+                       ((qGreen(rgb) * coverage) >> 8) + (qGreen(dst) * inv + 127) / 255,
+                       ((qBlue(rgb) * coverage) >> 8) + (qBlue(dst) * inv + 127) / 255,
+                       a + (qAlpha(dst) * inv + 127) / 255);
+    }
+};
+
+static inline double qwtFractF(double value)
+{
+    return value - std::floor(value);
+}
+
+/*
+    Limit [from, to] to the positions of the major axis, where
+    minor = minor0 + gradient * ( major - major0 ) is inside of [minorMin, minorMax]
+ */
+static inline bool
+qwtClipMajorRange(double major0, double minor0, double gradient, double minorMin, double minorMax, int& from, int& to)
+{
+    if (gradient == 0.0) {
+        if (minor0 < minorMin || minor0 > minorMax)
+            return false;
+    } else {
+        double m1 = major0 + (minorMin - minor0) / gradient;
+        double m2 = major0 + (minorMax - minor0) / gradient;
+        if (m1 > m2)
+            qSwap(m1, m2);
+
+        if (m1 > to || m2 < from)
+            return false;
+
+        if (m1 > from)
+            from = static_cast< int >(std::floor(m1));
+
+        if (m2 < to)
+            to = static_cast< int >(std::ceil(m2));
+    }
+
+    return from <= to;
+}
+
+/*
+    Xiaolin Wu's line algorithm. Coordinates are in pixels,
+    where the center of a pixel is at integer positions.
+ */
+static void qwtDrawLineWu(const QwtLineBand& band, double x0, double y0, double x1, double y1)
+{
+    const bool steep = qAbs(y1 - y0) > qAbs(x1 - x0);
+    if (steep) {
+        qSwap(x0, y0);
+        qSwap(x1, y1);
+    }
+
+    if (x0 > x1) {
+        qSwap(x0, x1);
+        qSwap(y0, y1);
+    }
+
+    const double dx       = x1 - x0;
+    const double gradient = (dx == 0.0) ? 1.0 : (y1 - y0) / dx;
+
+    // first end point
+    double xEnd = std::floor(x0 + 0.5);
+    double yEnd = y0 + gradient * (xEnd - x0);
+    double xGap = 1.0 - qwtFractF(x0 + 0.5);
+
+    const int xPixel1 = static_cast< int >(xEnd);
+    int yPixel        = static_cast< int >(std::floor(yEnd));
+
+    band.plot(steep, xPixel1, yPixel, (1.0 - qwtFractF(yEnd)) * xGap);
+    band.plot(steep, xPixel1, yPixel + 1, qwtFractF(yEnd) * xGap);
+
+    const double intery0 = yEnd + gradient;
+
+    // second end point
+    xEnd = std::floor(x1 + 0.5);
+    yEnd = y1 + gradient * (xEnd - x1);
+    xGap = qwtFractF(x1 + 0.5);
+
+    const int xPixel2 = static_cast< int >(xEnd);
+    yPixel            = static_cast< int >(std::floor(yEnd));
+
+    band.plot(steep, xPixel2, yPixel, (1.0 - qwtFractF(yEnd)) * xGap);
+    band.plot(steep, xPixel2, yPixel + 1, qwtFractF(yEnd) * xGap);
+
+    // the span between the end points, limited to the pixels of the band
+    int from = xPixel1 + 1;
+    int to   = xPixel2 - 1;
+
+    if (steep) {
+        from = qMax(from, band.top);
+        to   = qMin(to, band.bottom - 1);
+    } else {
+        from = qMax(from, 0);
+        to   = qMin(to, band.width - 1);
+    }
+
+    const double minorMin = steep ? -1.0 : band.top - 1.0;
+    const double minorMax = steep ? band.width : band.bottom;
+
+    if (!qwtClipMajorRange(xPixel1 + 1, intery0, gradient, minorMin, minorMax, from, to))
+        return;
+
+    for (int x = from; x <= to; x++) {
+        const double intery = intery0 + gradient * (x - xPixel1 - 1);
+        const int y         = static_cast< int >(std::floor(intery));
+        const double f      = intery - y;
+
+        band.plot(steep, x, y, 1.0 - f);
+        band.plot(steep, x, y + 1, f);
+    }
+}
+
+/*
+    Aliased line. The start point is left out, when it has already
+    been painted as end point of the previous segment.
+ */
+static void qwtDrawLineAliased(const QwtLineBand& band, double x0, double y0, double x1, double y1, bool skipStart)
+{
+    const bool steep = qAbs(y1 - y0) > qAbs(x1 - x0);
+    if (steep) {
+        qSwap(x0, y0);
+        qSwap(x1, y1);
+    }
+
+    bool skipEnd = false;
+    if (x0 > x1) {
+        qSwap(x0, x1);
+        qSwap(y0, y1);
+        qSwap(skipStart, skipEnd);
+    }
+
+    const double dx       = x1 - x0;
+    const double gradient = (dx == 0.0) ? 0.0 : (y1 - y0) / dx;
+
+    int from = static_cast< int >(std::floor(x0 + 0.5));
+    int to   = static_cast< int >(std::floor(x1 + 0.5));
+
+    if (skipStart)
+        from++;
+
+    if (skipEnd)
+        to--;
+
+    if (steep) {
+        from = qMax(from, band.top);
+        to   = qMin(to, band.bottom - 1);
+    } else {
+        from = qMax(from, 0);
+        to   = qMin(to, band.width - 1);
+    }
+
+    const double minorMin = steep ? -0.5 : band.top - 0.5;
+    const double minorMax = steep ? band.width - 0.5 : band.bottom - 0.5;
+
+    if (!qwtClipMajorRange(x0, y0, gradient, minorMin, minorMax, from, to))
+        return;
+
+    for (int x = from; x <= to; x++) {
+        const int y = static_cast< int >(std::floor(y0 + gradient * (x - x0) + 0.5));
+        band.plot(steep, x, y, 1.0);
+    }
+}
+
+static void qwtRenderLines(const QwtLinesCommand& command, int top, int bottom)
+{
+    QwtLineBand band;
+    band.bits   = command.bits;
+    band.width  = command.width;
+    band.top    = top;
+    band.bottom = bottom;
+    band.rgb    = command.rgb;
+
+    const QVector< QPolygonF >& runs = *command.runs;
+    for (int i = 0; i < runs.size(); i++) {
+        const QPointF* points = runs[ i ].constData();
+        const int numPoints   = runs[ i ].size();
+
+        for (int j = 1; j < numPoints; j++) {
+            const QPointF& p0 = points[ j - 1 ];
+            const QPointF& p1 = points[ j ];
+
+            // segments, that don't touch the band
+            if (qMax(p0.y(), p1.y()) < top - 1.0 || qMin(p0.y(), p1.y()) > bottom)
+                continue;
+
+            if (command.antialiased)
+                qwtDrawLineWu(band, p0.x(), p0.y(), p1.x(), p1.y());
+            else
+                qwtDrawLineAliased(band, p0.x(), p0.y(), p1.x(), p1.y(), j > 1);
+        }
+    }
+}
+
 // some functors, so that the compile can inline
 struct QwtRoundI
 {
@@ -650,6 +970,14 @@ QRectF QwtPointMapper::boundingRect() const
     return m_data->boundingRect;
 }
 
+static inline void qwtRecordSamples(int from, int to, int numPoints)
+{
+    // mappings done in worker threads are not recorded
+    QwtRenderStats* stats = QwtRenderStats::active();
+    if (stats && to >= from)
+        stats->addSamples(to - from + 1, numPoints);
+}
+
 /*!
    \brief Translate a series of points into a QPolygonF
 
@@ -695,6 +1023,8 @@ QPolygonF QwtPointMapper::toPolygonF(const QwtScaleMap& xMap,
         }
     }
 
+    qwtRecordSamples(from, to, polyline.size());
+
     return polyline;
 }
 
@@ -729,6 +1059,8 @@ QPolygon QwtPointMapper::toPolygon(const QwtScaleMap& xMap,
         polyline = qwtToPointsI(qwtInvalidRect, xMap, yMap, series, from, to);
     }
 
+    qwtRecordSamples(from, to, polyline.size());
+
     return polyline;
 }
 
@@ -796,6 +1128,8 @@ QPolygonF QwtPointMapper::toPointsF(const QwtScaleMap& xMap,
         }
     }
 
+    qwtRecordSamples(from, to, points.size());
+
     return points;
 }
 
@@ -843,6 +1177,8 @@ QPolygon QwtPointMapper::toPoints(const QwtScaleMap& xMap,
         points = qwtToPointsI(m_data->boundingRect, xMap, yMap, series, from, to);
     }
 
+    qwtRecordSamples(from, to, points.size());
+
     return points;
 }
 
@@ -926,6 +1262,7 @@ QImage QwtPointMapper::toImage(const QwtScaleMap& xMap,
 
         qwtRenderDots(xMap, yMap, command, rect.topLeft(), &image);
 #endif
+        qwtRecordSamples(from, to, 0);
     } else {
         // fallback implementation: to be replaced later by
         // setting the pixels of the image like above, TODO ...
@@ -945,3 +1282,300 @@ QImage QwtPointMapper::toImage(const QwtScaleMap& xMap,
 
     return image;
 }
+
+/*!
+   \brief Translate a series into a density image
+
+   Instead of setting the pixels of the image to a fixed color, like
+   toImage() does, the number of points being mapped to each pixel
+   is counted. The counts are translated into colors using a color map,
+   so that the distribution of the points remains visible, even when
+   millions of them are overlapping.
+
+   The counting is done in per thread buffers, that are summed up
+   at the end - no locking is involved.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param colorMap Color map, translating the normalized counts [0.0, 1.0]
+                   into colors. Pixels without any hit remain transparent.
+   \param scaling Linear or logarithmic scaling of the counts
+   \param numThreads Number of threads to be used for rendering.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \return Image displaying the density of the series
+   \sa toImage(), boundingRect()
+ */
+QImage QwtPointMapper::toDensityImage(const QwtScaleMap& xMap,
+                                      const QwtScaleMap& yMap,
+                                      const QwtSeriesData< QPointF >* series,
+                                      int from,
+                                      int to,
+                                      const QwtColorMap& colorMap,
+                                      DensityScaling scaling,
+                                      uint numThreads) const
+{
+#if QWT_USE_THREADS
+    if (numThreads == 0)
+        numThreads = QThread::idealThreadCount();
+
+    if (numThreads <= 0)
+        numThreads = 1;
+#else
+    numThreads = 1;
+#endif
+
+    const QRect rect = m_data->boundingRect.toAlignedRect();
+
+    QImage image(rect.size(), QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+
+    const int numPixels = rect.width() * rect.height();
+    if (numPixels <= 0 || from > to)
+        return image;
+
+    // no need for more buffers, than we have chunks of a reasonable size
+    const int minChunkSize = 10000;
+    numThreads = qBound(1u, numThreads, uint((to - from + 1) / minChunkSize + 1));
+
+    QVector< QVector< quint32 > > buffers(numThreads);
+    for (uint i = 0; i < numThreads; i++)
+        buffers[ i ].fill(0, numPixels);
+
+    QwtDensityCommand command;
+    command.series = series;
+    command.rect   = rect;
+
+#if QWT_USE_THREADS
+    if (numThreads > 1) {
+        const int numPoints = (to - from + 1) / numThreads;
+
+        QList< QFuture< void > > futures;
+        for (uint i = 0; i < numThreads; i++) {
+            const int index0 = from + i * numPoints;
+
+            command.from = index0;
+            command.to   = (i == numThreads - 1) ? to : index0 + numPoints - 1;
+
+            if (i == numThreads - 1) {
+                qwtAccumulateDensity(xMap, yMap, command, buffers[ i ].data());
+            } else {
+                futures += QtConcurrent::run(&qwtAccumulateDensity, xMap, yMap, command, buffers[ i ].data());
+            }
+        }
+        for (int i = 0; i < futures.size(); i++)
+            futures[ i ].waitForFinished();
+
+        // summing up the buffers, each thread is responsible for a band of pixels
+        futures.clear();
+
+        const int numMergePixels = numPixels / numThreads;
+        for (uint i = 0; i < numThreads; i++) {
+            const int pixel0 = i * numMergePixels;
+            const int pixel1 = (i == numThreads - 1) ? numPixels : pixel0 + numMergePixels;
+
+            if (i == numThreads - 1) {
+                qwtMergeDensity(buffers.data(), numThreads, pixel0, pixel1);
+            } else {
+                futures += QtConcurrent::run(&qwtMergeDensity, buffers.data(), int(numThreads), pixel0, pixel1);
+            }
+        }
+        for (int i = 0; i < futures.size(); i++)
+            futures[ i ].waitForFinished();
+    } else
+#endif
+    {
+        command.from = from;
+        command.to   = to;
+
+        qwtAccumulateDensity(xMap, yMap, command, buffers[ 0 ].data());
+    }
+
+    const quint32* counts = buffers[ 0 ].constData();
+
+    quint32 maxCount = 0;
+    for (int i = 0; i < numPixels; i++) {
+        if (counts[ i ] > maxCount)
+            maxCount = counts[ i ];
+    }
+
+    qwtRecordSamples(from, to, 0);
+
+    if (maxCount == 0)
+        return image;
+
+    /*
+        Counts are mapped to an index of a table with 256 colors.
+        As the counts are integers, the index of each count up to
+        maxCount can be precalculated - what avoids calling
+        a log() for every pixel.
+     */
+    const quint32 maxLevels = 1u << 16;
+
+    QVector< double > levels(int(qMin(maxCount, maxLevels - 1) + 1));
+    for (int i = 0; i < levels.size(); i++) {
+        double ratio;
+        if (scaling == LogarithmicDensity)
+            ratio = std::log1p(double(i)) / std::log1p(double(maxCount));
+        else
+            ratio = double(i) / maxCount;
+
+        levels[ i ] = 255.0 * ratio;
+    }
+
+    const QVector< QRgb > colorTable = colorMap.colorTable(256);
+
+    QRgb* bits = reinterpret_cast< QRgb* >(image.bits());
+
+    QwtDensityMapCommand mapCommand;
+    mapCommand.counts     = counts;
+    mapCommand.levels     = &levels;
+    mapCommand.colorTable = &colorTable;
+    mapCommand.bits       = bits;
+
+#if QWT_USE_THREADS
+    if (numThreads > 1) {
+        QList< QFuture< void > > futures;
+
+        const int numMapPixels = numPixels / numThreads;
+        for (uint i = 0; i < numThreads; i++) {
+            const int pixel0 = i * numMapPixels;
+            const int pixel1 = (i == numThreads - 1) ? numPixels : pixel0 + numMapPixels;
+
+            if (i == numThreads - 1) {
+                qwtMapDensity(mapCommand, pixel0, pixel1);
+            } else {
+                futures += QtConcurrent::run(&qwtMapDensity, mapCommand, pixel0, pixel1);
+            }
+        }
+        for (int i = 0; i < futures.size(); i++)
+            futures[ i ].waitForFinished();
+    } else
+#endif
+    {
+        qwtMapDensity(mapCommand, 0, numPixels);
+    }
+
+    if (maxCount >= maxLevels) {
+        // counts beyond the precalculated levels
+        for (int i = 0; i < numPixels; i++) {
+            const quint32 count = counts[ i ];
+            if (count >= maxLevels) {
+                double ratio;
+                if (scaling == LogarithmicDensity)
+                    ratio = std::log1p(double(count)) / std::log1p(double(maxCount));
+                else
+                    ratio = double(count) / maxCount;
+
+                bits[ i ] = colorTable[ qRound(255.0 * ratio) ];
+            }
+        }
+    }
+
+    return image;
+}
+
+/*!
+   \brief Rasterize a series as polyline into an image
+
+   The lines are rasterized without QPainter: with the algorithm of Xiaolin Wu,
+   when antialiased is true, otherwise as aliased lines. This avoids the costs of
+   stroking and filling, that become dominant for polylines with millions of points.
+   The image is split into horizontal bands, that are rendered in parallel without
+   any locking.
+
+   Only the color of the pen is used - the lines are always
+   one pixel wide and solid.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param pen Pen, providing the color of the lines
+   \param antialiased True, when the lines should be antialiased
+   \param numThreads Number of threads to be used for rendering.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \return Image of the size of boundingRect() displaying the polyline
+   \sa toImage(), toPolygonF(), boundingRect()
+ */
+QImage QwtPointMapper::toLineImage(const QwtScaleMap& xMap,
+                                   const QwtScaleMap& yMap,
+                                   const QwtSeriesData< QPointF >* series,
+                                   int from,
+                                   int to,
+                                   const QPen& pen,
+                                   bool antialiased,
+                                   uint numThreads) const
+{
+#if QWT_USE_THREADS
+    if (numThreads == 0)
+        numThreads = QThread::idealThreadCount();
+
+    if (numThreads <= 0)
+        numThreads = 1;
+#else
+    numThreads = 1;
+#endif
+
+    const QRect rect = m_data->boundingRect.toAlignedRect();
+
+    QImage image(rect.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    if (rect.isEmpty() || from >= to)
+        return image;
+
+    // translate into image coordinates, where the center of a pixel is at integer positions
+    QPolygonF polyline = toPolygonF(xMap, yMap, series, from, to);
+    polyline.translate(-rect.x() - 0.5, -rect.y() - 0.5);
+
+    /*
+        Removing the invisible segments also limits the coordinates,
+        so that they can't overflow when being converted to integers
+     */
+    const QRectF clipRect(-2.0, -2.0, rect.width() + 4.0, rect.height() + 4.0);
+    const QVector< QPolygonF > runs = QwtClipper::clippedPolylinesF(clipRect, polyline);
+    if (runs.isEmpty())
+        return image;
+
+    QwtLinesCommand command;
+    command.runs        = &runs;
+    command.bits        = reinterpret_cast< QRgb* >(image.bits());
+    command.width       = image.width();
+    command.rgb         = qPremultiply(pen.color().rgba());
+    command.antialiased = antialiased;
+
+    const int h = image.height();
+
+#if QWT_USE_THREADS
+    numThreads = qMin(numThreads, uint(h));
+    if (numThreads > 1) {
+        QList< QFuture< void > > futures;
+
+        for (uint i = 0; i < numThreads; i++) {
+            const int top    = i * h / numThreads;
+            const int bottom = (i + 1) * h / numThreads;
+
+            if (i == numThreads - 1) {
+                qwtRenderLines(command, top, bottom);
+            } else {
+                futures += QtConcurrent::run(&qwtRenderLines, command, top, bottom);
+            }
+        }
+        for (int i = 0; i < futures.size(); i++)
+            futures[ i ].waitForFinished();
+    } else
+#endif
+    {
+        qwtRenderLines(command, 0, h);
+    }
+
+    return image;
+}
@@ -38,6 +38,7 @@ class QRectF;
 class QPolygon;
 class QPen;
 class QImage;
+class QwtColorMap;
 
 /*!
    \brief A helper class for translating a series of points
@@ -88,6 +89,22 @@ public:
 
     Q_DECLARE_FLAGS(TransformationFlags, TransformationFlag)
 
+    /*!
+       \brief Scaling of the hit counts in toDensityImage()
+       \sa toDensityImage()
+     */
+    enum DensityScaling
+    {
+        //! The color is proportional to the number of hits of a pixel
+        LinearDensity,
+
+        /*!
+           The color is proportional to log( 1 + hits ). Useful when
+           a few pixels collect most of the points.
+         */
+        LogarithmicDensity
+    };
+
     QwtPointMapper();
     ~QwtPointMapper();
 
@@ -121,6 +138,24 @@ public:
                    bool antialiased,
                    uint numThreads) const;
 
+    QImage toDensityImage(const QwtScaleMap& xMap,
+                          const QwtScaleMap& yMap,
+                          const QwtSeriesData< QPointF >* series,
+                          int from,
+                          int to,
+                          const QwtColorMap&,
+                          DensityScaling,
+                          uint numThreads) const;
+
+    QImage toLineImage(const QwtScaleMap& xMap,
+                       const QwtScaleMap& yMap,
+                       const QwtSeriesData< QPointF >* series,
+                       int from,
+                       int to,
+                       const QPen&,
+                       bool antialiased,
+                       uint numThreads) const;
+
 private:
     Q_DISABLE_COPY(QwtPointMapper)
 
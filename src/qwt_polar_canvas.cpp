@@ -9,6 +9,7 @@
 #include "qwt_polar_canvas.h"
 #include "qwt_polar_plot.h"
 #include "qwt_painter.h"
+#include "qwt_render_stats.h"
 
 #include <qpainter.h>
 #include <qevent.h>
@@ -145,7 +146,12 @@ void QwtPolarCanvas::paintEvent(QPaintEvent* event)
 
     if ((m_data->paintAttributes & BackingStore) && m_data->backingStore != NULL) {
         QPixmap& bs = *m_data->backingStore;
-        if (bs.size() != size()) {
+
+        const bool isValid = (bs.size() == size());
+        if (plot() && plot()->renderStats())
+            plot()->renderStats()->addCacheAccess(QwtRenderStats::CanvasCache, isValid);
+
+        if (!isValid) {
             bs = QPixmap(size());
 #ifdef Q_WS_X11
             if (bs.x11Info().screen() != x11Info().screen())
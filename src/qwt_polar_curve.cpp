@@ -407,10 +407,14 @@ void QwtPolarCurve::drawLines(QPainter* painter,
     if (!clipRect.isEmpty()) {
         double off = qCeil(qMax(qreal(1.0), painter->pen().widthF()));
         clipRect   = clipRect.toRect().adjusted(-off, -off, off, off);
-        QwtClipper::clipPolygonF(clipRect, polyline);
-    }
 
-    QwtPainter::drawPolyline(painter, polyline);
+        // draw the visible runs only
+        const QVector< QPolygonF > runs = QwtClipper::clippedPolylinesF(clipRect, polyline);
+        for (int i = 0; i < runs.size(); i++)
+            QwtPainter::drawPolyline(painter, runs[ i ]);
+    } else {
+        QwtPainter::drawPolyline(painter, polyline);
+    }
 }
 
 /*!
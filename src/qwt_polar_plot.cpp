@@ -17,7 +17,9 @@
 #include "qwt_legend.h"
 #include "qwt_dyngrid_layout.h"
 #include "qwt_math.h"
+#include "qwt_render_stats.h"
 #include <qpointer.h>
+#include <qscopedpointer.h>
 #include <qpaintengine.h>
 #include <qpainter.h>
 #include <qevent.h>
@@ -69,6 +71,8 @@ public:
     double azimuthOrigin;
 
     QwtPolarLayout* layout;
+
+    QScopedPointer< QwtRenderStats > renderStats;
 };
 
 /*!
@@ -894,7 +898,79 @@ void QwtPolarPlot::drawCanvas(QPainter* painter, const QRectF& canvasRect) const
         painter->restore();
     }
 
+    QwtRenderStats* stats = m_data->renderStats.data();
+    QwtRenderStats* previousStats = NULL;
+    if (stats) {
+        previousStats = QwtRenderStats::setActive(stats);
+        stats->beginRender();
+    }
+
     drawItems(painter, scaleMap(QwtPolar::Azimuth, radius), scaleMap(QwtPolar::Radius, radius), pr.center(), radius, canvasRect);
+
+    if (stats) {
+        stats->endRender();
+        QwtRenderStats::setActive(previousStats);
+
+        // drawCanvas is const, but reporting the statistics doesn't modify the plot
+        Q_EMIT const_cast< QwtPolarPlot* >(this)->renderStatsUpdated(*stats);
+    }
+}
+
+/*!
+   \brief Enable/Disable the render statistics
+
+   When enabled each render pass of the canvas is recorded and
+   renderStatsUpdated() is emitted afterwards.
+
+   \param on On/Off
+   \sa isRenderStatsEnabled(), renderStats(), QwtRenderStats
+ */
+void QwtPolarPlot::setRenderStatsEnabled(bool on)
+{
+    if (on == isRenderStatsEnabled())
+        return;
+
+    if (on)
+        m_data->renderStats.reset(new QwtRenderStats());
+    else
+        m_data->renderStats.reset();
+}
+
+/*!
+   \return True, when the render statistics are enabled
+   \sa setRenderStatsEnabled()
+ */
+bool QwtPolarPlot::isRenderStatsEnabled() const
+{
+    return !m_data->renderStats.isNull();
+}
+
+/*!
+   \return Render statistics, or NULL when they are disabled
+   \sa setRenderStatsEnabled(), resetRenderStats()
+ */
+QwtRenderStats* QwtPolarPlot::renderStats()
+{
+    return m_data->renderStats.data();
+}
+
+/*!
+   \return Render statistics, or NULL when they are disabled
+   \sa setRenderStatsEnabled(), resetRenderStats()
+ */
+const QwtRenderStats* QwtPolarPlot::renderStats() const
+{
+    return m_data->renderStats.data();
+}
+
+/*!
+   \brief Clear all timings and counters of the render statistics
+   \sa renderStats()
+ */
+void QwtPolarPlot::resetRenderStats()
+{
+    if (m_data->renderStats)
+        m_data->renderStats->reset();
 }
 
 /*!
@@ -951,8 +1027,15 @@ void QwtPolarPlot::drawItems(QPainter* painter,
 
             painter->setRenderHint(QPainter::Antialiasing, item->testRenderHint(QwtPolarItem::RenderAntialiased));
 
+            QwtRenderStats* stats = QwtRenderStats::active();
+            if (stats)
+                stats->beginItem(item->title().text(), item->rtti());
+
             item->draw(painter, azimuthMap, radialMap, pole, radius, canvasRect);
 
+            if (stats)
+                stats->endItem();
+
             painter->restore();
         }
     }
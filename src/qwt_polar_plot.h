@@ -15,6 +15,7 @@
 #include "qwt_interval.h"
 #include "qwt_scale_map.h"
 #include "qwt_point_polar.h"
+#include "qwt_render_stats.h"
 #include <qframe.h>
 
 class QwtRoundScaleDraw;
@@ -139,6 +140,12 @@ class QWT_EXPORT QwtPolarPlot : public QFrame, public QwtPolarItemDict
 
     virtual void drawCanvas( QPainter*, const QRectF& ) const;
 
+    void setRenderStatsEnabled( bool on );
+    bool isRenderStatsEnabled() const;
+    QwtRenderStats* renderStats();
+    const QwtRenderStats* renderStats() const;
+    void resetRenderStats();
+
     // Legend
 
     void insertLegend( QwtAbstractLegend*,
@@ -190,6 +197,15 @@ class QWT_EXPORT QwtPolarPlot : public QFrame, public QwtPolarItemDict
      */
     void layoutChanged();
 
+    /*!
+       A signal that is emitted after each render pass of the canvas,
+       when the render statistics are enabled.
+
+       \param stats Render statistics
+       \sa setRenderStatsEnabled()
+     */
+    void renderStatsUpdated( const QwtRenderStats& stats );
+
   public Q_SLOTS:
     virtual void replot();
     void autoRefresh();
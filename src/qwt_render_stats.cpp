@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_render_stats.h"
+
+// the statistics of the pass, that is running in the current thread
+static thread_local QwtRenderStats* qwtActiveRenderStats = NULL;
+
+//! Constructor
+QwtRenderStats::Item::Item()
+    : rtti( 0 )
+    , renderTime( 0 )
+    , samplesIn( 0 )
+    , samplesOut( 0 )
+{
+}
+
+//! Constructor
+QwtRenderStats::QwtRenderStats()
+{
+    reset();
+}
+
+//! Clear all timings and counters
+void QwtRenderStats::reset()
+{
+    m_renderCount = 0;
+    m_renderTime = 0;
+    m_samplesIn = 0;
+    m_samplesOut = 0;
+
+    for ( int i = 0; i < CacheCount; i++ )
+    {
+        m_cacheHits[i] = 0;
+        m_cacheMisses[i] = 0;
+    }
+
+    m_items.clear();
+    m_currentItem = -1;
+}
+
+//! \return Number of render passes since reset()
+int QwtRenderStats::renderCount() const
+{
+    return m_renderCount;
+}
+
+//! \return Time of the last render pass in nanoseconds
+qint64 QwtRenderStats::renderTime() const
+{
+    return m_renderTime;
+}
+
+//! \return Statistics of the items of the last render pass in painting order
+QVector< QwtRenderStats::Item > QwtRenderStats::items() const
+{
+    return m_items;
+}
+
+//! \return Index of the item with the longest render time, or -1
+int QwtRenderStats::slowestItem() const
+{
+    int index = -1;
+    for ( int i = 0; i < m_items.size(); i++ )
+    {
+        if ( index < 0 || m_items[i].renderTime > m_items[index].renderTime )
+            index = i;
+    }
+
+    return index;
+}
+
+//! \return Number of samples passed to QwtPointMapper in the last render pass
+qint64 QwtRenderStats::samplesIn() const
+{
+    return m_samplesIn;
+}
+
+//! \return Number of points returned from QwtPointMapper in the last render pass
+qint64 QwtRenderStats::samplesOut() const
+{
+    return m_samplesOut;
+}
+
+/*!
+   \return Number of cache hits since reset()
+   \param cache Cache
+ */
+int QwtRenderStats::cacheHits( Cache cache ) const
+{
+    if ( cache < 0 || cache >= CacheCount )
+        return 0;
+
+    return m_cacheHits[cache];
+}
+
+/*!
+   \return Number of cache misses since reset()
+   \param cache Cache
+ */
+int QwtRenderStats::cacheMisses( Cache cache ) const
+{
+    if ( cache < 0 || cache >= CacheCount )
+        return 0;
+
+    return m_cacheMisses[cache];
+}
+
+/*!
+   \return Human readable summary of the last render pass,
+          one line per item
+ */
+QString QwtRenderStats::toString() const
+{
+    QString s = QString( "render #%1: %2 ms, samples %3 -> %4\n" )
+        .arg( m_renderCount ).arg( m_renderTime / 1e6, 0, 'f', 3 )
+        .arg( m_samplesIn ).arg( m_samplesOut );
+
+    for ( int i = 0; i < m_items.size(); i++ )
+    {
+        const Item& item = m_items[i];
+        s += QString( "  %1 (rtti %2): %3 ms, samples %4 -> %5\n" )
+            .arg( item.title ).arg( item.rtti )
+            .arg( item.renderTime / 1e6, 0, 'f', 3 )
+            .arg( item.samplesIn ).arg( item.samplesOut );
+    }
+
+    const char* names[] = { "canvas", "layer", "raster", "symbol" };
+    for ( int i = 0; i < CacheCount; i++ )
+    {
+        s += QString( "  %1 cache: %2 hits, %3 misses\n" )
+            .arg( names[i] ).arg( m_cacheHits[i] ).arg( m_cacheMisses[i] );
+    }
+
+    return s;
+}
+
+/*!
+   \brief Start a render pass
+
+   The items of the previous pass are removed.
+   \sa endRender()
+ */
+void QwtRenderStats::beginRender()
+{
+    m_items.clear();
+    m_currentItem = -1;
+
+    m_samplesIn = 0;
+    m_samplesOut = 0;
+
+    m_renderTimer.start();
+}
+
+/*!
+   \brief Finish a render pass
+   \sa beginRender()
+ */
+void QwtRenderStats::endRender()
+{
+    m_renderTime = m_renderTimer.nsecsElapsed();
+    m_renderCount++;
+}
+
+/*!
+   \brief Start recording an item
+   \param title Title of the item
+   \param rtti Runtime type information of the item
+   \sa endItem()
+ */
+void QwtRenderStats::beginItem( const QString& title, int rtti )
+{
+    Item item;
+    item.title = title;
+    item.rtti = rtti;
+
+    m_items += item;
+    m_currentItem = m_items.size() - 1;
+
+    m_itemTimer.start();
+}
+
+/*!
+   \brief Finish recording an item
+   \sa beginItem()
+ */
+void QwtRenderStats::endItem()
+{
+    if ( m_currentItem >= 0 )
+    {
+        m_items[m_currentItem].renderTime = m_itemTimer.nsecsElapsed();
+        m_currentItem = -1;
+    }
+}
+
+/*!
+   \brief Count samples, that have been mapped by QwtPointMapper
+
+   \param samplesIn Number of samples being mapped
+   \param samplesOut Number of resulting points
+ */
+void QwtRenderStats::addSamples( qint64 samplesIn, qint64 samplesOut )
+{
+    m_samplesIn += samplesIn;
+    m_samplesOut += samplesOut;
+
+    if ( m_currentItem >= 0 )
+    {
+        Item& item = m_items[m_currentItem];
+        item.samplesIn += samplesIn;
+        item.samplesOut += samplesOut;
+    }
+}
+
+/*!
+   \brief Count an access to a cache
+
+   \param cache Cache
+   \param hit True, when the cached content could be reused
+ */
+void QwtRenderStats::addCacheAccess( Cache cache, bool hit )
+{
+    if ( cache < 0 || cache >= CacheCount )
+        return;
+
+    if ( hit )
+        m_cacheHits[cache]++;
+    else
+        m_cacheMisses[cache]++;
+}
+
+/*!
+   \return Statistics of the render pass running in the current thread, or NULL
+   \sa setActive()
+ */
+QwtRenderStats* QwtRenderStats::active()
+{
+    return qwtActiveRenderStats;
+}
+
+/*!
+   \brief Register the statistics of the render pass running in the current thread
+
+   \param stats Statistics, or NULL
+   \return Previously active statistics, that should be restored when the pass is done
+   \sa active()
+ */
+QwtRenderStats* QwtRenderStats::setActive( QwtRenderStats* stats )
+{
+    QwtRenderStats* previous = qwtActiveRenderStats;
+    qwtActiveRenderStats = stats;
+
+    return previous;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RENDER_STATS_H
+#define QWT_RENDER_STATS_H
+
+#include "qwt_global.h"
+
+#include <qstring.h>
+#include <qvector.h>
+#include <qelapsedtimer.h>
+
+/*!
+   \brief Timings and counters of the rendering of a plot
+
+   When the render statistics of a plot are enabled
+   ( QwtPlot::setRenderStatsEnabled(), QwtPolarPlot::setRenderStatsEnabled() )
+   each render pass of the canvas is recorded:
+
+   - the time of the complete pass and of each item
+   - the number of samples being passed to QwtPointMapper and the number
+     of points it returned - f.e. after weeding - for each item
+   - hits and misses of the caches ( canvas backing store, cache layers,
+     raster images, symbol pixmaps )
+
+   The items are reset with each render pass, while the cache counters are
+   accumulated until reset() is called.
+
+   While a pass is running the statistics are registered as active() for the
+   GUI thread, so that code deep inside of the items can report to it without
+   knowing the plot.
+
+   \sa QwtPlot::renderStatsUpdated()
+ */
+class QWT_EXPORT QwtRenderStats
+{
+  public:
+    //! Caches, that report hits and misses
+    enum Cache
+    {
+        //! Backing store of the plot canvas
+        CanvasCache,
+
+        //! Cache layers of QwtPlot::setLayeredCompositing()
+        LayerCache,
+
+        //! Image cache of QwtPlotRasterItem
+        RasterCache,
+
+        //! Pixmap cache of QwtSymbol
+        SymbolCache,
+
+        //! Number of caches
+        CacheCount
+    };
+
+    //! Statistics of an item of the last render pass
+    class QWT_EXPORT Item
+    {
+      public:
+        Item();
+
+        //! Title of the item
+        QString title;
+
+        //! Runtime type information of the item
+        int rtti;
+
+        //! Time in nanoseconds
+        qint64 renderTime;
+
+        //! Number of samples passed to QwtPointMapper
+        qint64 samplesIn;
+
+        //! Number of points returned from QwtPointMapper
+        qint64 samplesOut;
+    };
+
+    QwtRenderStats();
+
+    void reset();
+
+    int renderCount() const;
+    qint64 renderTime() const;
+
+    QVector< Item > items() const;
+    int slowestItem() const;
+
+    qint64 samplesIn() const;
+    qint64 samplesOut() const;
+
+    int cacheHits( Cache ) const;
+    int cacheMisses( Cache ) const;
+
+    QString toString() const;
+
+    void beginRender();
+    void endRender();
+
+    void beginItem( const QString& title, int rtti );
+    void endItem();
+
+    void addSamples( qint64 samplesIn, qint64 samplesOut );
+    void addCacheAccess( Cache, bool hit );
+
+    static QwtRenderStats* active();
+    static QwtRenderStats* setActive( QwtRenderStats* );
+
+  private:
+    int m_renderCount;
+    qint64 m_renderTime;
+    qint64 m_samplesIn;
+    qint64 m_samplesOut;
+
+    int m_cacheHits[ CacheCount ];
+    int m_cacheMisses[ CacheCount ];
+
+    QVector< Item > m_items;
+    int m_currentItem;
+
+    QElapsedTimer m_renderTimer;
+    QElapsedTimer m_itemTimer;
+};
+
+#endif
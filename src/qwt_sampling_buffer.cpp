@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_sampling_buffer.h"
+
+#include <qatomic.h>
+#include <qpoint.h>
+#include <qvector.h>
+
+class QwtSamplingBuffer::PrivateData
+{
+public:
+    PrivateData(int minCapacity)
+        : head(0)
+        , tail(0)
+        , dropped(0)
+    {
+        // a power of 2, so that the indices can wrap around freely
+        quint32 cap = 2;
+        while (cap < quint32(minCapacity) && cap < (1u << 30))
+            cap <<= 1;
+
+        capacity = cap;
+        mask     = cap - 1;
+        points.resize(int(cap));
+    }
+
+    QVector< QPointF > points;
+    quint32 capacity;
+    quint32 mask;
+
+    // head is only written by the producer, tail only by the consumer.
+    // Both are counting up, the position in the ring is index & mask.
+    QAtomicInteger< quint32 > head;
+    QAtomicInteger< quint32 > tail;
+
+    QAtomicInt dropped;
+};
+
+/*!
+   \brief Constructor
+
+   \param capacity Minimum number of samples, that can be stored.
+                   It is rounded up to a power of 2.
+ */
+QwtSamplingBuffer::QwtSamplingBuffer(int capacity)
+{
+    m_data = new PrivateData(capacity);
+}
+
+//! Destructor
+QwtSamplingBuffer::~QwtSamplingBuffer()
+{
+    delete m_data;
+}
+
+//! \return Maximum number of samples in the buffer
+int QwtSamplingBuffer::capacity() const
+{
+    return int(m_data->capacity);
+}
+
+/*!
+   \return Number of samples in the buffer
+
+   As both threads are working on the buffer, the number might be
+   outdated when being used.
+ */
+int QwtSamplingBuffer::size() const
+{
+    const quint32 tail = m_data->tail.loadAcquire();
+    const quint32 head = m_data->head.loadAcquire();
+
+    return int(head - tail);
+}
+
+//! \return True, when the buffer contains no samples
+bool QwtSamplingBuffer::isEmpty() const
+{
+    return size() == 0;
+}
+
+/*!
+   \brief Append a sample, called from the producer thread
+
+   \param point Sample
+   \return False, when the buffer is full and the sample has been dropped
+ */
+bool QwtSamplingBuffer::push(const QPointF& point)
+{
+    return push(&point, 1) == 1;
+}
+
+/*!
+   \brief Append samples, called from the producer thread
+
+   \param points Samples
+   \param count Number of samples
+   \return Number of samples, that have been appended. The others
+           have been dropped, because the buffer is full.
+   \sa droppedCount()
+ */
+int QwtSamplingBuffer::push(const QPointF* points, int count)
+{
+    if (count <= 0)
+        return 0;
+
+    const quint32 head = m_data->head.loadAcquire();
+    const quint32 tail = m_data->tail.loadAcquire();
+
+    const quint32 available = m_data->capacity - (head - tail);
+    const int numPoints     = int(qMin(quint32(count), available));
+
+    QPointF* buffer = m_data->points.data();
+    for (int i = 0; i < numPoints; i++)
+        buffer[ (head + quint32(i)) & m_data->mask ] = points[ i ];
+
+    // publish the samples to the consumer
+    m_data->head.storeRelease(head + quint32(numPoints));
+
+    if (numPoints < count)
+        m_data->dropped.fetchAndAddRelaxed(count - numPoints);
+
+    return numPoints;
+}
+
+/*!
+   \brief Remove samples from the buffer, called from the consumer thread
+
+   \param points Array for the samples
+   \param maxCount Maximum number of samples to be removed
+   \return Number of samples, that have been copied to points
+ */
+int QwtSamplingBuffer::pop(QPointF* points, int maxCount)
+{
+    if (maxCount <= 0)
+        return 0;
+
+    const quint32 tail = m_data->tail.loadAcquire();
+    const quint32 head = m_data->head.loadAcquire();
+
+    const int numPoints = int(qMin(quint32(maxCount), head - tail));
+
+    const QPointF* buffer = m_data->points.constData();
+    for (int i = 0; i < numPoints; i++)
+        points[ i ] = buffer[ (tail + quint32(i)) & m_data->mask ];
+
+    // release the slots to the producer
+    m_data->tail.storeRelease(tail + quint32(numPoints));
+
+    return numPoints;
+}
+
+/*!
+   \brief Remove all samples from the buffer, called from the consumer thread
+   \return Samples in the order they have been pushed
+ */
+QVector< QPointF > QwtSamplingBuffer::takeAll()
+{
+    QVector< QPointF > points(size());
+    points.resize(pop(points.data(), points.size()));
+
+    return points;
+}
+
+/*!
+   \brief Discard all samples, called from the consumer thread
+ */
+void QwtSamplingBuffer::clear()
+{
+    m_data->tail.storeRelease(m_data->head.loadAcquire());
+}
+
+/*!
+   \return Number of samples, that have been dropped because the buffer was full
+   \sa resetDroppedCount()
+ */
+int QwtSamplingBuffer::droppedCount() const
+{
+    return m_data->dropped.loadAcquire();
+}
+
+//! Reset the number of dropped samples
+void QwtSamplingBuffer::resetDroppedCount()
+{
+    m_data->dropped.storeRelease(0);
+}
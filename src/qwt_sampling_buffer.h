@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SAMPLING_BUFFER_H
+#define QWT_SAMPLING_BUFFER_H
+
+#include "qwt_global.h"
+
+class QPointF;
+#if QT_VERSION < 0x060000
+template< typename T >
+class QVector;
+#endif
+
+/*!
+   \brief Lock-free hand-off of samples from a sampling thread to the plot
+
+   QwtSamplingBuffer is a ring buffer for exactly one producer thread -
+   usually a QwtSamplingThread - and one consumer thread, usually the GUI
+   thread polling the buffer from a timer and appending the samples to the
+   data of a curve. Neither side ever waits for the other one.
+
+   When the consumer doesn't keep up and the buffer is full, new samples
+   are dropped and counted - see droppedCount().
+
+   \code
+   // sampling thread
+   void SamplingThread::sampleBlock( const double* timestamps, int count )
+   {
+       QPointF points[256];
+       ...
+       m_buffer->push( points, count );
+   }
+
+   // GUI thread
+   void Plot::timerEvent( QTimerEvent* )
+   {
+       m_data->append( m_buffer->takeAll() );
+       replot();
+   }
+   \endcode
+
+   \sa QwtSamplingThread::sampleBlock()
+ */
+class QWT_EXPORT QwtSamplingBuffer
+{
+public:
+    explicit QwtSamplingBuffer(int capacity = 65536);
+    ~QwtSamplingBuffer();
+
+    int capacity() const;
+
+    int size() const;
+    bool isEmpty() const;
+
+    // producer
+    bool push(const QPointF&);
+    int push(const QPointF* points, int count);
+
+    // consumer
+    int pop(QPointF* points, int maxCount);
+    QVector< QPointF > takeAll();
+    void clear();
+
+    int droppedCount() const;
+    void resetDroppedCount();
+
+private:
+    Q_DISABLE_COPY(QwtSamplingBuffer)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -26,19 +26,48 @@
 
 #include "qwt_sampling_thread.h"
 #include <qelapsedtimer.h>
+#include <qmutex.h>
+#include <qvector.h>
+
+#include <cmath>
+
+// a backlog larger than this is not caught up, but skipped
+static const double qwtSamplingMaxLagNs = 1e9;
 
 class QwtSamplingThread::PrivateData
 {
 public:
+    PrivateData() : msecsInterval(1e3), blockSize(1)
+    {
+        resetStatistics();
+    }
+
+    void resetStatistics()
+    {
+        overruns   = 0;
+        missed     = 0;
+        maxJitter  = 0.0;
+        jitterSum  = 0.0;
+        numWakeups = 0;
+    }
+
     QElapsedTimer timer;
     double msecsInterval;
+    int blockSize;
+
+    // statistics, written by the sampling thread
+    mutable QMutex mutex;
+    int overruns;
+    qint64 missed;
+    double maxJitter;  // ms
+    double jitterSum;  // ms
+    qint64 numWakeups;
 };
 
 //! Constructor
 QwtSamplingThread::QwtSamplingThread(QObject* parent) : QThread(parent)
 {
-    m_data                = new PrivateData;
-    m_data->msecsInterval = 1e3;  // 1 second
+    m_data = new PrivateData;
 }
 
 //! Destructor
@@ -83,6 +112,90 @@ double QwtSamplingThread::elapsed() const
     return 0.0;
 }
 
+/*!
+   \brief Set the number of ticks sampled in one wakeup of the thread
+
+   The thread sleeps until the last tick of a block is due and passes
+   the nominal timestamps of all ticks of the block to sampleBlock().
+   For rates of several kHz a block size, that results in
+   wakeups every few milliseconds, is recommended.
+
+   The default block size is 1.
+
+   \param numTicks Number of ticks of a block
+   \sa blockSize(), sampleBlock()
+ */
+void QwtSamplingThread::setBlockSize(int numTicks)
+{
+    m_data->blockSize = qMax(numTicks, 1);
+}
+
+/*!
+   \return Number of ticks sampled in one wakeup of the thread
+   \sa setBlockSize()
+ */
+int QwtSamplingThread::blockSize() const
+{
+    return m_data->blockSize;
+}
+
+/*!
+   \return Number of blocks, where sampling took longer than the time
+           until the wakeup of the next block was due. With a block size
+           of N this is the time of N ticks minus the sampling itself.
+   \sa resetStatistics()
+ */
+int QwtSamplingThread::overrunCount() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->overruns;
+}
+
+/*!
+   \return Number of ticks, that have been skipped, because the thread
+           fell behind its schedule by more than a second
+   \sa resetStatistics()
+ */
+qint64 QwtSamplingThread::missedCount() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->missed;
+}
+
+/*!
+   \return Maximum delay (in ms) of a wakeup behind its deadline
+   \sa meanJitter(), resetStatistics()
+ */
+double QwtSamplingThread::maxJitter() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->maxJitter;
+}
+
+/*!
+   \return Mean delay (in ms) of the wakeups behind their deadlines
+   \sa maxJitter(), resetStatistics()
+ */
+double QwtSamplingThread::meanJitter() const
+{
+    QMutexLocker locker(&m_data->mutex);
+
+    if (m_data->numWakeups == 0)
+        return 0.0;
+
+    return m_data->jitterSum / m_data->numWakeups;
+}
+
+/*!
+   Reset the jitter and overrun statistics
+   \sa overrunCount(), missedCount(), maxJitter(), meanJitter()
+ */
+void QwtSamplingThread::resetStatistics()
+{
+    QMutexLocker locker(&m_data->mutex);
+    m_data->resetStatistics();
+}
+
 /*!
    Terminate the collecting thread
    \sa QThread::start(), run()
@@ -92,6 +205,24 @@ void QwtSamplingThread::stop()
     m_data->timer.invalidate();
 }
 
+/*!
+   \brief Collect a block of samples
+
+   The default implementation calls sample() for each timestamp.
+   Reimplement it to acquire and store all samples of a block at once,
+   f.e. into a QwtSamplingBuffer.
+
+   \param timestamps Nominal times of the ticks since the thread was started, in seconds
+   \param count Number of timestamps
+
+   \sa setBlockSize(), sample()
+ */
+void QwtSamplingThread::sampleBlock(const double* timestamps, int count)
+{
+    for (int i = 0; i < count; i++)
+        sample(timestamps[ i ]);
+}
+
 /*!
    Loop collecting samples started from QThread::start()
    \sa stop()
@@ -99,24 +230,78 @@ void QwtSamplingThread::stop()
 void QwtSamplingThread::run()
 {
     m_data->timer.start();
+    resetStatistics();
+
+    QVector< double > timestamps;
+
+    // ticks are scheduled at origin + tick * interval
+    double origin          = 0.0;
+    double currentInterval = -1.0;
+    qint64 tick            = 0;
 
-    /*
-        We should have all values in nsecs/qint64, but
-        this would break existing code. TODO ...
-        Anyway - for QThread::usleep we even need microseconds( usecs )
-     */
     while (m_data->timer.isValid()) {
-        const qint64 timestamp = m_data->timer.nsecsElapsed();
-        sample(timestamp / 1e9);  // seconds
+        const int numTicks = m_data->blockSize;
+        timestamps.resize(numTicks);
+
+        const double intervalNs = m_data->msecsInterval * 1e6;
+
+        if (intervalNs <= 0.0) {
+            // free running
+            for (int i = 0; i < numTicks; i++)
+                timestamps[ i ] = m_data->timer.nsecsElapsed() / 1e9;
+
+            sampleBlock(timestamps.constData(), numTicks);
+            currentInterval = -1.0;
+            continue;
+        }
+
+        if (intervalNs != currentInterval) {
+            // start a new schedule, when the interval has been changed
+            origin          = m_data->timer.nsecsElapsed();
+            currentInterval = intervalNs;
+            tick            = 0;
+        }
+
+        // wake up, when the last tick of the block is due
+        const double deadline = origin + (tick + numTicks - 1) * intervalNs;
+
+        const double usecs = (deadline - m_data->timer.nsecsElapsed()) / 1e3;
+        if (usecs > 0.0)
+            QThread::usleep(qRound64(usecs));
+
+        if (!m_data->timer.isValid())
+            break;
+
+        const double lateness = m_data->timer.nsecsElapsed() - deadline;
+
+        for (int i = 0; i < numTicks; i++)
+            timestamps[ i ] = (origin + (tick + i) * intervalNs) / 1e9;
+
+        sampleBlock(timestamps.constData(), numTicks);
+        tick += numTicks;
+
+        const double now = m_data->timer.nsecsElapsed();
+
+        QMutexLocker locker(&m_data->mutex);
+
+        const double jitter = qMax(lateness, 0.0) / 1e6;
+        m_data->maxJitter   = qMax(m_data->maxJitter, jitter);
+        m_data->jitterSum += jitter;
+        m_data->numWakeups++;
 
-        if (m_data->msecsInterval > 0.0) {
-            const double interval = m_data->msecsInterval * 1e3;
-            const double elapsed  = (m_data->timer.nsecsElapsed() - timestamp) / 1e3;
+        // the next wakeup is scheduled for the last tick of the next block
+        const double nextDeadline = origin + (tick + m_data->blockSize - 1) * intervalNs;
 
-            const double usecs = interval - elapsed;
+        if (now > nextDeadline) {
+            // the next block is already overdue
+            m_data->overruns++;
 
-            if (usecs > 0.0)
-                QThread::usleep(qRound(usecs));
+            const double lag = now - nextDeadline;
+            if (lag > qwtSamplingMaxLagNs) {
+                const qint64 skipped = qint64(std::floor(lag / intervalNs));
+                tick += skipped;
+                m_data->missed += skipped;
+            }
         }
     }
 }
@@ -40,7 +40,17 @@
    QwtSamplingThread starts a thread calling periodically sample(),
    to collect and store ( or emit ) a single sample.
 
-   \sa QwtPlotCurve, QwtPlotSeriesItem
+   The ticks are scheduled at absolute deadlines - origin + k * interval() -
+   so that the time needed for sampling and the inaccuracy of sleeping
+   don't accumulate. For high rates the thread can wake up once for a block
+   of blockSize() ticks and pass them to sampleBlock(). A lock-free
+   QwtSamplingBuffer can be used to hand the samples over to the plot.
+
+   The deviation of the wakeups from their deadlines and blocks, that took
+   longer than the interval, are recorded - see maxJitter(), meanJitter()
+   and overrunCount().
+
+   \sa QwtPlotCurve, QwtPlotSeriesItem, QwtSamplingBuffer
  */
 class QWT_EXPORT QwtSamplingThread : public QThread
 {
@@ -52,9 +62,18 @@ class QWT_EXPORT QwtSamplingThread : public QThread
     double interval() const;
     double elapsed() const;
 
+    void setBlockSize( int numTicks );
+    int blockSize() const;
+
+    int overrunCount() const;
+    qint64 missedCount() const;
+    double maxJitter() const;
+    double meanJitter() const;
+
   public Q_SLOTS:
     void setInterval( double interval );
     void stop();
+    void resetStatistics();
 
   protected:
     explicit QwtSamplingThread( QObject* parent = NULL );
@@ -71,6 +90,8 @@ class QWT_EXPORT QwtSamplingThread : public QThread
      */
     virtual void sample( double elapsed ) = 0;
 
+    virtual void sampleBlock( const double* timestamps, int count );
+
   private:
     class PrivateData;
     PrivateData* m_data;
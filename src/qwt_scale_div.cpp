@@ -223,6 +223,45 @@ bool QwtScaleDiv::fuzzyCompare(const QwtScaleDiv& other) const
     return false;
 }
 
+/*!
+   \brief Check if the scale division differs from other by a shift only
+
+   Both divisions need to have the same range and the same step
+   between their ticks. This is f.e the case, when a linear scale
+   is panned without changing its tick step.
+
+   \param other Other scale division
+   \return true, when both divisions have the same range and tick steps
+ */
+bool QwtScaleDiv::isShiftOf( const QwtScaleDiv& other ) const
+{
+    if ( isEmpty() || other.isEmpty() )
+        return false;
+
+    if ( !qFuzzyCompare( range(), other.range() ) )
+        return false;
+
+    for ( int i = 0; i < NTickTypes; i++ )
+    {
+        const QList< double >& ticks1 = m_ticks[i];
+        const QList< double >& ticks2 = other.m_ticks[i];
+
+        if ( ticks1.size() < 2 || ticks2.size() < 2 )
+        {
+            // without 2 ticks we can't compare the steps
+            if ( !( ticks1.isEmpty() && ticks2.isEmpty() ) )
+                return false;
+
+            continue;
+        }
+
+        if ( !qFuzzyCompare( ticks1[1] - ticks1[0], ticks2[1] - ticks2[0] ) )
+            return false;
+    }
+
+    return true;
+}
+
 //! Check if the scale division is empty( lowerBound() == upperBound() )
 bool QwtScaleDiv::isEmpty() const
 {
@@ -33,6 +33,8 @@
 
 #include <qpainter.h>
 #include <qpaintengine.h>
+#include <qimage.h>
+#include <qcache.h>
 #include <qmath.h>
 
 static inline double qwtEffectivePenWidth( const QwtAbstractScaleDraw* scaleDraw )
@@ -288,6 +290,7 @@ class QwtScaleDraw::PrivateData
         , alignment( QwtScaleDraw::BottomScale )
         , labelRotation( 0.0 )
     {
+        labelImages.setMaxCost( 500 );
     }
 
     QPointF pos;
@@ -297,6 +300,9 @@ class QwtScaleDraw::PrivateData
 
     Qt::Alignment labelAlignment;
     double labelRotation;
+
+    // rasterized labels for QwtAbstractScaleDraw::CacheLabelImages
+    mutable QCache< QString, QImage > labelImages;
 };
 
 /*!
@@ -792,6 +798,12 @@ void QwtScaleDraw::drawLabel( QPainter* painter, double value ) const
 
     const QTransform transform = labelTransformation( pos, labelSize );
 
+    if ( testCacheAttribute( QwtAbstractScaleDraw::CacheLabelImages ) )
+    {
+        if ( drawLabelImage( painter, lbl, labelSize, transform ) )
+            return;
+    }
+
     painter->save();
     painter->setWorldTransform( transform, true );
 
@@ -800,6 +812,107 @@ void QwtScaleDraw::drawLabel( QPainter* painter, double value ) const
     painter->restore();
 }
 
+/*!
+   Draw a label from the cache of rasterized labels
+
+   The label is rendered - including its rotation - into an image,
+   that is found again by text, font, color, rotation and device pixel
+   ratio. Then it is blitted aligned to the pixels of the paint device.
+
+   \param painter Painter
+   \param label Label
+   \param labelSize Size of the label
+   \param transform Transformation returned from labelTransformation()
+
+   \return false, when the label can't be drawn from an image. This
+           is the case for vector paint devices, painters with a scaling
+           or rotating transformation or labels with a background.
+
+   \sa QwtAbstractScaleDraw::CacheLabelImages
+ */
+bool QwtScaleDraw::drawLabelImage( QPainter* painter, const QwtText& label,
+    const QSizeF& labelSize, const QTransform& transform ) const
+{
+    if ( painter->paintEngine() == NULL
+        || painter->paintEngine()->type() != QPaintEngine::Raster )
+    {
+        return false;
+    }
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    if ( label.backgroundBrush().style() != Qt::NoBrush
+        || label.borderPen().style() != Qt::NoPen )
+    {
+        return false;
+    }
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+
+    const QFont font = label.usedFont( painter->font() );
+    const QColor color = label.usedColor( painter->pen().color() );
+
+    const QRect labelRect( QPoint( 0, 0 ), labelSize.toSize() );
+
+    // the same string might be rendered differently, f.e. as rich text
+    const QChar sep( '|' );
+
+    const QString key = label.text() + sep + font.key()
+        + sep + QString::number( label.format() )
+        + sep + QString::number( label.renderFlags() )
+        + sep + QString::number( label.testLayoutAttribute( QwtText::MinimumLayout ) )
+        + sep + QString::number( labelRect.width() )
+        + sep + QString::number( labelRect.height() )
+        + sep + QString::number( color.rgba() )
+        + sep + QString::number( m_data->labelRotation )
+        + sep + QString::number( pixelRatio )
+        + sep + QString::number( painter->testRenderHint( QPainter::TextAntialiasing ) );
+
+    QTransform rotation;
+    rotation.rotate( m_data->labelRotation );
+
+    const QRectF boundingRect = rotation.mapRect( QRectF( labelRect ) );
+
+    QImage* image = m_data->labelImages.object( key );
+    if ( image == NULL )
+    {
+        const QSize imageSize( qwtCeil( boundingRect.width() * pixelRatio ) + 1,
+            qwtCeil( boundingRect.height() * pixelRatio ) + 1 );
+
+        image = new QImage( imageSize, QImage::Format_ARGB32_Premultiplied );
+        image->setDevicePixelRatio( pixelRatio );
+        image->fill( Qt::transparent );
+
+        QPainter p( image );
+        p.setRenderHints( painter->renderHints() );
+        p.setFont( painter->font() );
+        p.setPen( painter->pen() );
+
+        p.translate( -boundingRect.topLeft() );
+        p.rotate( m_data->labelRotation );
+
+        label.draw( &p, labelRect );
+        p.end();
+
+        m_data->labelImages.insert( key, image );
+    }
+
+    // align the image to the pixels of the paint device
+
+    const QPointF offset( painter->transform().dx(), painter->transform().dy() );
+
+    QPointF pos = QPointF( transform.dx(), transform.dy() )
+        + boundingRect.topLeft() + offset;
+
+    pos.setX( qRound( pos.x() * pixelRatio ) / pixelRatio );
+    pos.setY( qRound( pos.y() * pixelRatio ) / pixelRatio );
+
+    painter->drawImage( pos - offset, *image );
+
+    return true;
+}
+
 /*!
    \brief Find the bounding rectangle for the label.
 
@@ -111,6 +111,9 @@ class QWT_EXPORT QwtScaleDraw : public QwtAbstractScaleDraw
   protected:
     QTransform labelTransformation( const QPointF&, const QSizeF& ) const;
 
+    bool drawLabelImage( QPainter*, const QwtText&,
+        const QSizeF&, const QTransform& ) const;
+
     virtual void drawTick( QPainter*,
         double value, double len ) const QWT_OVERRIDE;
 
@@ -35,6 +35,7 @@
 #include "qwt_scale_engine.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qevent.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
@@ -86,6 +87,14 @@ public:
         QwtInterval interval;
         std::unique_ptr< QwtColorMap > colorMap;
     } colorBar;
+
+    // 平移时滚动的刻度缓存
+    struct t_scrollCache
+    {
+        bool isEnabled { false };
+        QPixmap pixmap;
+        QwtScaleDiv scaleDiv;
+    } scrollCache;
 };
 
 /*!
@@ -157,6 +166,55 @@ bool QwtScaleWidget::isOnScale(const QPoint& pos) const
     return cr.contains(pos);
 }
 
+/**
+ * @brief Enable/disable the scroll cache/启用/禁用刻度的滚动缓存
+ *
+ * The scale is rendered into a pixmap. When the scale division is only shifted - f.e. while
+ * panning a strip chart - the pixmap is scrolled and only the uncovered parts are painted again.
+ * The scale draw keeps its labels and their rasterized images across the shifted scale divisions
+ * ( QwtAbstractScaleDraw::KeepLabelsOnShift, QwtAbstractScaleDraw::CacheLabelImages ).
+ *
+ * 刻度绘制到缓存中，刻度范围仅发生平移时（例如实时曲线的平移）滚动缓存，只重绘新露出的部分，
+ * 同时刻度绘制器会保留平移前后的标签和标签的光栅化图片
+ *
+ * @param on true to enable the cache/是否启用
+ * @note After modifying the attributes of scaleDraw() directly invalidateCache() has to be called
+ *       直接修改scaleDraw()的属性后需要调用invalidateCache()
+ */
+void QwtScaleWidget::setScrollCacheEnabled(bool on)
+{
+    QWT_D(d);
+    if (on == d->scrollCache.isEnabled)
+        return;
+
+    d->scrollCache.isEnabled = on;
+    d->scaleDraw->setCacheAttribute(QwtAbstractScaleDraw::KeepLabelsOnShift, on);
+    d->scaleDraw->setCacheAttribute(QwtAbstractScaleDraw::CacheLabelImages, on);
+
+    invalidateCache();
+    update();
+}
+
+/**
+ * @brief Check if the scroll cache is enabled/是否启用了滚动缓存
+ * @sa setScrollCacheEnabled
+ */
+bool QwtScaleWidget::isScrollCacheEnabled() const
+{
+    return m_data->scrollCache.isEnabled;
+}
+
+/**
+ * @brief Invalidate the scroll cache and the label cache of the scale draw/清除刻度的缓存
+ * @sa setScrollCacheEnabled, QwtAbstractScaleDraw::invalidateCache
+ */
+void QwtScaleWidget::invalidateCache()
+{
+    QWT_D(d);
+    d->scrollCache.pixmap = QPixmap();
+    d->scaleDraw->invalidateCache();
+}
+
 /*!
    Toggle an layout flag
 
@@ -173,6 +231,7 @@ void QwtScaleWidget::setLayoutFlag(LayoutFlag flag, bool on)
         else
             m_data->layoutFlags &= ~flag;
 
+        invalidateCache();
         update();
     }
 }
@@ -342,6 +401,11 @@ void QwtScaleWidget::setScaleDraw(QwtScaleDraw* scaleDraw)
 
     m_data->scaleDraw.reset(scaleDraw);
 
+    if (m_data->scrollCache.isEnabled) {
+        scaleDraw->setCacheAttribute(QwtAbstractScaleDraw::KeepLabelsOnShift, true);
+        scaleDraw->setCacheAttribute(QwtAbstractScaleDraw::CacheLabelImages, true);
+    }
+
     layoutScale();
 }
 
@@ -489,7 +553,119 @@ void QwtScaleWidget::paintEvent(QPaintEvent* event)
     painter.setPen(QPen(Qt::blue, 0.5));
     painter.drawRect(rect().adjusted(1, 1, -1, -1));
 #endif
+    if (m_data->scrollCache.isEnabled) {
+        updateScrollCache();
+        painter.drawPixmap(0, 0, m_data->scrollCache.pixmap);
+    } else {
+        draw(&painter);
+    }
+}
+
+/*!
+   \brief Render the scale into the scroll cache
+
+   When the scale division is a shifted version of the cached one
+   ( QwtScaleDiv::isShiftOf() ) and the shift is a multiple of
+   a device pixel the cached pixmap is scrolled and only the parts
+   that can't be taken from it are painted again.
+ */
+void QwtScaleWidget::updateScrollCache()
+{
+    QWT_D(d);
+
+    const QwtScaleDiv& scaleDiv = d->scaleDraw->scaleDiv();
+    const qreal pixelRatio      = QwtPainter::devicePixelRatio(this);
+
+    QPixmap& cache   = d->scrollCache.pixmap;
+    const bool valid = !cache.isNull() && cache.size() == size() * pixelRatio;
+
+    if (valid && d->scrollCache.scaleDiv == scaleDiv)
+        return;
+
+    QPixmap pixmap = QwtPainter::backingStore(this, size());
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setFont(font());
+
+    QRegion region(rect());
+
+    const QwtScaleMap& map = d->scaleDraw->scaleMap();
+    if (valid && map.transformation() == NULL && scaleDiv.isShiftOf(d->scrollCache.scaleDiv)) {
+        double shift = (d->scrollCache.scaleDiv.lowerBound() - scaleDiv.lowerBound()) * (map.p2() - map.p1())
+                       / (map.s2() - map.s1());
+
+        // scrolling by fractions of a pixel would result in blurred content
+        const double deviceShift = shift * pixelRatio;
+        if (qAbs(deviceShift - qRound(deviceShift)) < 0.01) {
+            shift = qRound(deviceShift) / pixelRatio;
+
+            const QRect scrollRect = scrollableRect(shift);
+            if (!scrollRect.isEmpty()) {
+                QPointF offset(0.0, 0.0);
+                if (d->scaleDraw->orientation() == Qt::Horizontal)
+                    offset.setX(shift);
+                else
+                    offset.setY(shift);
+
+                painter.setClipRect(scrollRect);
+                painter.drawPixmap(offset, cache);
+
+                region -= scrollRect;
+            }
+        }
+    }
+
+    painter.setClipRegion(region);
     draw(&painter);
+    painter.end();
+
+    cache                    = pixmap;
+    d->scrollCache.scaleDiv = scaleDiv;
+}
+
+/*!
+   \brief Calculate the part of the scale, that can be scrolled
+
+   This is the band of the ticks and labels without the title and
+   the color bar, and without the ends of the backbone, where labels
+   might appear or disappear.
+
+   \param shift Shift in pixels
+   \return Scrollable rectangle, might be empty
+ */
+QRect QwtScaleWidget::scrollableRect(double shift) const
+{
+    const QwtScaleDraw* sd = m_data->scaleDraw.get();
+
+    const double extent   = sd->extent(font());
+    const double penWidth = qwtMaxF(sd->penWidthF(), 1.0) + 1.0;
+    const QPointF pos     = sd->pos();
+
+    const double margin = qAbs(shift)
+                          + ((sd->orientation() == Qt::Horizontal) ? sd->maxLabelWidth(font()) : sd->maxLabelHeight(font()));
+
+    QRectF r;
+    switch (sd->alignment()) {
+    case QwtScaleDraw::BottomScale:
+        r.setCoords(pos.x() + margin, pos.y() - penWidth, pos.x() + sd->length() - margin, pos.y() + extent);
+        break;
+    case QwtScaleDraw::TopScale:
+        r.setCoords(pos.x() + margin, pos.y() - extent, pos.x() + sd->length() - margin, pos.y() + penWidth);
+        break;
+    case QwtScaleDraw::LeftScale:
+        r.setCoords(pos.x() - extent, pos.y() + margin, pos.x() + penWidth, pos.y() + sd->length() - margin);
+        break;
+    case QwtScaleDraw::RightScale:
+    default:
+        r.setCoords(pos.x() - penWidth, pos.y() + margin, pos.x() + extent, pos.y() + sd->length() - margin);
+        break;
+    }
+
+    if (!r.isValid())
+        return QRect();
+
+    return r.toAlignedRect() & rect();
 }
 
 /*!
@@ -634,6 +810,9 @@ QRect QwtScaleWidget::scaleRect() const
  */
 void QwtScaleWidget::changeEvent(QEvent* event)
 {
+    // palette, font, enabled and activation state affect the cached scale
+    m_data->scrollCache.pixmap = QPixmap();
+
     if (event->type() == QEvent::LocaleChange) {
         m_data->scaleDraw->invalidateCache();
     }
@@ -698,6 +877,8 @@ void QwtScaleWidget::layoutScale(bool update_geometry)
     m_data->scaleDraw->move(x, y);
     m_data->scaleDraw->setLength(length);
 
+    m_data->scrollCache.pixmap = QPixmap();
+
     const int extent = qwtCeil(m_data->scaleDraw->extent(font()));
     // titleoffset和edgeMargin无关
     m_data->titleOffset = m_data->margin + m_data->spacing + colorBarWidth + extent;
@@ -820,6 +1001,7 @@ void QwtScaleWidget::setSelected(bool selected)
         }
         d->scaleDraw->setSelected(selected);
         d->isSelected = selected;
+        invalidateCache();
         update();
         Q_EMIT selectionChanged(selected);
     }
@@ -843,6 +1025,7 @@ void QwtScaleWidget::setSelectionColor(const QColor& color)
     if (m_data->selectionColor != color) {
         m_data->selectionColor = color;
         if (m_data->isSelected) {
+            invalidateCache();
             update();
         }
     }
@@ -889,6 +1072,7 @@ double QwtScaleWidget::zoomFactor() const
 void QwtScaleWidget::setSelectedPenWidthOffset(qreal offset)
 {
     m_data->scaleDraw->setSelectedPenWidthOffset(offset);
+    invalidateCache();
 }
 
 /**
@@ -1212,9 +1396,19 @@ void QwtScaleWidget::setScaleDiv(const QwtScaleDiv& scaleDiv)
 {
     QWT_D(d);
     if (d->scaleDraw->scaleDiv() != scaleDiv) {
+        // layoutScale() drops the scroll cache, but it can be scrolled
+        // as long as the geometry of the scale doesn't change
+        const QPixmap cache    = d->scrollCache.pixmap;
+        const QPointF pos      = d->scaleDraw->pos();
+        const double length    = d->scaleDraw->length();
+        const int titleOffset  = d->titleOffset;
+
         d->scaleDraw->setScaleDiv(scaleDiv);
         layoutScale();
 
+        if (pos == d->scaleDraw->pos() && length == d->scaleDraw->length() && titleOffset == d->titleOffset)
+            d->scrollCache.pixmap = cache;
+
         Q_EMIT scaleDivChanged();
     }
 }
@@ -247,6 +247,12 @@ public:
     // 判断点是否在刻度区域
     bool isOnScale(const QPoint& pos) const;
 
+    // 缓存刻度的绘制结果，平移时滚动缓存，只重绘新露出的部分
+    void setScrollCacheEnabled(bool on);
+    bool isScrollCacheEnabled() const;
+
+    void invalidateCache();
+
 protected:
     virtual void paintEvent(QPaintEvent*) QWT_OVERRIDE;
     virtual void resizeEvent(QResizeEvent*) QWT_OVERRIDE;
@@ -258,6 +264,8 @@ protected:
 
 private:
     void initScale(QwtScaleDraw::Alignment);
+    void updateScrollCache();
+    QRect scrollableRect(double shift) const;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QwtScaleWidget::LayoutFlags)
@@ -28,6 +28,9 @@
 #include "qwt_point_polar.h"
 #include "qwt_math.h"
 
+#include <limits>
+#include <typeinfo>
+
 // check nan or inf
 static inline bool isSampleNanOrInf(const QPointF& sample)
 {
@@ -308,6 +311,221 @@ QRectF qwtBoundingRect(const QwtSeriesData< QwtVectorFieldSample >& series, size
     return qwtBoundingRectT< QwtVectorFieldSample >(series, from, to);
 }
 
+namespace
+{
+// 0.0 for finite values, NaN for NaN or infinite values
+inline double qwtFiniteMask(double value)
+{
+    return value - value;
+}
+}
+
+/*
+   Min/max reduction over an array of samples
+
+   extract(i, x1, x2, y) returns the x range and the y value of sample i.
+   For invalid samples it has to return NaN, what is done without branches
+   by adding qwtFiniteMask() of all coordinates. As any comparison with NaN
+   is false, "v < m ? v : m" ignores those values and compilers translate
+   it into min/max instructions. The 4 independent lanes break the dependency
+   chain, so that the loop can be vectorized and pipelined.
+ */
+template< typename Extract >
+static QRectF qwtReduceBoundingRect(size_t count, Extract extract)
+{
+    const int numLanes = 4;
+    const double big   = std::numeric_limits< double >::max();
+
+    double minX[ numLanes ], maxX[ numLanes ], minY[ numLanes ], maxY[ numLanes ];
+    for (int k = 0; k < numLanes; k++) {
+        minX[ k ] = minY[ k ] = big;
+        maxX[ k ] = maxY[ k ] = -big;
+    }
+
+    size_t i = 0;
+    for (; i + numLanes <= count; i += numLanes) {
+        for (int k = 0; k < numLanes; k++) {
+            double x1, x2, y;
+            extract(i + k, x1, x2, y);
+
+            minX[ k ] = (x1 < minX[ k ]) ? x1 : minX[ k ];
+            maxX[ k ] = (x2 > maxX[ k ]) ? x2 : maxX[ k ];
+            minY[ k ] = (y < minY[ k ]) ? y : minY[ k ];
+            maxY[ k ] = (y > maxY[ k ]) ? y : maxY[ k ];
+        }
+    }
+
+    for (; i < count; i++) {
+        double x1, x2, y;
+        extract(i, x1, x2, y);
+
+        minX[ 0 ] = (x1 < minX[ 0 ]) ? x1 : minX[ 0 ];
+        maxX[ 0 ] = (x2 > maxX[ 0 ]) ? x2 : maxX[ 0 ];
+        minY[ 0 ] = (y < minY[ 0 ]) ? y : minY[ 0 ];
+        maxY[ 0 ] = (y > maxY[ 0 ]) ? y : maxY[ 0 ];
+    }
+
+    for (int k = 1; k < numLanes; k++) {
+        minX[ 0 ] = qMin(minX[ 0 ], minX[ k ]);
+        maxX[ 0 ] = qMax(maxX[ 0 ], maxX[ k ]);
+        minY[ 0 ] = qMin(minY[ 0 ], minY[ k ]);
+        maxY[ 0 ] = qMax(maxY[ 0 ], maxY[ k ]);
+    }
+
+    if (minX[ 0 ] > maxX[ 0 ])
+        return QRectF(1.0, 1.0, -2.0, -2.0);  // no valid sample
+
+    QRectF boundingRect;
+    boundingRect.setCoords(minX[ 0 ], minY[ 0 ], maxX[ 0 ], maxY[ 0 ]);
+
+    return boundingRect;
+}
+
+/*!
+   \brief Calculate the bounding rectangle of an array of points
+
+   Points with a NaN or infinite coordinate are ignored.
+   This is the fast path of QwtPointSeriesData::boundingRect().
+
+   \param samples Array of points
+   \param count Number of points
+
+   \return Bounding rectangle, invalid when there is no valid point
+ */
+QRectF qwtBoundingRect(const QPointF* samples, size_t count)
+{
+    return qwtReduceBoundingRect(count, [ samples ](size_t i, double& x1, double& x2, double& y) {
+        const double x = samples[ i ].x();
+        const double v = samples[ i ].y();
+        const double t = qwtFiniteMask(x) + qwtFiniteMask(v);
+
+        x1 = x2 = x + t;
+        y       = v + t;
+    });
+}
+
+/*!
+   \brief Calculate the bounding rectangle of an array of 3D points
+
+   The z coordinate is not part of the rectangle, but points with a
+   NaN or infinite coordinate are ignored.
+
+   \param samples Array of points
+   \param count Number of points
+
+   \return Bounding rectangle, invalid when there is no valid point
+ */
+QRectF qwtBoundingRect(const QwtPoint3D* samples, size_t count)
+{
+    return qwtReduceBoundingRect(count, [ samples ](size_t i, double& x1, double& x2, double& y) {
+        const QwtPoint3D& s = samples[ i ];
+        const double t      = qwtFiniteMask(s.x()) + qwtFiniteMask(s.y()) + qwtFiniteMask(s.z());
+
+        x1 = x2 = s.x() + t;
+        y       = s.y() + t;
+    });
+}
+
+/*!
+   \brief Calculate the bounding rectangle of an array of interval samples
+
+   Samples with a NaN or infinite value and samples with an inverted
+   interval are ignored.
+
+   \param samples Array of samples
+   \param count Number of samples
+
+   \return Bounding rectangle, invalid when there is no valid sample
+ */
+QRectF qwtBoundingRect(const QwtIntervalSample* samples, size_t count)
+{
+    const double nan = std::numeric_limits< double >::quiet_NaN();
+
+    return qwtReduceBoundingRect(count, [ samples, nan ](size_t i, double& x1, double& x2, double& y) {
+        const QwtIntervalSample& s = samples[ i ];
+
+        const double minValue = s.interval.minValue();
+        const double maxValue = s.interval.maxValue();
+
+        const double t = qwtFiniteMask(minValue) + qwtFiniteMask(maxValue) + qwtFiniteMask(s.value)
+                         + ((maxValue < minValue) ? nan : 0.0);
+
+        x1 = minValue + t;
+        x2 = maxValue + t;
+        y  = s.value + t;
+    });
+}
+
+/*!
+   \brief Calculate the bounding rectangle of an array of OHLC samples
+
+   Like qwtBoundingRect(const QwtSeriesData<QwtOHLCSample>&) the x range
+   is the bounding interval of the prices and y is the time.
+   Samples with a NaN or infinite value are ignored.
+
+   \param samples Array of samples
+   \param count Number of samples
+
+   \return Bounding rectangle, invalid when there is no valid sample
+ */
+QRectF qwtBoundingRect(const QwtOHLCSample* samples, size_t count)
+{
+    return qwtReduceBoundingRect(count, [ samples ](size_t i, double& x1, double& x2, double& y) {
+        const QwtOHLCSample& s = samples[ i ];
+
+        const double t = qwtFiniteMask(s.open) + qwtFiniteMask(s.high) + qwtFiniteMask(s.low)
+                         + qwtFiniteMask(s.close) + qwtFiniteMask(s.time);
+
+        x1 = qMin(qMin(s.open, s.high), qMin(s.low, s.close)) + t;
+        x2 = qMax(qMax(s.open, s.high), qMax(s.low, s.close)) + t;
+        y  = s.time + t;
+    });
+}
+
+/*!
+   \brief Calculate the bounding rectangle of separate coordinate arrays
+
+   Points with a NaN or infinite coordinate are ignored.
+
+   \param xData Array of x coordinates
+   \param yData Array of y coordinates
+   \param count Number of points
+
+   \return Bounding rectangle, invalid when there is no valid point
+ */
+QRectF qwtBoundingRect(const double* xData, const double* yData, size_t count)
+{
+    return qwtReduceBoundingRect(count, [ xData, yData ](size_t i, double& x1, double& x2, double& y) {
+        const double t = qwtFiniteMask(xData[ i ]) + qwtFiniteMask(yData[ i ]);
+
+        x1 = x2 = xData[ i ] + t;
+        y       = yData[ i ] + t;
+    });
+}
+
+/*!
+   \brief Calculate the bounding rectangle of separate coordinate arrays
+
+   Points with a NaN or infinite coordinate are ignored.
+
+   \param xData Array of x coordinates
+   \param yData Array of y coordinates
+   \param count Number of points
+
+   \return Bounding rectangle, invalid when there is no valid point
+ */
+QRectF qwtBoundingRect(const float* xData, const float* yData, size_t count)
+{
+    return qwtReduceBoundingRect(count, [ xData, yData ](size_t i, double& x1, double& x2, double& y) {
+        const double x = xData[ i ];
+        const double v = yData[ i ];
+        const double t = qwtFiniteMask(x) + qwtFiniteMask(v);
+
+        x1 = x2 = x + t;
+        y       = v + t;
+    });
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -326,8 +544,13 @@ QwtPointSeriesData::QwtPointSeriesData(const QVector< QPointF >& samples) : QwtA
  */
 QRectF QwtPointSeriesData::boundingRect() const
 {
-    if (cachedBoundingRect.width() < 0.0)
-        cachedBoundingRect = qwtBoundingRect(*this);
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample() or not store their samples in m_samples
+        if (typeid(*this) == typeid(QwtPointSeriesData))
+            cachedBoundingRect = qwtBoundingRect(m_samples.constData(), size());
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
 
     return cachedBoundingRect;
 }
@@ -351,8 +574,13 @@ QwtPoint3DSeriesData::QwtPoint3DSeriesData(const QVector< QwtPoint3D >& samples)
  */
 QRectF QwtPoint3DSeriesData::boundingRect() const
 {
-    if (cachedBoundingRect.width() < 0.0)
-        cachedBoundingRect = qwtBoundingRect(*this);
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample() or not store their samples in m_samples
+        if (typeid(*this) == typeid(QwtPoint3DSeriesData))
+            cachedBoundingRect = qwtBoundingRect(m_samples.constData(), size());
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
 
     return cachedBoundingRect;
 }
@@ -376,8 +604,13 @@ QwtIntervalSeriesData::QwtIntervalSeriesData(const QVector< QwtIntervalSample >&
  */
 QRectF QwtIntervalSeriesData::boundingRect() const
 {
-    if (cachedBoundingRect.width() < 0.0)
-        cachedBoundingRect = qwtBoundingRect(*this);
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample() or not store their samples in m_samples
+        if (typeid(*this) == typeid(QwtIntervalSeriesData))
+            cachedBoundingRect = qwtBoundingRect(m_samples.constData(), size());
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
 
     return cachedBoundingRect;
 }
@@ -450,8 +683,13 @@ QwtTradingChartData::QwtTradingChartData(const QVector< QwtOHLCSample >& samples
  */
 QRectF QwtTradingChartData::boundingRect() const
 {
-    if (cachedBoundingRect.width() < 0.0)
-        cachedBoundingRect = qwtBoundingRect(*this);
+    if (cachedBoundingRect.width() < 0.0) {
+        // derived classes might override sample() or not store their samples in m_samples
+        if (typeid(*this) == typeid(QwtTradingChartData))
+            cachedBoundingRect = qwtBoundingRect(m_samples.constData(), size());
+        else
+            cachedBoundingRect = qwtBoundingRect(*this);
+    }
 
     return cachedBoundingRect;
 }
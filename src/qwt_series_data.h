@@ -313,6 +313,62 @@ QWT_EXPORT QRectF qwtBoundingRect(const QwtSeriesData< QwtOHLCSample >&, size_t
 
 QWT_EXPORT QRectF qwtBoundingRect(const QwtSeriesData< QwtVectorFieldSample >&, size_t from = 0, size_t to = 0);
 
+QWT_EXPORT QRectF qwtBoundingRect(const QPointF* samples, size_t count);
+
+QWT_EXPORT QRectF qwtBoundingRect(const QwtPoint3D* samples, size_t count);
+
+QWT_EXPORT QRectF qwtBoundingRect(const QwtIntervalSample* samples, size_t count);
+
+QWT_EXPORT QRectF qwtBoundingRect(const QwtOHLCSample* samples, size_t count);
+
+QWT_EXPORT QRectF qwtBoundingRect(const double* xData, const double* yData, size_t count);
+
+QWT_EXPORT QRectF qwtBoundingRect(const float* xData, const float* yData, size_t count);
+
+/*!
+   \brief Calculate the bounding rectangle of two arrays of coordinates
+
+   Fallback for coordinate types other than double and float.
+   Points with a NaN or infinite coordinate are ignored.
+
+   \param xData Array of x coordinates
+   \param yData Array of y coordinates
+   \param count Number of points
+
+   \return Bounding rectangle
+ */
+template< typename T >
+QRectF qwtBoundingRect(const T* xData, const T* yData, size_t count)
+{
+    QRectF boundingRect(1.0, 1.0, -2.0, -2.0);  // invalid;
+
+    bool isValid = false;
+    double minX = 0.0, maxX = 0.0, minY = 0.0, maxY = 0.0;
+
+    for (size_t i = 0; i < count; i++) {
+        const double x = static_cast< double >(xData[ i ]);
+        const double y = static_cast< double >(yData[ i ]);
+        if (!(x - x == 0.0) || !(y - y == 0.0))
+            continue;
+
+        if (!isValid) {
+            minX = maxX = x;
+            minY = maxY = y;
+            isValid     = true;
+        } else {
+            minX = qMin(minX, x);
+            maxX = qMax(maxX, x);
+            minY = qMin(minY, y);
+            maxY = qMax(maxY, y);
+        }
+    }
+
+    if (isValid)
+        boundingRect.setCoords(minX, minY, maxX, maxY);
+
+    return boundingRect;
+}
+
 /**
  * Binary search for a sorted series of samples
  *
@@ -0,0 +1,938 @@
+﻿#include "qwt_series_loader.h"
+// stl
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+// Qt
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+#include <QSet>
+#include <QThread>
+#include <QVector>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+// qwt
+#include "qwt_plot.h"
+#include "qwt_plot_curve.h"
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+// 加载参数，start()时拷贝一份交给加载线程
+struct QwtSeriesLoaderSettings
+{
+    QwtSeriesLoader::Format format { QwtSeriesLoader::Csv };
+    QChar delimiter;
+    int headerLines { 0 };
+    int xColumn { 0 };
+    int yColumn { 1 };
+    QwtMappedPointData::DataType dataType { QwtMappedPointData::Float64 };
+    QwtMappedPointData::Layout layout { QwtMappedPointData::Interleaved };
+    qint64 offset { 0 };
+    double x0 { 0.0 };
+    double dx { 1.0 };
+    int previewSize { 10000 };
+    int previewInterval { 200 };
+};
+
+struct QwtSeriesLoaderCurve
+{
+    QPointer< QwtPlot > plot;
+    QwtPlotCurve* curve;
+};
+}
+
+// 执行func(0)...func(count-1)，func(0)在当前线程执行
+template< typename Func >
+static void qwtLoaderRunParallel(int count, Func func)
+{
+#if QWT_USE_THREADS
+    QList< QFuture< void > > futures;
+    for (int i = 1; i < count; ++i) {
+        futures += QtConcurrent::run([ &func, i ]() { func(i); });
+    }
+    if (count > 0) {
+        func(0);
+    }
+    for (int i = 0; i < futures.size(); ++i) {
+        futures[ i ].waitForFinished();
+    }
+#else
+    for (int i = 0; i < count; ++i) {
+        func(i);
+    }
+#endif
+}
+
+static inline bool qwtLoaderIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief 解析一个数值
+ *
+ * 不超过15位有效数字、10的指数不超过22的数值直接由整数尾数计算，结果是精确舍入的，
+ * 其它的情况（很长的数字、nan、inf）交给QByteArray::toDouble，与locale无关
+ */
+static bool qwtLoaderParseDouble(const char* s, const char* e, double& value)
+{
+    static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    while (s < e && (qwtLoaderIsSpace(*s) || *s == '"')) {
+        ++s;
+    }
+    while (e > s && (qwtLoaderIsSpace(e[ -1 ]) || e[ -1 ] == '"')) {
+        --e;
+    }
+    if (s == e) {
+        return false;
+    }
+
+    const char* p = s;
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    quint64 mantissa = 0;
+    int digits       = 0;
+    int exponent     = 0;
+    bool hasDigits   = false;
+
+    for (; p < e && *p >= '0' && *p <= '9'; ++p) {
+        hasDigits = true;
+        mantissa  = mantissa * 10 + quint64(*p - '0');
+        if (mantissa != 0 && ++digits > 15) {
+            break;
+        }
+    }
+    if (p < e && *p == '.' && digits <= 15) {
+        for (++p; p < e && *p >= '0' && *p <= '9'; ++p) {
+            hasDigits = true;
+            mantissa  = mantissa * 10 + quint64(*p - '0');
+            exponent--;
+            if (mantissa != 0 && ++digits > 15) {
+                break;
+            }
+        }
+    }
+    if (hasDigits && digits <= 15 && p < e && (*p == 'e' || *p == 'E')) {
+        const char* q    = p + 1;
+        bool negativeExp = false;
+        if (q < e && (*q == '+' || *q == '-')) {
+            negativeExp = (*q == '-');
+            ++q;
+        }
+        int n = 0;
+        const char* first = q;
+        for (; q < e && *q >= '0' && *q <= '9' && n < 1000; ++q) {
+            n = n * 10 + (*q - '0');
+        }
+        if (q > first) {
+            exponent += negativeExp ? -n : n;
+            p = q;
+        }
+    }
+
+    if (hasDigits && digits <= 15 && p == e && exponent >= -22 && exponent <= 22) {
+        value = double(mantissa);
+        value = (exponent < 0) ? value / pow10[ -exponent ] : value * pow10[ exponent ];
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+    bool ok = false;
+    value   = QByteArray(s, int(e - s)).toDouble(&ok);
+    return ok;
+}
+
+// 根据第一个数据行识别分隔符，' '表示任意空白
+static char qwtLoaderDetectDelimiter(const char* p, const char* end)
+{
+    while (p < end) {
+        const char* eol = static_cast< const char* >(std::memchr(p, '\n', size_t(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+
+        const char* s = p;
+        while (s < eol && qwtLoaderIsSpace(*s)) {
+            ++s;
+        }
+        if (s < eol && *s != '#') {
+            static const char candidates[] = { '\t', ';', ',' };
+            for (char c : candidates) {
+                if (std::memchr(s, c, size_t(eol - s))) {
+                    return c;
+                }
+            }
+            return ' ';
+        }
+        p = eol + 1;
+    }
+    return ',';
+}
+
+// 行数，即解析出的点数的上限
+static int qwtLoaderCountLines(const char* p, const char* end)
+{
+    int count = 0;
+    while (p < end) {
+        const char* eol = static_cast< const char* >(std::memchr(p, '\n', size_t(end - p)));
+        count++;
+        if (!eol) {
+            break;
+        }
+        p = eol + 1;
+    }
+    return count;
+}
+
+/**
+ * @brief 解析一个块中的所有行
+ * @return 解析出的点数，点从out开始连续存放
+ */
+static int qwtLoaderParseCsv(const char* begin, const char* end, char delimiter, int xColumn, int yColumn, QPointF* out)
+{
+    const int maxColumn = qMax(xColumn, yColumn);
+
+    int count        = 0;
+    const char* line = begin;
+    while (line < end) {
+        const char* eol = static_cast< const char* >(std::memchr(line, '\n', size_t(end - line)));
+        if (!eol) {
+            eol = end;
+        }
+
+        double x  = 0.0;
+        double y  = 0.0;
+        bool hasX = (xColumn < 0);
+        bool hasY = false;
+
+        if (eol > line && *line != '#') {
+            const char* field = line;
+            for (int column = 0; column <= maxColumn && field <= eol; ++column) {
+                const char* fieldEnd;
+                if (delimiter == ' ') {
+                    while (field < eol && qwtLoaderIsSpace(*field)) {
+                        ++field;
+                    }
+                    if (field == eol) {
+                        break;
+                    }
+                    fieldEnd = field;
+                    while (fieldEnd < eol && !qwtLoaderIsSpace(*fieldEnd)) {
+                        ++fieldEnd;
+                    }
+                } else {
+                    fieldEnd = static_cast< const char* >(std::memchr(field, delimiter, size_t(eol - field)));
+                    if (!fieldEnd) {
+                        fieldEnd = eol;
+                    }
+                }
+
+                if (column == xColumn) {
+                    hasX = qwtLoaderParseDouble(field, fieldEnd, x);
+                }
+                if (column == yColumn) {
+                    hasY = qwtLoaderParseDouble(field, fieldEnd, y);
+                }
+                field = fieldEnd + 1;
+            }
+        }
+
+        if (hasX && hasY) {
+            out[ count++ ] = QPointF(x, y);
+        }
+        line = eol + 1;
+    }
+    return count;
+}
+
+class QwtSeriesLoader::PrivateData
+{
+    QWT_DECLARE_PUBLIC(QwtSeriesLoader)
+public:
+    PrivateData(QwtSeriesLoader* p);
+
+    bool run(const QwtSeriesLoaderSettings& s, const QString& fileName);
+    bool loadCsv(const QwtSeriesLoaderSettings& s, const QString& fileName, QVector< QPointF >& points, QString& error);
+    bool loadBinary(const QwtSeriesLoaderSettings& s, const QString& fileName, QVector< QPointF >& points, QString& error);
+    // 发布已加载数据的抽稀预览
+    void publishPreview(const QwtSeriesLoaderSettings& s, const QPointF* points, int count, QElapsedTimer& timer);
+    bool isCanceled() const;
+
+public:
+    QwtSeriesLoaderSettings settings;
+    QwtSharedPointSource source;
+    QList< QwtSeriesLoaderCurve > curves;
+    QAtomicInt canceled;
+#if QWT_USE_THREADS
+    QFuture< bool > future;
+#endif
+    // 以下由加载线程写入
+    mutable QMutex mutex;
+    QwtSharedPointBuffer result;
+    QString errorString;
+};
+
+QwtSeriesLoader::PrivateData::PrivateData(QwtSeriesLoader* p) : q_ptr(p)
+{
+}
+
+bool QwtSeriesLoader::PrivateData::isCanceled() const
+{
+    return canceled.loadAcquire() != 0;
+}
+
+bool QwtSeriesLoader::PrivateData::run(const QwtSeriesLoaderSettings& s, const QString& fileName)
+{
+    QVector< QPointF > points;
+    QString error;
+
+    bool ok = false;
+    if (s.format == QwtSeriesLoader::Binary) {
+        ok = loadBinary(s, fileName, points, error);
+    } else {
+        ok = loadCsv(s, fileName, points, error);
+    }
+
+    // 包装为共享数据，不再拷贝；边界矩形在加载线程中计算
+    QwtSharedPointBuffer buffer;
+    if (ok) {
+        buffer = QwtSharedPointBuffer(std::move(points));
+    }
+
+    {
+        QMutexLocker locker(&mutex);
+        result      = buffer;
+        errorString = error;
+    }
+
+    if (ok) {
+        source.publish(buffer);
+        Q_EMIT q_ptr->samplesAvailable();
+    }
+    Q_EMIT q_ptr->finished(ok);
+    return ok;
+}
+
+bool QwtSeriesLoader::PrivateData::loadCsv(const QwtSeriesLoaderSettings& s,
+                                           const QString& fileName,
+                                           QVector< QPointF >& points,
+                                           QString& error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    // 优先使用内存映射，避免把整个文件读入内存
+    const qint64 fileSize = file.size();
+    QByteArray content;
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+    if (fileSize > 0) {
+        const uchar* mapped = file.map(0, fileSize);
+        if (mapped) {
+            begin = reinterpret_cast< const char* >(mapped);
+            end   = begin + fileSize;
+        } else {
+            // end follows the buffer, that has actually been read
+            content = file.readAll();
+            if (content.isEmpty()) {
+                error = file.errorString();
+                return false;
+            }
+            begin = content.constData();
+            end   = begin + content.size();
+        }
+    }
+
+    const char* p = begin;
+    for (int i = 0; i < s.headerLines && p < end; ++i) {
+        const char* eol = static_cast< const char* >(std::memchr(p, '\n', size_t(end - p)));
+        p               = eol ? eol + 1 : end;
+    }
+
+    const char delimiter = s.delimiter.isNull() ? qwtLoaderDetectDelimiter(p, end) : s.delimiter.toLatin1();
+
+    // 按行边界分块
+    const qint64 chunkSize = 4 * 1024 * 1024;
+
+    QVector< const char* > bounds;
+    bounds += p;
+    while (bounds.last() < end) {
+        const char* c = bounds.last();
+        if (end - c <= chunkSize) {
+            c = end;
+        } else {
+            c += chunkSize;
+            const char* eol = static_cast< const char* >(std::memchr(c, '\n', size_t(end - c)));
+            c               = eol ? eol + 1 : end;
+        }
+        bounds += c;
+    }
+    const int numChunks = bounds.size() - 1;
+
+    // 第一遍统计每块的行数，得到每块在结果数组中的位置
+    QVector< int > lineCounts(numChunks);
+    qwtLoaderRunParallel(numChunks,
+                         [ & ](int i) { lineCounts[ i ] = qwtLoaderCountLines(bounds[ i ], bounds[ i + 1 ]); });
+
+    QVector< qint64 > offsets(numChunks + 1);
+    for (int i = 0; i < numChunks; ++i) {
+        offsets[ i + 1 ] = offsets[ i ] + lineCounts[ i ];
+    }
+    if (offsets.last() > std::numeric_limits< int >::max()) {
+        error = QStringLiteral("Too many lines");
+        return false;
+    }
+
+    // 直接解析到结果数组中
+    points.resize(int(offsets.last()));
+    QPointF* out = points.data();
+
+    const int numThreads = qMax(QThread::idealThreadCount(), 1);
+    QVector< int > parsed(numChunks);
+
+    QElapsedTimer previewTimer;
+    previewTimer.start();
+
+    int numPoints = 0;
+    for (int first = 0; first < numChunks; first += numThreads) {
+        if (isCanceled()) {
+            error = QStringLiteral("Canceled");
+            return false;
+        }
+
+        const int count = qMin(numThreads, numChunks - first);
+        qwtLoaderRunParallel(count, [ & ](int i) {
+            const int chunk = first + i;
+            parsed[ chunk ] = qwtLoaderParseCsv(
+                bounds[ chunk ], bounds[ chunk + 1 ], delimiter, s.xColumn, s.yColumn, out + offsets[ chunk ]);
+        });
+
+        // 去掉跳过的行留下的空隙
+        for (int chunk = first; chunk < first + count; ++chunk) {
+            QPointF* from = out + offsets[ chunk ];
+            if (from != out + numPoints) {
+                std::copy(from, from + parsed[ chunk ], out + numPoints);
+            }
+            if (s.xColumn < 0) {
+                for (int i = numPoints; i < numPoints + parsed[ chunk ]; ++i) {
+                    out[ i ].setX(s.x0 + i * s.dx);
+                }
+            }
+            numPoints += parsed[ chunk ];
+        }
+
+        Q_EMIT q_ptr->progressChanged(bounds[ first + count ] - begin, end - begin);
+        if (first + count < numChunks) {
+            publishPreview(s, out, numPoints, previewTimer);
+        }
+    }
+
+    points.resize(numPoints);
+    return true;
+}
+
+bool QwtSeriesLoader::PrivateData::loadBinary(const QwtSeriesLoaderSettings& s,
+                                              const QString& fileName,
+                                              QVector< QPointF >& points,
+                                              QString& error)
+{
+    QwtMappedPointData data(fileName, s.dataType, s.layout, s.offset);
+    if (!data.isValid()) {
+        error = QStringLiteral("Could not map %1").arg(fileName);
+        return false;
+    }
+    data.setSampling(s.x0, s.dx);
+
+    const size_t sampleCount = data.sampleCount();
+    if (sampleCount > size_t(std::numeric_limits< int >::max())) {
+        error = QStringLiteral("Too many samples");
+        return false;
+    }
+
+    const int numPoints = int(sampleCount);
+    points.resize(numPoints);
+    QPointF* out = points.data();
+
+    const int chunkSize  = 1024 * 1024;
+    const int numThreads = qMax(QThread::idealThreadCount(), 1);
+    const int waveSize   = chunkSize * numThreads;
+
+    QElapsedTimer previewTimer;
+    previewTimer.start();
+
+    for (int first = 0; first < numPoints; first += waveSize) {
+        if (isCanceled()) {
+            error = QStringLiteral("Canceled");
+            return false;
+        }
+
+        const int last  = first + qMin(waveSize, numPoints - first);
+        const int count = (last - first + chunkSize - 1) / chunkSize;
+        qwtLoaderRunParallel(count, [ & ](int i) {
+            const int from = first + i * chunkSize;
+            const int to   = qMin(from + chunkSize, last);
+            for (int j = from; j < to; ++j) {
+                out[ j ] = data.rawSample(size_t(j));
+            }
+        });
+
+        Q_EMIT q_ptr->progressChanged(last, numPoints);
+        if (last < numPoints) {
+            publishPreview(s, out, last, previewTimer);
+        }
+    }
+
+    return true;
+}
+
+void QwtSeriesLoader::PrivateData::publishPreview(const QwtSeriesLoaderSettings& s,
+                                                  const QPointF* points,
+                                                  int count,
+                                                  QElapsedTimer& timer)
+{
+    if (s.previewSize <= 0 || count <= 0 || timer.elapsed() < s.previewInterval) {
+        return;
+    }
+
+    QVector< QPointF > preview;
+    if (count <= s.previewSize) {
+        preview = QVector< QPointF >(count);
+        std::copy(points, points + count, preview.data());
+    } else {
+        // 每个桶保留y的最小值和最大值，保持原来的顺序，峰值不会丢失
+        const int numBuckets = qMax(s.previewSize / 2, 1);
+        preview.reserve(2 * numBuckets);
+
+        for (int b = 0; b < numBuckets; ++b) {
+            const int from = int(qint64(count) * b / numBuckets);
+            const int to   = int(qint64(count) * (b + 1) / numBuckets);
+            if (from >= to) {
+                continue;
+            }
+
+            int iMin = from;
+            int iMax = from;
+            for (int i = from + 1; i < to; ++i) {
+                if (points[ i ].y() < points[ iMin ].y()) {
+                    iMin = i;
+                } else if (points[ i ].y() > points[ iMax ].y()) {
+                    iMax = i;
+                }
+            }
+
+            preview += points[ qMin(iMin, iMax) ];
+            if (iMin != iMax) {
+                preview += points[ qMax(iMin, iMax) ];
+            }
+        }
+    }
+
+    source.publish(QwtSharedPointBuffer(std::move(preview)));
+    Q_EMIT q_ptr->samplesAvailable();
+    timer.restart();
+}
+
+//===============================================================
+// QwtSeriesLoader
+//===============================================================
+
+QwtSeriesLoader::QwtSeriesLoader(QObject* par) : QObject(par), QWT_PIMPL_CONSTRUCT
+{
+    // 信号从加载线程发出，在对象所在的线程更新曲线
+    connect(this, &QwtSeriesLoader::samplesAvailable, this, &QwtSeriesLoader::updateCurves, Qt::QueuedConnection);
+}
+
+QwtSeriesLoader::~QwtSeriesLoader()
+{
+    cancel();
+    waitForFinished();
+
+    // 曲线保留最后的数据，断开与即将删除的数据源的关联
+    QWT_D(d);
+    for (const QwtSeriesLoaderCurve& c : qAsConst(d->curves)) {
+        if (!c.plot || !c.plot->itemList().contains(c.curve)) {
+            continue;
+        }
+        QwtSharedPointData* data = dynamic_cast< QwtSharedPointData* >(c.curve->data());
+        if (data && data->source() == &d->source) {
+            data->setSource(nullptr);
+        }
+    }
+}
+
+/**
+ * @brief 设置文件格式
+ * @param f
+ */
+void QwtSeriesLoader::setFormat(QwtSeriesLoader::Format f)
+{
+    m_data->settings.format = f;
+}
+
+/**
+ * @brief 文件格式
+ * @return
+ */
+QwtSeriesLoader::Format QwtSeriesLoader::format() const
+{
+    return m_data->settings.format;
+}
+
+/**
+ * @brief 设置csv的分隔符
+ * @param c 分隔符，' '表示任意空白，QChar()表示根据第一个数据行自动识别（默认）
+ */
+void QwtSeriesLoader::setDelimiter(QChar c)
+{
+    m_data->settings.delimiter = c;
+}
+
+/**
+ * @brief csv的分隔符
+ * @return
+ */
+QChar QwtSeriesLoader::delimiter() const
+{
+    return m_data->settings.delimiter;
+}
+
+/**
+ * @brief 设置csv开头跳过的行数
+ *
+ * 无法解析为数值的行本身也会被跳过，此设置用于跳过可能被误解析的表头
+ * @param count
+ */
+void QwtSeriesLoader::setHeaderLines(int count)
+{
+    m_data->settings.headerLines = qMax(count, 0);
+}
+
+/**
+ * @brief csv开头跳过的行数
+ * @return
+ */
+int QwtSeriesLoader::headerLines() const
+{
+    return m_data->settings.headerLines;
+}
+
+/**
+ * @brief 设置csv的x列和y列
+ * @param xColumn x列的索引，小于0时x = x0 + index * dx，见setSampling
+ * @param yColumn y列的索引
+ */
+void QwtSeriesLoader::setColumns(int xColumn, int yColumn)
+{
+    m_data->settings.xColumn = qMax(xColumn, -1);
+    m_data->settings.yColumn = qMax(yColumn, 0);
+}
+
+/**
+ * @brief csv的x列
+ * @return
+ */
+int QwtSeriesLoader::xColumn() const
+{
+    return m_data->settings.xColumn;
+}
+
+/**
+ * @brief csv的y列
+ * @return
+ */
+int QwtSeriesLoader::yColumn() const
+{
+    return m_data->settings.yColumn;
+}
+
+/**
+ * @brief 设置二进制文件的格式
+ * @param type 数值类型
+ * @param layout 数值的排列方式，ValuesOnly时x由setSampling计算
+ * @param offset 第一个数值在文件中的位置
+ * @sa QwtMappedPointData
+ */
+void QwtSeriesLoader::setBinaryFormat(QwtMappedPointData::DataType type, QwtMappedPointData::Layout layout, qint64 offset)
+{
+    m_data->settings.dataType = type;
+    m_data->settings.layout   = layout;
+    m_data->settings.offset   = qMax(offset, qint64(0));
+}
+
+/**
+ * @brief 二进制文件的数值类型
+ * @return
+ */
+QwtMappedPointData::DataType QwtSeriesLoader::binaryDataType() const
+{
+    return m_data->settings.dataType;
+}
+
+/**
+ * @brief 二进制文件的数值排列方式
+ * @return
+ */
+QwtMappedPointData::Layout QwtSeriesLoader::binaryLayout() const
+{
+    return m_data->settings.layout;
+}
+
+/**
+ * @brief 二进制文件中第一个数值的位置
+ * @return
+ */
+qint64 QwtSeriesLoader::binaryOffset() const
+{
+    return m_data->settings.offset;
+}
+
+/**
+ * @brief 设置没有x值时x的计算方式：x = x0 + index * dx
+ * @param x0
+ * @param dx
+ */
+void QwtSeriesLoader::setSampling(double x0, double dx)
+{
+    m_data->settings.x0 = x0;
+    m_data->settings.dx = dx;
+}
+
+/**
+ * @brief 第一个点的x值
+ * @return
+ */
+double QwtSeriesLoader::xOrigin() const
+{
+    return m_data->settings.x0;
+}
+
+/**
+ * @brief 相邻点x值的间隔
+ * @return
+ */
+double QwtSeriesLoader::xStep() const
+{
+    return m_data->settings.dx;
+}
+
+/**
+ * @brief 设置预览的最大点数
+ *
+ * 已加载的点数超过此值时，预览中每个区间只保留y的最小值和最大值
+ * @param points 点数，0表示加载过程中不发布预览
+ */
+void QwtSeriesLoader::setPreviewSize(int points)
+{
+    m_data->settings.previewSize = qMax(points, 0);
+}
+
+/**
+ * @brief 预览的最大点数
+ * @return
+ */
+int QwtSeriesLoader::previewSize() const
+{
+    return m_data->settings.previewSize;
+}
+
+/**
+ * @brief 设置发布预览的最小间隔
+ * @param ms 毫秒
+ */
+void QwtSeriesLoader::setPreviewInterval(int ms)
+{
+    m_data->settings.previewInterval = qMax(ms, 0);
+}
+
+/**
+ * @brief 发布预览的最小间隔
+ * @return
+ */
+int QwtSeriesLoader::previewInterval() const
+{
+    return m_data->settings.previewInterval;
+}
+
+/**
+ * @brief 发布预览和最终结果的数据源
+ *
+ * 可以用QwtSharedPointData关联此数据源，在samplesAvailable信号中调用QwtSharedPointData::update
+ * @return
+ */
+const QwtSharedPointSource* QwtSeriesLoader::source() const
+{
+    return &m_data->source;
+}
+
+/**
+ * @brief 让曲线显示加载的数据
+ *
+ * 曲线的数据被替换为关联source()的QwtSharedPointData，每次发布新的数据后更新曲线并重绘
+ * @param curve 曲线，必须已经关联到绘图
+ * @return 曲线没有关联到绘图时返回false
+ */
+bool QwtSeriesLoader::attachCurve(QwtPlotCurve* curve)
+{
+    if (!curve || !curve->plot()) {
+        return false;
+    }
+
+    QWT_D(d);
+    curve->setData(new QwtSharedPointData(&d->source));
+
+    QwtSeriesLoaderCurve c;
+    c.plot  = curve->plot();
+    c.curve = curve;
+    d->curves.append(c);
+    return true;
+}
+
+/**
+ * @brief 在当前线程加载文件
+ *
+ * 文件的各个块仍然是并行解析的
+ * @param fileName 文件名
+ * @return 成功返回true，失败时见errorString
+ */
+bool QwtSeriesLoader::load(const QString& fileName)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    QWT_D(d);
+    d->canceled.storeRelease(0);
+    return d->run(d->settings, fileName);
+}
+
+/**
+ * @brief 在工作线程加载文件
+ *
+ * 加载过程中的设置修改对本次加载不起作用
+ * @param fileName 文件名
+ * @return 正在加载时返回false
+ * @sa finished, progressChanged
+ */
+bool QwtSeriesLoader::start(const QString& fileName)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    QWT_D(d);
+    d->canceled.storeRelease(0);
+#if QWT_USE_THREADS
+    PrivateData* dp                        = d;
+    const QwtSeriesLoaderSettings settings = d->settings;
+    d->future = QtConcurrent::run([ dp, settings, fileName ]() { return dp->run(settings, fileName); });
+#else
+    d->run(d->settings, fileName);
+#endif
+    return true;
+}
+
+/**
+ * @brief 取消加载，加载在处理完当前的块后结束
+ */
+void QwtSeriesLoader::cancel()
+{
+    m_data->canceled.storeRelease(1);
+}
+
+/**
+ * @brief 是否正在加载
+ * @return
+ */
+bool QwtSeriesLoader::isRunning() const
+{
+#if QWT_USE_THREADS
+    return m_data->future.isRunning();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 等待加载结束
+ */
+void QwtSeriesLoader::waitForFinished()
+{
+#if QWT_USE_THREADS
+    m_data->future.waitForFinished();
+#endif
+}
+
+/**
+ * @brief 加载的结果，加载失败或者还没有结束时为空
+ * @return
+ */
+QwtSharedPointBuffer QwtSeriesLoader::result() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->result;
+}
+
+/**
+ * @brief 最后一次加载失败的原因
+ * @return
+ */
+QString QwtSeriesLoader::errorString() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->errorString;
+}
+
+void QwtSeriesLoader::updateCurves()
+{
+    QWT_D(d);
+    QSet< QwtPlot* > plots;
+
+    for (int i = d->curves.size() - 1; i >= 0; --i) {
+        const QwtSeriesLoaderCurve& c = d->curves[ i ];
+
+        // 曲线已经从绘图上移除或者被删除
+        if (!c.plot || !c.plot->itemList().contains(c.curve)) {
+            d->curves.removeAt(i);
+            continue;
+        }
+
+        // 曲线的数据被替换了
+        QwtSharedPointData* data = dynamic_cast< QwtSharedPointData* >(c.curve->data());
+        if (!data || data->source() != &d->source) {
+            d->curves.removeAt(i);
+            continue;
+        }
+
+        if (data->update()) {
+            c.curve->itemChanged();
+            if (!c.plot->autoReplot()) {
+                plots.insert(c.plot.data());
+            }
+        }
+    }
+
+    for (QwtPlot* plot : qAsConst(plots)) {
+        plot->replot();
+    }
+}
@@ -0,0 +1,140 @@
+﻿#ifndef QWT_SERIES_LOADER_H
+#define QWT_SERIES_LOADER_H
+// Qt
+#include <QObject>
+#include <QString>
+// qwt
+#include "qwt_global.h"
+#include "qwt_mapped_point_data.h"
+#include "qwt_shared_point_data.h"
+class QwtPlotCurve;
+
+/**
+ * @brief Loads point series from CSV or raw binary files
+ * @brief 从CSV或二进制文件加载点序列
+ *
+ * The file is split into chunks, that are parsed in parallel and written directly into the
+ * final array of points - there is no intermediate QVector<double> per column and no copy
+ * when the result is handed over as QwtSharedPointBuffer.
+ *
+ * 文件被分成多个块并行解析，解析结果直接写入最终的点数组，不需要每列一个的中间QVector<double>，
+ * 结果以QwtSharedPointBuffer的形式交出，也不需要再拷贝
+ *
+ * - Csv: the columns are selected with setColumns(), the delimiter is detected
+ *   from the first data line unless set by setDelimiter(). Lines that can't be parsed
+ *   (headers, comments starting with '#') are skipped.
+ * - Binary: the file is memory mapped with QwtMappedPointData and converted. For files
+ *   that don't fit into memory use QwtMappedPointData directly instead.
+ *
+ * start() loads in a worker thread. While loading, a decimated preview of the samples
+ * parsed so far is published to source() every previewInterval() milliseconds, so that
+ * attached curves show the data before loading has finished. The preview has at most
+ * previewSize() points, so it does not increase the peak memory noticeably.
+ *
+ * start()在工作线程中加载。加载过程中，每隔previewInterval()毫秒把已解析数据的抽稀预览发布到source()，
+ * 通过attachCurve关联的曲线在加载完成前就能显示数据
+ *
+ * @code
+ * QwtSeriesLoader* loader = new QwtSeriesLoader(this);
+ * loader->setColumns(0, 2);
+ * loader->attachCurve(curve);
+ * connect(loader, &QwtSeriesLoader::progressChanged, progressBar, ...);
+ * loader->start("measurement.csv");
+ * @endcode
+ *
+ * @sa QwtSharedPointSource, QwtSharedPointData, QwtMappedPointData
+ */
+class QWT_EXPORT QwtSeriesLoader : public QObject
+{
+    Q_OBJECT
+    QWT_DECLARE_PRIVATE(QwtSeriesLoader)
+public:
+    /**
+     * @brief 文件格式
+     */
+    enum Format
+    {
+        Csv,    ///< 文本，每行一个点（默认）
+        Binary  ///< 二进制数值，格式见setBinaryFormat
+    };
+
+    explicit QwtSeriesLoader(QObject* par = nullptr);
+    ~QwtSeriesLoader();
+
+    // 文件格式
+    void setFormat(Format f);
+    Format format() const;
+
+    // csv的分隔符，QChar()表示自动识别
+    void setDelimiter(QChar c);
+    QChar delimiter() const;
+    // csv开头跳过的行数
+    void setHeaderLines(int count);
+    int headerLines() const;
+    // csv的x列和y列，x列小于0时x由setSampling计算
+    void setColumns(int xColumn, int yColumn);
+    int xColumn() const;
+    int yColumn() const;
+
+    // 二进制文件的格式
+    void setBinaryFormat(QwtMappedPointData::DataType type,
+                         QwtMappedPointData::Layout layout = QwtMappedPointData::Interleaved,
+                         qint64 offset                     = 0);
+    QwtMappedPointData::DataType binaryDataType() const;
+    QwtMappedPointData::Layout binaryLayout() const;
+    qint64 binaryOffset() const;
+
+    // 没有x值时，x = x0 + index * dx
+    void setSampling(double x0, double dx);
+    double xOrigin() const;
+    double xStep() const;
+
+    // 预览的最大点数，0表示加载过程中不发布预览
+    void setPreviewSize(int points);
+    int previewSize() const;
+    // 发布预览的最小间隔
+    void setPreviewInterval(int ms);
+    int previewInterval() const;
+
+    // 发布预览和最终结果的数据源
+    const QwtSharedPointSource* source() const;
+    // 让曲线显示加载的数据，曲线必须已经关联到绘图
+    bool attachCurve(QwtPlotCurve* curve);
+
+    // 在当前线程加载，分块解析仍然是并行的
+    bool load(const QString& fileName);
+    // 在工作线程加载
+    bool start(const QString& fileName);
+    void cancel();
+    bool isRunning() const;
+    void waitForFinished();
+
+    // 加载的结果
+    QwtSharedPointBuffer result() const;
+    QString errorString() const;
+
+Q_SIGNALS:
+    /**
+     * @brief 加载进度，csv为字节数，二进制为点数
+     * @note 从加载线程发出
+     */
+    void progressChanged(qint64 done, qint64 total);
+
+    /**
+     * @brief source()发布了新的数据（预览或最终结果）
+     * @note 从加载线程发出
+     */
+    void samplesAvailable();
+
+    /**
+     * @brief 加载结束
+     * @param ok 是否成功
+     * @note 从加载线程发出
+     */
+    void finished(bool ok);
+
+private Q_SLOTS:
+    void updateCurves();
+};
+
+#endif  // QWT_SERIES_LOADER_H
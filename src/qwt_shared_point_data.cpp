@@ -0,0 +1,334 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_shared_point_data.h"
+
+#include <qatomic.h>
+#include <qmutex.h>
+
+#include <utility>
+
+class QwtSharedPointBuffer::PrivateData
+{
+public:
+    explicit PrivateData(const QVector< QPointF >& points)
+        : samples(points)
+    {
+        initBoundingRect();
+    }
+
+    explicit PrivateData(QVector< QPointF >&& points)
+        : samples(std::move(points))
+    {
+        initBoundingRect();
+    }
+
+    QVector< QPointF > samples;
+    QRectF boundingRect;
+
+private:
+    void initBoundingRect()
+    {
+        // shares the vector, no deep copy
+        const QwtPointSeriesData data(samples);
+        boundingRect = qwtBoundingRect(data);
+    }
+};
+
+//! Constructs an empty buffer
+QwtSharedPointBuffer::QwtSharedPointBuffer()
+{
+}
+
+/*!
+   \brief Constructor
+
+   \param samples Points, QVector is implicitly shared
+ */
+QwtSharedPointBuffer::QwtSharedPointBuffer(const QVector< QPointF >& samples)
+    : m_data(new PrivateData(samples))
+{
+}
+
+/*!
+   \brief Constructor
+
+   \param samples Points
+ */
+QwtSharedPointBuffer::QwtSharedPointBuffer(QVector< QPointF >&& samples)
+    : m_data(new PrivateData(std::move(samples)))
+{
+}
+
+/*!
+   \brief Constructor
+
+   The coordinates are copied into an array of points once.
+   When the vectors have a different size the surplus values are ignored.
+
+   \param xData x coordinates
+   \param yData y coordinates
+ */
+QwtSharedPointBuffer::QwtSharedPointBuffer(const QVector< double >& xData, const QVector< double >& yData)
+{
+    const int numPoints = qMin(xData.size(), yData.size());
+
+    QVector< QPointF > points(numPoints);
+
+    const double* x = xData.constData();
+    const double* y = yData.constData();
+    QPointF* p      = points.data();
+
+    for (int i = 0; i < numPoints; i++)
+        p[ i ] = QPointF(x[ i ], y[ i ]);
+
+    m_data.reset(new PrivateData(std::move(points)));
+}
+
+//! \return True, when the buffer has no samples
+bool QwtSharedPointBuffer::isEmpty() const
+{
+    return size() == 0;
+}
+
+//! \return Number of samples
+size_t QwtSharedPointBuffer::size() const
+{
+    return m_data ? size_t(m_data->samples.size()) : 0;
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QPointF QwtSharedPointBuffer::sample(size_t index) const
+{
+    return m_data->samples.constData()[ index ];
+}
+
+//! \return Samples of the buffer
+const QVector< QPointF >& QwtSharedPointBuffer::samples() const
+{
+    static const QVector< QPointF > noSamples;
+    return m_data ? m_data->samples : noSamples;
+}
+
+/*!
+   \return Bounding rectangle of the samples,
+           calculated when the buffer has been constructed
+ */
+QRectF QwtSharedPointBuffer::boundingRect() const
+{
+    return m_data ? m_data->boundingRect : QRectF(1.0, 1.0, -2.0, -2.0);
+}
+
+//! \return True, when both buffers share the same samples
+bool QwtSharedPointBuffer::operator==(const QwtSharedPointBuffer& other) const
+{
+    return m_data == other.m_data;
+}
+
+//! \return True, when the buffers don't share the same samples
+bool QwtSharedPointBuffer::operator!=(const QwtSharedPointBuffer& other) const
+{
+    return m_data != other.m_data;
+}
+
+class QwtSharedPointSource::PrivateData
+{
+public:
+    mutable QMutex mutex;
+    QwtSharedPointBuffer buffer;
+    QAtomicInt revision;
+};
+
+//! Constructor
+QwtSharedPointSource::QwtSharedPointSource()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtSharedPointSource::~QwtSharedPointSource()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Replace the current buffer, can be called from any thread
+
+   The previous buffer stays valid as long as it is referenced somewhere.
+
+   \param buffer New buffer
+   \sa current(), revision()
+ */
+void QwtSharedPointSource::publish(const QwtSharedPointBuffer& buffer)
+{
+    QwtSharedPointBuffer previous = buffer;
+
+    {
+        QMutexLocker locker(&m_data->mutex);
+        qSwap(m_data->buffer, previous);
+        m_data->revision.fetchAndAddOrdered(1);
+    }
+
+    // the previous buffer might be released here, outside of the lock
+}
+
+/*!
+   \return Current buffer, can be called from any thread
+   \sa publish()
+ */
+QwtSharedPointBuffer QwtSharedPointSource::current() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->buffer;
+}
+
+/*!
+   \return Number of publish() calls
+   \sa publish()
+ */
+int QwtSharedPointSource::revision() const
+{
+    return m_data->revision.loadAcquire();
+}
+
+class QwtSharedPointData::PrivateData
+{
+public:
+    PrivateData()
+        : source(NULL)
+        , revision(0)
+    {
+    }
+
+    QwtSharedPointBuffer buffer;
+
+    const QwtSharedPointSource* source;
+    int revision;
+};
+
+/*!
+   \brief Constructor
+
+   \param buffer Buffer with the samples
+ */
+QwtSharedPointData::QwtSharedPointData(const QwtSharedPointBuffer& buffer)
+{
+    m_data         = new PrivateData();
+    m_data->buffer = buffer;
+}
+
+/*!
+   \brief Constructor
+
+   \param source Source providing the buffer
+   \sa update()
+ */
+QwtSharedPointData::QwtSharedPointData(const QwtSharedPointSource* source)
+{
+    m_data = new PrivateData();
+    setSource(source);
+}
+
+//! Destructor
+QwtSharedPointData::~QwtSharedPointData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign a buffer
+
+   \param buffer Buffer with the samples
+   \note When the data is connected to a source, the buffer will be
+         replaced by the next update()
+ */
+void QwtSharedPointData::setBuffer(const QwtSharedPointBuffer& buffer)
+{
+    m_data->buffer = buffer;
+}
+
+//! \return Buffer with the samples
+QwtSharedPointBuffer QwtSharedPointData::buffer() const
+{
+    return m_data->buffer;
+}
+
+/*!
+   \brief Connect the data to a source
+
+   The current buffer of the source is assigned immediately.
+
+   \param source Source, might be NULL
+   \sa update()
+ */
+void QwtSharedPointData::setSource(const QwtSharedPointSource* source)
+{
+    m_data->source = source;
+    if (source) {
+        m_data->revision = source->revision();
+        m_data->buffer   = source->current();
+    }
+}
+
+//! \return Source of the buffer
+const QwtSharedPointSource* QwtSharedPointData::source() const
+{
+    return m_data->source;
+}
+
+/*!
+   \brief Pick up the latest buffer of the source
+
+   Has to be called from the thread, that is using the data - usually
+   the GUI thread - followed by a replot, when the buffer has changed.
+
+   \return True, when a new buffer has been assigned
+   \sa setSource(), QwtSharedPointSource::publish()
+ */
+bool QwtSharedPointData::update()
+{
+    const QwtSharedPointSource* source = m_data->source;
+    if (source == NULL)
+        return false;
+
+    const int revision = source->revision();
+    if (revision == m_data->revision)
+        return false;
+
+    m_data->revision = revision;
+
+    const QwtSharedPointBuffer buffer = source->current();
+    if (buffer == m_data->buffer)
+        return false;
+
+    m_data->buffer = buffer;
+    return true;
+}
+
+//! \return Number of samples
+size_t QwtSharedPointData::size() const
+{
+    return m_data->buffer.size();
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QPointF QwtSharedPointData::sample(size_t index) const
+{
+    return m_data->buffer.sample(index);
+}
+
+//! \return Bounding rectangle of the buffer
+QRectF QwtSharedPointData::boundingRect() const
+{
+    return m_data->buffer.boundingRect();
+}
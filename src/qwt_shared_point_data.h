@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SHARED_POINT_DATA_H
+#define QWT_SHARED_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qsharedpointer.h>
+
+/*!
+   \brief Immutable, reference counted block of points
+
+   A QwtSharedPointBuffer is a value type: copying it only increments
+   an atomic reference counter, the samples are never copied again after
+   construction. As the content can't be modified, copies can be passed
+   between threads and referenced by any number of curves, pickers or
+   exporters at the same time. The memory is released, when the last
+   copy is gone.
+
+   The bounding rectangle is calculated once in the constructor - usually
+   in the thread producing the samples - and shared as well.
+
+   \sa QwtSharedPointSource, QwtSharedPointData
+ */
+class QWT_EXPORT QwtSharedPointBuffer
+{
+public:
+    QwtSharedPointBuffer();
+    explicit QwtSharedPointBuffer(const QVector< QPointF >& samples);
+    explicit QwtSharedPointBuffer(QVector< QPointF >&& samples);
+    QwtSharedPointBuffer(const QVector< double >& xData, const QVector< double >& yData);
+
+    bool isEmpty() const;
+    size_t size() const;
+
+    QPointF sample(size_t index) const;
+    const QVector< QPointF >& samples() const;
+
+    QRectF boundingRect() const;
+
+    bool operator==(const QwtSharedPointBuffer&) const;
+    bool operator!=(const QwtSharedPointBuffer&) const;
+
+private:
+    class PrivateData;
+    QSharedPointer< const PrivateData > m_data;
+};
+
+/*!
+   \brief Publishes the latest version of a QwtSharedPointBuffer
+
+   A producer thread builds a new buffer and hands it over with publish().
+   Consumers - usually QwtSharedPointData objects in the GUI thread -
+   fetch the current buffer with current(). Both operations swap a
+   pointer under a short lock, independent of the number of samples.
+
+   revision() is incremented with each publish() and can be polled without
+   locking to find out, if there is anything new.
+
+   \code
+   // producer thread
+   source->publish( QwtSharedPointBuffer( points ) );
+
+   // GUI thread, f.e. from a timer
+   if ( data->update() )
+       plot->replot();
+   \endcode
+
+   \sa QwtSharedPointData
+ */
+class QWT_EXPORT QwtSharedPointSource
+{
+public:
+    QwtSharedPointSource();
+    ~QwtSharedPointSource();
+
+    void publish(const QwtSharedPointBuffer&);
+    QwtSharedPointBuffer current() const;
+
+    int revision() const;
+
+private:
+    Q_DISABLE_COPY(QwtSharedPointSource)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+/*!
+   \brief Series data referencing a QwtSharedPointBuffer
+
+   Assigning a buffer doesn't copy any samples, so the same buffer can
+   be displayed by many curves. When the data is connected to a
+   QwtSharedPointSource, update() picks up the latest published buffer.
+
+   \note The source has to outlive the data object.
+   \sa QwtPlotCurve::setSamples()
+ */
+class QWT_EXPORT QwtSharedPointData : public QwtSeriesData< QPointF >
+{
+public:
+    explicit QwtSharedPointData(const QwtSharedPointBuffer& = QwtSharedPointBuffer());
+    explicit QwtSharedPointData(const QwtSharedPointSource*);
+
+    virtual ~QwtSharedPointData();
+
+    void setBuffer(const QwtSharedPointBuffer&);
+    QwtSharedPointBuffer buffer() const;
+
+    void setSource(const QwtSharedPointSource*);
+    const QwtSharedPointSource* source() const;
+
+    bool update();
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample(size_t index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+private:
+    Q_DISABLE_COPY(QwtSharedPointData)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -34,6 +34,7 @@
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qmargins.h>
@@ -116,6 +117,10 @@ public:
     int mouseOffset;
 
     mutable QSize sizeHintCache;
+
+    // scale and trough, that don't depend on the value
+    QPixmap pixmapCache;
+    QPixmap troughCache;
 };
 /*!
    Construct vertical slider in QwtSlider::Trough style
@@ -380,6 +385,7 @@ QwtScaleDraw* QwtSlider::scaleDraw()
 void QwtSlider::scaleChange()
 {
     QwtAbstractSlider::scaleChange();
+    invalidateCache();
 
     if (testAttribute(Qt::WA_WState_Polished))
         layoutSlider(true);
@@ -411,10 +417,46 @@ int QwtSlider::updateInterval() const
 /*!
    Draw the slider into the specified rectangle.
 
+   The trough and the groove don't depend on the value. When painting
+   the widget they are cached and only the handle is painted
+   by drawHandle() on top of them. Reimplementations, that call
+   QwtSlider::drawSlider() and paint something, that depends on
+   anything else than the geometry, palette or scale, need to call
+   invalidateCache(), when it changes. Reimplementations, that don't
+   call it, bypass the cache.
+
    \param painter Painter
    \param sliderRect Bounding rectangle of the slider
+
+   \sa invalidateCache()
  */
 void QwtSlider::drawSlider(QPainter* painter, const QRect& sliderRect) const
+{
+    if (painter->device() == this && sliderRect == m_data->sliderRect) {
+        const QSize cacheSize = sliderRect.size() * QwtPainter::devicePixelRatio(this);
+        if (m_data->troughCache.size() != cacheSize) {
+            m_data->troughCache = QwtPainter::backingStore(const_cast< QwtSlider* >(this), sliderRect.size());
+            m_data->troughCache.fill(Qt::transparent);
+
+            QPainter p(&m_data->troughCache);
+            p.translate(-sliderRect.topLeft());
+            drawTrough(&p, sliderRect);
+        }
+
+        painter->drawPixmap(sliderRect.topLeft(), m_data->troughCache);
+    } else {
+        drawTrough(painter, sliderRect);
+    }
+
+    if (isValid())
+        drawHandle(painter, handleRect(), transform(value()));
+}
+
+/*
+   Draw the trough and the groove, the part of the slider
+   that doesn't depend on the value
+ */
+void QwtSlider::drawTrough(QPainter* painter, const QRect& sliderRect) const
 {
     QRect innerRect(sliderRect);
 
@@ -452,9 +494,6 @@ void QwtSlider::drawSlider(QPainter* painter, const QRect& sliderRect) const
         QBrush brush = palette().brush(QPalette::Dark);
         qDrawShadePanel(painter, slotRect, palette(), true, 1, &brush);
     }
-
-    if (isValid())
-        drawHandle(painter, handleRect(), transform(value()));
 }
 
 /*!
@@ -653,8 +692,20 @@ void QwtSlider::paintEvent(QPaintEvent* event)
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
 
     if (m_data->scalePosition != QwtSlider::NoScale) {
-        if (!m_data->sliderRect.contains(event->rect()))
-            scaleDraw()->draw(&painter, palette());
+        if (!m_data->sliderRect.contains(event->rect())) {
+            const QSize cacheSize = size() * QwtPainter::devicePixelRatio(this);
+            if (m_data->pixmapCache.size() != cacheSize) {
+                m_data->pixmapCache = QwtPainter::backingStore(this, size());
+                m_data->pixmapCache.fill(Qt::transparent);
+
+                QPainter p(&m_data->pixmapCache);
+                p.setFont(font());
+
+                scaleDraw()->draw(&p, palette());
+            }
+
+            painter.drawPixmap(0, 0, m_data->pixmapCache);
+        }
     }
 
     drawSlider(&painter, m_data->sliderRect);
@@ -663,6 +714,20 @@ void QwtSlider::paintEvent(QPaintEvent* event)
         QwtPainter::drawFocusRect(&painter, this, m_data->sliderRect);
 }
 
+/*!
+   Invalidate the cached static layer ( scale and trough ).
+
+   The cache is invalidated automatically, when the widget is resized
+   or its layout, palette or scale has changed. Applications and derived
+   classes need to call invalidateCache() and update() when they modify
+   anything else, that is painted into the static layer: f.e. the labels of a custom scale draw.
+ */
+void QwtSlider::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+    m_data->troughCache = QPixmap();
+}
+
 /*!
    Qt resize event handler
    \param event Resize event
@@ -693,6 +758,9 @@ bool QwtSlider::event(QEvent* event)
  */
 void QwtSlider::changeEvent(QEvent* event)
 {
+    // palette, enabled and activation state affect the cached colors
+    invalidateCache();
+
     if (event->type() == QEvent::StyleChange || event->type() == QEvent::FontChange) {
         if (testAttribute(Qt::WA_WState_Polished))
             layoutSlider(true);
@@ -789,6 +857,7 @@ void QwtSlider::layoutSlider(bool update_geometry)
     }
 
     m_data->sliderRect = sliderRect;
+    invalidateCache();
 
     scaleDraw()->move(scaleX, scaleY);
     scaleDraw()->setLength(scaleLength);
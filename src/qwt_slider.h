@@ -115,6 +115,8 @@ class QWT_EXPORT QwtSlider : public QwtAbstractSlider
     void setUpdateInterval( int );
     int updateInterval() const;
 
+    void invalidateCache();
+
   protected:
     virtual double scrolledTo( const QPoint& ) const QWT_OVERRIDE;
     virtual bool isScrollPosition( const QPoint& ) const QWT_OVERRIDE;
@@ -140,6 +142,7 @@ class QWT_EXPORT QwtSlider : public QwtAbstractSlider
     QwtScaleDraw* scaleDraw();
 
     void layoutSlider( bool );
+    void drawTrough( QPainter*, const QRect& ) const;
     void initSlider( Qt::Orientation );
 
     class PrivateData;
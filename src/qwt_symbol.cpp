@@ -28,6 +28,7 @@
 #include "qwt_painter.h"
 #include "qwt_graphic.h"
 #include "qwt_math.h"
+#include "qwt_render_stats.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
@@ -1404,6 +1405,10 @@ void QwtSymbol::drawSymbols( QPainter* painter,
     {
         const QRect br = boundingRect();
 
+        QwtRenderStats* stats = QwtRenderStats::active();
+        if ( stats )
+            stats->addCacheAccess( QwtRenderStats::SymbolCache, !m_data->cache.pixmap.isNull() );
+
         if ( m_data->cache.pixmap.isNull() )
         {
             m_data->cache.pixmap = QwtPainter::backingStore( NULL, br.size() );
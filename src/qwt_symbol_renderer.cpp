@@ -0,0 +1,658 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_symbol_renderer.h"
+#include "qwt_symbol.h"
+#include "qwt_color_map.h"
+#include "qwt_interval.h"
+#include "qwt_scale_map.h"
+#include "qwt_series_data.h"
+#include "qwt_point_3d.h"
+#include "qwt_math.h"
+
+#include <qimage.h>
+#include <qpainter.h>
+#include <qvector.h>
+#include <qmutex.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+// src over dst for premultiplied pixels, see BYTE_MUL in qdrawhelper_p.h
+static inline QRgb qwtBlendPremultiplied(QRgb src, QRgb dst)
+{
+    const uint alpha = qAlpha(src);
+    if (alpha == 255)
+        return src;
+
+    if (alpha == 0)
+        return dst;
+
+    const uint inv = 255 - alpha;
+
+    uint t = (dst & 0xff00ff) * inv;
+    t      = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+    t &= 0xff00ff;
+
+    uint x = ((dst >> 8) & 0xff00ff) * inv;
+    x      = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+    x &= 0xff00ff00;
+
+    return src + (x | t);
+}
+
+static inline int qwtSymbolLevel(double value, const QwtInterval& interval, int numLevels)
+{
+    if (numLevels <= 1)
+        return 0;
+
+    double ratio = (value - interval.minValue()) / interval.width();
+    ratio        = qBound(0.0, ratio, 1.0);
+
+    return qRound(ratio * (numLevels - 1));
+}
+
+// a symbol, that has been mapped to the image
+class QwtSymbolStamp
+{
+public:
+    int x;
+    int y;
+    int cell;
+};
+
+// a rectangle of the atlas, together with the offset to the symbol position
+class QwtAtlasCell
+{
+public:
+    QRect rect;
+    QPoint offset;
+};
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtSymbolCompositeCommand
+{
+public:
+    const QImage* atlas;
+    const QVector< QwtAtlasCell >* cells;
+    const QVector< QwtSymbolStamp >* stamps;
+    QImage* image;
+};
+
+static void qwtCompositeSymbols(const QwtSymbolCompositeCommand& command, int y0, int y1)
+{
+    const QwtSymbolStamp* stamps = command.stamps->constData();
+    const QwtAtlasCell* cells    = command.cells->constData();
+    const int numStamps          = command.stamps->size();
+
+    const int w = command.image->width();
+
+    for (int i = 0; i < numStamps; i++) {
+        const QwtSymbolStamp& stamp = stamps[ i ];
+        const QwtAtlasCell& cell    = cells[ stamp.cell ];
+
+        const int left = stamp.x + cell.offset.x();
+        const int top  = stamp.y + cell.offset.y();
+
+        // the band of the image, that belongs to this thread
+        const int r0 = qMax(top, y0);
+        const int r1 = qMin(top + cell.rect.height(), y1);
+        if (r0 >= r1)
+            continue;
+
+        const int c0 = qMax(left, 0);
+        const int c1 = qMin(left + cell.rect.width(), w);
+        if (c0 >= c1)
+            continue;
+
+        for (int row = r0; row < r1; row++) {
+            const QRgb* src = reinterpret_cast< const QRgb* >(command.atlas->constScanLine(cell.rect.top() + row - top));
+            src += cell.rect.left() + c0 - left;
+
+            QRgb* dst = reinterpret_cast< QRgb* >(command.image->scanLine(row)) + c0;
+
+            for (int col = c0; col < c1; col++) {
+                *dst = qwtBlendPremultiplied(*src, *dst);
+
+                src++;
+                dst++;
+            }
+        }
+    }
+}
+
+class QwtSymbolRenderer::PrivateData
+{
+public:
+    PrivateData()
+        : symbol(NULL)
+        , colorMap(NULL)
+        , minExtent(4)
+        , maxExtent(16)
+        , colorLevels(64)
+        , sizeLevels(16)
+        , atlasColorLevels(0)
+        , atlasSizeLevels(0)
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete symbol;
+        delete colorMap;
+    }
+
+    void updateAtlas(int numColors, int numSizes);
+
+    QwtSymbol* symbol;
+    QwtColorMap* colorMap;
+
+    QwtInterval colorInterval;
+    QwtInterval sizeInterval;
+
+    int minExtent;
+    int maxExtent;
+
+    int colorLevels;
+    int sizeLevels;
+
+    // the atlas is built on demand, when rendering. As render() is const
+    // and might be called from several threads, building and reading it
+    // is guarded by the mutex
+    mutable QMutex mutex;
+    QImage atlas;
+    QVector< QwtAtlasCell > cells;
+    int atlasColorLevels;
+    int atlasSizeLevels;
+};
+
+void QwtSymbolRenderer::PrivateData::updateAtlas(int numColors, int numSizes)
+{
+    if (!atlas.isNull() && atlasColorLevels == numColors && atlasSizeLevels == numSizes)
+        return;
+
+    atlasColorLevels = numColors;
+    atlasSizeLevels  = numSizes;
+
+    // the original attributes are restored, when the atlas is done
+    const QSize symbolSize = symbol->size();
+    const QBrush brush     = symbol->brush();
+    const QPen pen         = symbol->pen();
+
+    QVector< QRgb > colorTable;
+    if (numColors > 1)
+        colorTable = colorMap->colorTable(numColors);
+
+    QVector< QSize > sizes(numSizes);
+    if (numSizes > 1) {
+        // keeping the aspect ratio of the symbol
+        const double aspectRatio = symbolSize.isValid() && symbolSize.width() > 0
+                                       ? double(symbolSize.height()) / symbolSize.width()
+                                       : 1.0;
+
+        for (int i = 0; i < numSizes; i++) {
+            const double extent = minExtent + double(maxExtent - minExtent) * i / (numSizes - 1);
+            sizes[ i ] = QSize(qMax(1, qRound(extent)), qMax(1, qRound(extent * aspectRatio)));
+        }
+    } else {
+        sizes[ 0 ] = symbolSize;
+    }
+
+    // the largest symbol defines the size of a cell
+    symbol->setSize(sizes[ numSizes - 1 ]);
+    const QRect maxRect = symbol->boundingRect().adjusted(-1, -1, 1, 1);
+
+    const int cellWidth  = maxRect.width();
+    const int cellHeight = maxRect.height();
+
+    atlas = QImage(cellWidth * numColors, cellHeight * numSizes, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+
+    cells.resize(numColors * numSizes);
+
+    QPainter painter(&atlas);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    for (int s = 0; s < numSizes; s++) {
+        symbol->setSize(sizes[ s ]);
+        const QRect br = symbol->boundingRect().adjusted(-1, -1, 1, 1) & maxRect;
+
+        for (int c = 0; c < numColors; c++) {
+            if (numColors > 1)
+                symbol->setColor(QColor::fromRgba(colorTable[ c ]));
+
+            // the position of the symbol inside of its cell
+            const QPoint pos(c * cellWidth - maxRect.left(), s * cellHeight - maxRect.top());
+
+            QwtAtlasCell& cell = cells[ s * numColors + c ];
+            cell.rect          = br.translated(pos);
+            cell.offset        = br.topLeft();
+
+            painter.save();
+            painter.setClipRect(cell.rect);
+            symbol->drawSymbol(&painter, QPointF(pos));
+            painter.restore();
+        }
+    }
+
+    painter.end();
+
+    symbol->setSize(symbolSize);
+    symbol->setBrush(brush);
+    symbol->setPen(pen);
+}
+
+//! Constructor
+QwtSymbolRenderer::QwtSymbolRenderer()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtSymbolRenderer::~QwtSymbolRenderer()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the symbol
+
+   The renderer takes the ownership of the symbol. Color and size
+   of the symbol are modified temporarily, when building the atlas.
+
+   \param symbol Symbol
+   \sa symbol(), invalidateAtlas()
+ */
+void QwtSymbolRenderer::setSymbol(QwtSymbol* symbol)
+{
+    if (symbol != m_data->symbol) {
+        delete m_data->symbol;
+        m_data->symbol = symbol;
+
+        invalidateAtlas();
+    }
+}
+
+/*!
+   \return Symbol
+   \sa setSymbol()
+ */
+const QwtSymbol* QwtSymbolRenderer::symbol() const
+{
+    return m_data->symbol;
+}
+
+/*!
+   \brief Assign the color map for the color channel
+
+   The renderer takes the ownership of the color map. Without a color
+   map all symbols are painted with the colors of symbol().
+
+   \param colorMap Color map
+   \sa colorMap(), setColorInterval(), setColorLevels()
+ */
+void QwtSymbolRenderer::setColorMap(QwtColorMap* colorMap)
+{
+    if (colorMap != m_data->colorMap) {
+        delete m_data->colorMap;
+        m_data->colorMap = colorMap;
+
+        invalidateAtlas();
+    }
+}
+
+/*!
+   \return Color map for the color channel
+   \sa setColorMap()
+ */
+const QwtColorMap* QwtSymbolRenderer::colorMap() const
+{
+    return m_data->colorMap;
+}
+
+/*!
+   Set the range of the color values, that is mapped to the colorMap()
+
+   \param interval Range of the color values
+   \sa colorInterval(), setColorMap()
+ */
+void QwtSymbolRenderer::setColorInterval(const QwtInterval& interval)
+{
+    m_data->colorInterval = interval;
+}
+
+/*!
+   \return Range of the color values
+   \sa setColorInterval()
+ */
+QwtInterval QwtSymbolRenderer::colorInterval() const
+{
+    return m_data->colorInterval;
+}
+
+/*!
+   Set the range of the size values, that is mapped to
+   [ minSymbolExtent(), maxSymbolExtent() ]
+
+   \param interval Range of the size values
+   \sa sizeInterval(), setSymbolExtentRange()
+ */
+void QwtSymbolRenderer::setSizeInterval(const QwtInterval& interval)
+{
+    m_data->sizeInterval = interval;
+}
+
+/*!
+   \return Range of the size values
+   \sa setSizeInterval()
+ */
+QwtInterval QwtSymbolRenderer::sizeInterval() const
+{
+    return m_data->sizeInterval;
+}
+
+/*!
+   Set the extents in pixels of the smallest and the largest symbol
+
+   The extent is the width of the symbol, its height is
+   adjusted according to the aspect ratio of symbol()->size().
+   The default range is [4, 16].
+
+   \param minExtent Extent of the smallest symbol
+   \param maxExtent Extent of the largest symbol
+   \sa minSymbolExtent(), maxSymbolExtent(), setSizeInterval()
+ */
+void QwtSymbolRenderer::setSymbolExtentRange(int minExtent, int maxExtent)
+{
+    minExtent = qMax(minExtent, 1);
+    maxExtent = qMax(maxExtent, minExtent);
+
+    if (minExtent != m_data->minExtent || maxExtent != m_data->maxExtent) {
+        m_data->minExtent = minExtent;
+        m_data->maxExtent = maxExtent;
+
+        invalidateAtlas();
+    }
+}
+
+/*!
+   \return Extent of the smallest symbol
+   \sa setSymbolExtentRange()
+ */
+int QwtSymbolRenderer::minSymbolExtent() const
+{
+    return m_data->minExtent;
+}
+
+/*!
+   \return Extent of the largest symbol
+   \sa setSymbolExtentRange()
+ */
+int QwtSymbolRenderer::maxSymbolExtent() const
+{
+    return m_data->maxExtent;
+}
+
+/*!
+   Set the number of different colors in the atlas
+
+   Color values are quantized to this number of colors.
+   The default setting is 64.
+
+   \param numLevels Number of colors
+   \sa colorLevels(), setSizeLevels()
+ */
+void QwtSymbolRenderer::setColorLevels(int numLevels)
+{
+    numLevels = qBound(2, numLevels, 256);
+    if (numLevels != m_data->colorLevels) {
+        m_data->colorLevels = numLevels;
+        invalidateAtlas();
+    }
+}
+
+/*!
+   \return Number of different colors in the atlas
+   \sa setColorLevels()
+ */
+int QwtSymbolRenderer::colorLevels() const
+{
+    return m_data->colorLevels;
+}
+
+/*!
+   Set the number of different sizes in the atlas
+
+   Size values are quantized to this number of sizes.
+   The default setting is 16.
+
+   \param numLevels Number of sizes
+   \sa sizeLevels(), setColorLevels()
+ */
+void QwtSymbolRenderer::setSizeLevels(int numLevels)
+{
+    numLevels = qBound(2, numLevels, 256);
+    if (numLevels != m_data->sizeLevels) {
+        m_data->sizeLevels = numLevels;
+        invalidateAtlas();
+    }
+}
+
+/*!
+   \return Number of different sizes in the atlas
+   \sa setSizeLevels()
+ */
+int QwtSymbolRenderer::sizeLevels() const
+{
+    return m_data->sizeLevels;
+}
+
+/*!
+   Invalidate the atlas of pre-rasterized symbols
+
+   The atlas is invalidated, whenever an attribute of the renderer
+   is changed. But as symbol() might be modified without notifying
+   the renderer it might be necessary to call invalidateAtlas() manually.
+ */
+void QwtSymbolRenderer::invalidateAtlas()
+{
+    QMutexLocker locker(&m_data->mutex);
+
+    m_data->atlas = QImage();
+    m_data->cells.clear();
+}
+
+/*!
+   \return Atlas with the pre-rasterized symbols, that has been used
+          for the last render operation. The rows of the atlas contain
+          the sizes, the columns the colors.
+ */
+QImage QwtSymbolRenderer::atlas() const
+{
+    QMutexLocker locker(&m_data->mutex);
+    return m_data->atlas;
+}
+
+/*!
+   \brief Composite symbols into an image
+
+   \param image Image in QImage::Format_ARGB32_Premultiplied or QImage::Format_ARGB32
+   \param points Positions of the symbols in image coordinates
+   \param colorValues Values for the color channel, might be NULL
+   \param sizeValues Values for the size channel, might be NULL
+   \param numPoints Number of points
+   \param numThreads Number of threads to be used for compositing.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \note For QImage::Format_ARGB32 the symbols are blended like
+        being premultiplied, what is correct as long as the image
+        was transparent or opaque before.
+ */
+void QwtSymbolRenderer::render(QImage* image,
+                               const QPointF* points,
+                               const double* colorValues,
+                               const double* sizeValues,
+                               int numPoints,
+                               uint numThreads) const
+{
+    if (image == NULL || image->isNull() || numPoints <= 0)
+        return;
+
+    if (m_data->symbol == NULL || m_data->symbol->style() == QwtSymbol::NoSymbol)
+        return;
+
+    if (image->format() != QImage::Format_ARGB32_Premultiplied && image->format() != QImage::Format_ARGB32) {
+        *image = image->convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const bool hasColors = colorValues && m_data->colorMap && m_data->colorInterval.isValid()
+                           && m_data->colorInterval.width() > 0.0;
+    const bool hasSizes = sizeValues && m_data->sizeInterval.isValid() && m_data->sizeInterval.width() > 0.0;
+
+    const int numColors = hasColors ? m_data->colorLevels : 1;
+    const int numSizes  = hasSizes ? m_data->sizeLevels : 1;
+
+    // the atlas and the cells are implicitly shared: compositing works on
+    // copies, that can't be modified by concurrent render() calls
+    QImage atlas;
+    QVector< QwtAtlasCell > cells;
+    {
+        QMutexLocker locker(&m_data->mutex);
+
+        m_data->updateAtlas(numColors, numSizes);
+
+        atlas = m_data->atlas;
+        cells = m_data->cells;
+    }
+
+    QVector< QwtSymbolStamp > stamps;
+    stamps.reserve(numPoints);
+
+    for (int i = 0; i < numPoints; i++) {
+        const QPointF& pos = points[ i ];
+        if (qwt_is_nan_or_inf(pos))
+            continue;
+
+        int c = 0;
+        if (hasColors) {
+            if (qIsNaN(colorValues[ i ]))
+                continue;
+
+            c = qwtSymbolLevel(colorValues[ i ], m_data->colorInterval, numColors);
+        }
+
+        int s = 0;
+        if (hasSizes) {
+            if (qIsNaN(sizeValues[ i ]))
+                continue;
+
+            s = qwtSymbolLevel(sizeValues[ i ], m_data->sizeInterval, numSizes);
+        }
+
+        QwtSymbolStamp stamp;
+        stamp.x    = qRound(pos.x());
+        stamp.y    = qRound(pos.y());
+        stamp.cell = s * numColors + c;
+
+        stamps += stamp;
+    }
+
+    QwtSymbolCompositeCommand command;
+    command.atlas  = &atlas;
+    command.cells  = &cells;
+    command.stamps = &stamps;
+    command.image  = image;
+
+    const int h = image->height();
+
+#if QWT_USE_THREADS
+    if (numThreads == 0)
+        numThreads = QThread::idealThreadCount();
+
+    // bands less than a symbol high are not worth the effort
+    const int minBandHeight = qMax(atlas.height() / numSizes, 16);
+    numThreads              = qBound(1u, numThreads, uint(h / minBandHeight + 1));
+
+    if (numThreads > 1) {
+        const int bandHeight = h / numThreads;
+
+        QList< QFuture< void > > futures;
+        for (uint i = 0; i < numThreads; i++) {
+            const int y0 = i * bandHeight;
+            const int y1 = (i == numThreads - 1) ? h : y0 + bandHeight;
+
+            if (i == numThreads - 1) {
+                qwtCompositeSymbols(command, y0, y1);
+            } else {
+                futures += QtConcurrent::run(&qwtCompositeSymbols, command, y0, y1);
+            }
+        }
+
+        for (int i = 0; i < futures.size(); i++)
+            futures[ i ].waitForFinished();
+
+        return;
+    }
+#else
+    Q_UNUSED(numThreads)
+#endif
+
+    qwtCompositeSymbols(command, 0, h);
+}
+
+/*!
+   \brief Composite symbols for a series of 3D points into an image
+
+   The x and y coordinates are mapped by xMap and yMap. The z coordinate
+   is the value for both channels: it is mapped to a color by colorInterval()
+   and colorMap() and to a size by sizeInterval(). To use only one
+   of the channels, leave the interval of the other one invalid. Colors and
+   sizes, that depend on different values, need to be passed to the
+   overload taking separate arrays.
+
+   \param image Image in QImage::Format_ARGB32_Premultiplied or QImage::Format_ARGB32
+   \param xMap Maps x-values into image coordinates.
+   \param yMap Maps y-values into image coordinates.
+   \param series Series of points
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param numThreads Number of threads to be used for compositing.
+
+   \sa render(QImage*, const QPointF*, const double*, const double*, int, uint)
+ */
+void QwtSymbolRenderer::render(QImage* image,
+                               const QwtScaleMap& xMap,
+                               const QwtScaleMap& yMap,
+                               const QwtSeriesData< QwtPoint3D >* series,
+                               int from,
+                               int to,
+                               uint numThreads) const
+{
+    if (series == NULL || from > to)
+        return;
+
+    const int numPoints = to - from + 1;
+
+    QVector< QPointF > points(numPoints);
+    QVector< double > values(numPoints);
+
+    for (int i = 0; i < numPoints; i++) {
+        const QwtPoint3D sample = series->sample(from + i);
+
+        points[ i ] = QPointF(xMap.transform(sample.x()), yMap.transform(sample.y()));
+        values[ i ] = sample.z();
+    }
+
+    render(image, points.constData(), values.constData(), values.constData(), numPoints, numThreads);
+}
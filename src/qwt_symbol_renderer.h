@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SYMBOL_RENDERER_H
+#define QWT_SYMBOL_RENDERER_H
+
+#include "qwt_global.h"
+
+class QwtSymbol;
+class QwtColorMap;
+class QwtInterval;
+class QwtScaleMap;
+class QwtPoint3D;
+template< typename T >
+class QwtSeriesData;
+class QImage;
+class QPointF;
+
+/*!
+   \brief Batched renderer for symbols with a per point color and size
+
+   QwtSymbol paints all points with the same pen, brush and size. Varying
+   these attributes per point would need one QwtSymbol and one paint operation
+   for each point, what is way too slow for large data sets.
+
+   QwtSymbolRenderer pre-rasterizes a limited number of variants of a symbol
+   - colorLevels() colors times sizeLevels() sizes - into an atlas image.
+   The symbols are then composited from the atlas into a QImage row by row,
+   bypassing QPainter completely. The image is split into horizontal bands,
+   that can be composited in parallel without any locking.
+
+   The color of a point is found by mapping its color value through colorMap()
+   in the range of colorInterval(). Its size is interpolated between
+   minSymbolExtent() and maxSymbolExtent() according to the position of its
+   size value in sizeInterval(). A channel without values, or with an invalid
+   interval, falls back to the settings of symbol().
+
+   render() can be called from several threads for the same renderer,
+   as long as the renderer and its symbol are not modified at the same time.
+   Building the atlas modifies color and size of symbol() temporarily.
+   This is serialized with other render() calls by an internal mutex,
+   but not with other code reading symbol() meanwhile.
+
+   \sa QwtPlotCurve::setSymbolRenderer()
+ */
+class QWT_EXPORT QwtSymbolRenderer
+{
+public:
+    QwtSymbolRenderer();
+    ~QwtSymbolRenderer();
+
+    void setSymbol(QwtSymbol*);
+    const QwtSymbol* symbol() const;
+
+    void setColorMap(QwtColorMap*);
+    const QwtColorMap* colorMap() const;
+
+    void setColorInterval(const QwtInterval&);
+    QwtInterval colorInterval() const;
+
+    void setSizeInterval(const QwtInterval&);
+    QwtInterval sizeInterval() const;
+
+    void setSymbolExtentRange(int minExtent, int maxExtent);
+    int minSymbolExtent() const;
+    int maxSymbolExtent() const;
+
+    void setColorLevels(int);
+    int colorLevels() const;
+
+    void setSizeLevels(int);
+    int sizeLevels() const;
+
+    void invalidateAtlas();
+    QImage atlas() const;
+
+    void render(QImage*,
+                const QPointF* points,
+                const double* colorValues,
+                const double* sizeValues,
+                int numPoints,
+                uint numThreads = 1) const;
+
+    void render(QImage*,
+                const QwtScaleMap& xMap,
+                const QwtScaleMap& yMap,
+                const QwtSeriesData< QwtPoint3D >*,
+                int from,
+                int to,
+                uint numThreads = 1) const;
+
+private:
+    Q_DISABLE_COPY(QwtSymbolRenderer)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -28,9 +28,11 @@
 #include "qwt_scale_draw.h"
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qstyle.h>
@@ -126,6 +128,9 @@ public:
     QwtColorMap* colorMap;
 
     double value;
+
+    // scale and pipe, that don't depend on the value
+    QPixmap pixmapCache;
 };
 
 /*!
@@ -254,19 +259,41 @@ void QwtThermo::paintEvent(QPaintEvent* event)
 
     const QRect tRect = pipeRect();
 
-    if (!tRect.contains(event->rect())) {
+    const QSize cacheSize = size() * QwtPainter::devicePixelRatio(this);
+    if (m_data->pixmapCache.size() != cacheSize) {
+        m_data->pixmapCache = QwtPainter::backingStore(this, size());
+        m_data->pixmapCache.fill(Qt::transparent);
+
+        QPainter p(&m_data->pixmapCache);
+        p.setFont(font());
+
         if (m_data->scalePosition != QwtThermo::NoScale)
-            scaleDraw()->draw(&painter, palette());
-    }
+            scaleDraw()->draw(&p, palette());
 
-    const int bw = m_data->borderWidth;
+        const int bw = m_data->borderWidth;
 
-    const QBrush brush = palette().brush(QPalette::Base);
-    qDrawShadePanel(&painter, tRect.adjusted(-bw, -bw, bw, bw), palette(), true, bw, m_data->autoFillPipe ? &brush : NULL);
+        const QBrush brush = palette().brush(QPalette::Base);
+        qDrawShadePanel(&p, tRect.adjusted(-bw, -bw, bw, bw), palette(), true, bw, m_data->autoFillPipe ? &brush : NULL);
+    }
+
+    painter.drawPixmap(0, 0, m_data->pixmapCache);
 
     drawLiquid(&painter, tRect);
 }
 
+/*!
+   Invalidate the cached static layer ( scale and pipe ).
+
+   The cache is invalidated automatically, when the widget is resized
+   or its layout, palette or scale has changed. Applications and derived
+   classes need to call invalidateCache() and update() when they modify
+   anything else, that is painted into the static layer: f.e. the labels of a custom scale draw.
+ */
+void QwtThermo::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
 /*!
    Resize event handler
    \param event Resize event
@@ -283,6 +310,9 @@ void QwtThermo::resizeEvent(QResizeEvent* event)
  */
 void QwtThermo::changeEvent(QEvent* event)
 {
+    // palette, enabled and activation state affect the cached colors
+    invalidateCache();
+
     switch (event->type()) {
     case QEvent::StyleChange:
     case QEvent::FontChange: {
@@ -307,6 +337,8 @@ void QwtThermo::layoutThermo(bool update_geometry)
     const int bw        = m_data->borderWidth + m_data->spacing;
     const bool inverted = (upperBound() < lowerBound());
 
+    invalidateCache();
+
     int from, to;
 
     if (m_data->orientation == Qt::Horizontal) {
@@ -506,6 +538,7 @@ void QwtThermo::setScalePosition(ScalePosition scalePosition)
         return;
 
     m_data->scalePosition = scalePosition;
+    invalidateCache();
 
     if (testAttribute(Qt::WA_WState_Polished))
         layoutThermo(true);
@@ -528,6 +561,10 @@ void QwtThermo::scaleChange()
 
 /*!
    Redraw the liquid in thermometer pipe.
+
+   The liquid is painted on top of the cached static layer ( scale and pipe )
+   and is not cached itself.
+
    \param painter Painter
    \param pipeRect Bounding rectangle of the pipe without borders
  */
@@ -168,6 +168,8 @@ class QWT_EXPORT QwtThermo : public QwtAbstractScale
     void setScaleDraw( QwtScaleDraw* );
     const QwtScaleDraw* scaleDraw() const;
 
+    void invalidateCache();
+
   public Q_SLOTS:
     virtual void setValue( double );
 
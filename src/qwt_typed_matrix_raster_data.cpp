@@ -0,0 +1,571 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_typed_matrix_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qrect.h>
+
+static inline double qwtTypedHermiteInterpolate(double A, double B, double C, double D, double t)
+{
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+
+    const double a = -A / 2.0 + (3.0 * B) / 2.0 - (3.0 * C) / 2.0 + D / 2.0;
+    const double b = A - (5.0 * B) / 2.0 + 2.0 * C - D / 2.0;
+    const double c = -A / 2.0 + C / 2.0;
+    const double d = B;
+
+    return a * t3 + b * t2 + c * t + d;
+}
+
+namespace
+{
+// Geometry of the matrix, shared by the resampling functions of all value types
+struct QwtTypedMatrixGeometry
+{
+    double x0;
+    double y0;
+    double dx;
+    double dy;
+    int numColumns;
+    int numRows;
+};
+}
+
+template< typename T >
+static inline double qwtTypedMatrixValue(const T* values, const QwtTypedMatrixGeometry& g, int row, int col)
+{
+    return static_cast< double >(values[ row * g.numColumns + col ]);
+}
+
+template< typename T >
+static double qwtTypedNearest(const T* values, const QwtTypedMatrixGeometry& g, double x, double y)
+{
+    int row = int((y - g.y0) / g.dy);
+    int col = int((x - g.x0) / g.dx);
+
+    // the maximum of the intervals is included
+    if (row >= g.numRows)
+        row = g.numRows - 1;
+
+    if (col >= g.numColumns)
+        col = g.numColumns - 1;
+
+    return qwtTypedMatrixValue(values, g, row, col);
+}
+
+template< typename T >
+static double qwtTypedBilinear(const T* values, const QwtTypedMatrixGeometry& g, double x, double y)
+{
+    int col1 = qRound((x - g.x0) / g.dx) - 1;
+    int row1 = qRound((y - g.y0) / g.dy) - 1;
+    int col2 = col1 + 1;
+    int row2 = row1 + 1;
+
+    if (col1 < 0)
+        col1 = col2;
+    else if (col2 >= g.numColumns)
+        col2 = col1;
+
+    if (row1 < 0)
+        row1 = row2;
+    else if (row2 >= g.numRows)
+        row2 = row1;
+
+    const double v11 = qwtTypedMatrixValue(values, g, row1, col1);
+    const double v21 = qwtTypedMatrixValue(values, g, row1, col2);
+    const double v12 = qwtTypedMatrixValue(values, g, row2, col1);
+    const double v22 = qwtTypedMatrixValue(values, g, row2, col2);
+
+    const double x2 = g.x0 + (col2 + 0.5) * g.dx;
+    const double y2 = g.y0 + (row2 + 0.5) * g.dy;
+
+    const double rx = (x2 - x) / g.dx;
+    const double ry = (y2 - y) / g.dy;
+
+    const double vr1 = rx * v11 + (1.0 - rx) * v21;
+    const double vr2 = rx * v12 + (1.0 - rx) * v22;
+
+    return ry * vr1 + (1.0 - ry) * vr2;
+}
+
+template< typename T >
+static double qwtTypedBicubic(const T* values, const QwtTypedMatrixGeometry& g, double x, double y)
+{
+    const double colF = (x - g.x0) / g.dx;
+    const double rowF = (y - g.y0) / g.dy;
+
+    const int col = qRound(colF);
+    const int row = qRound(rowF);
+
+    int cols[ 4 ] = { col - 2, col - 1, col, col + 1 };
+    int rows[ 4 ] = { row - 2, row - 1, row, row + 1 };
+
+    if (cols[ 1 ] < 0)
+        cols[ 1 ] = cols[ 2 ];
+    if (cols[ 0 ] < 0)
+        cols[ 0 ] = cols[ 1 ];
+    if (cols[ 2 ] >= g.numColumns)
+        cols[ 2 ] = cols[ 1 ];
+    if (cols[ 3 ] >= g.numColumns)
+        cols[ 3 ] = cols[ 2 ];
+
+    if (rows[ 1 ] < 0)
+        rows[ 1 ] = rows[ 2 ];
+    if (rows[ 0 ] < 0)
+        rows[ 0 ] = rows[ 1 ];
+    if (rows[ 2 ] >= g.numRows)
+        rows[ 2 ] = rows[ 1 ];
+    if (rows[ 3 ] >= g.numRows)
+        rows[ 3 ] = rows[ 2 ];
+
+    const double dx = colF - col + 0.5;
+    const double dy = rowF - row + 0.5;
+
+    double v[ 4 ];
+    for (int i = 0; i < 4; i++) {
+        const T* line = values + rows[ i ] * g.numColumns;
+
+        v[ i ] = qwtTypedHermiteInterpolate(static_cast< double >(line[ cols[ 0 ] ]),
+                                            static_cast< double >(line[ cols[ 1 ] ]),
+                                            static_cast< double >(line[ cols[ 2 ] ]),
+                                            static_cast< double >(line[ cols[ 3 ] ]),
+                                            dx);
+    }
+
+    return qwtTypedHermiteInterpolate(v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ], dy);
+}
+
+template< typename T >
+static double qwtTypedResample(const void* values,
+                               QwtTypedMatrixRasterData::ResampleMode mode,
+                               const QwtTypedMatrixGeometry& g,
+                               double x,
+                               double y)
+{
+    const T* v = static_cast< const T* >(values);
+
+    switch (mode) {
+    case QwtTypedMatrixRasterData::BicubicInterpolation:
+        return qwtTypedBicubic(v, g, x, y);
+
+    case QwtTypedMatrixRasterData::BilinearInterpolation:
+        return qwtTypedBilinear(v, g, x, y);
+
+    case QwtTypedMatrixRasterData::NearestNeighbour:
+    default:
+        return qwtTypedNearest(v, g, x, y);
+    }
+}
+
+class QwtTypedMatrixRasterData::PrivateData
+{
+public:
+    PrivateData()
+        : resampleMode(QwtTypedMatrixRasterData::NearestNeighbour)
+        , valueType(QwtTypedMatrixRasterData::NoValues)
+        , values(NULL)
+        , numValues(0)
+        , numColumns(0)
+        , numRows(0)
+        , scale(1.0)
+        , offset(0.0)
+        , dx(0.0)
+        , dy(0.0)
+    {
+    }
+
+    template< typename T >
+    void assign(QwtTypedMatrixRasterData::ValueType type, const T* v, int count, int columns)
+    {
+        valueType  = type;
+        values     = v;
+        numValues  = qMax(count, 0);
+        numColumns = qMax(columns, 0);
+    }
+
+    void releaseVectors()
+    {
+        uint8Values.clear();
+        int16Values.clear();
+        uint16Values.clear();
+        floatValues.clear();
+    }
+
+    QwtInterval intervals[ 3 ];
+    QwtTypedMatrixRasterData::ResampleMode resampleMode;
+
+    QwtTypedMatrixRasterData::ValueType valueType;
+    const void* values;
+    int numValues;
+    int numColumns;
+    int numRows;
+
+    double scale;
+    double offset;
+
+    double dx;
+    double dy;
+
+    // owners of the values, when assigned by setValueMatrix()
+    QVector< quint8 > uint8Values;
+    QVector< qint16 > int16Values;
+    QVector< quint16 > uint16Values;
+    QVector< float > floatValues;
+};
+
+//! Constructor
+QwtTypedMatrixRasterData::QwtTypedMatrixRasterData()
+{
+    m_data = new PrivateData();
+    update();
+}
+
+//! Destructor
+QwtTypedMatrixRasterData::~QwtTypedMatrixRasterData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the resampling algorithm
+
+   \param mode Resampling mode
+   \sa resampleMode(), value()
+ */
+void QwtTypedMatrixRasterData::setResampleMode(ResampleMode mode)
+{
+    m_data->resampleMode = mode;
+}
+
+/*!
+   \return resampling algorithm
+   \sa setResampleMode(), value()
+ */
+QwtTypedMatrixRasterData::ResampleMode QwtTypedMatrixRasterData::resampleMode() const
+{
+    return m_data->resampleMode;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   The interval in Z direction refers to the scaled values.
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa QwtMatrixRasterData::setInterval(), setValueScale()
+ */
+void QwtTypedMatrixRasterData::setInterval(Qt::Axis axis, const QwtInterval& interval)
+{
+    if (axis >= 0 && axis <= 2) {
+        m_data->intervals[ axis ] = interval;
+        update();
+    }
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval
+ */
+QwtInterval QwtTypedMatrixRasterData::interval(Qt::Axis axis) const
+{
+    if (axis >= 0 && axis <= 2)
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Assign a matrix of 8 bit values
+
+   The vector is implicitly shared, no values are copied.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+   \sa setRawValueMatrix(), QwtMatrixRasterData::setValueMatrix()
+ */
+void QwtTypedMatrixRasterData::setValueMatrix(const QVector< quint8 >& values, int numColumns)
+{
+    m_data->releaseVectors();
+    m_data->uint8Values = values;
+    m_data->assign(UInt8, m_data->uint8Values.constData(), int(values.size()), numColumns);
+    update();
+}
+
+/*!
+   \brief Assign a matrix of signed 16 bit values
+
+   The vector is implicitly shared, no values are copied.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+   \sa setRawValueMatrix(), QwtMatrixRasterData::setValueMatrix()
+ */
+void QwtTypedMatrixRasterData::setValueMatrix(const QVector< qint16 >& values, int numColumns)
+{
+    m_data->releaseVectors();
+    m_data->int16Values = values;
+    m_data->assign(Int16, m_data->int16Values.constData(), int(values.size()), numColumns);
+    update();
+}
+
+/*!
+   \brief Assign a matrix of unsigned 16 bit values
+
+   The vector is implicitly shared, no values are copied.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+   \sa setRawValueMatrix(), QwtMatrixRasterData::setValueMatrix()
+ */
+void QwtTypedMatrixRasterData::setValueMatrix(const QVector< quint16 >& values, int numColumns)
+{
+    m_data->releaseVectors();
+    m_data->uint16Values = values;
+    m_data->assign(UInt16, m_data->uint16Values.constData(), int(values.size()), numColumns);
+    update();
+}
+
+/*!
+   \brief Assign a matrix of float values
+
+   The vector is implicitly shared, no values are copied.
+
+   \param values Vector of values
+   \param numColumns Number of columns
+   \sa setRawValueMatrix(), QwtMatrixRasterData::setValueMatrix()
+ */
+void QwtTypedMatrixRasterData::setValueMatrix(const QVector< float >& values, int numColumns)
+{
+    m_data->releaseVectors();
+    m_data->floatValues = values;
+    m_data->assign(Float32, m_data->floatValues.constData(), int(values.size()), numColumns);
+    update();
+}
+
+/*!
+   \brief Wrap an external buffer of 8 bit values
+
+   \param values Row by row values of the matrix
+   \param numColumns Number of columns
+   \param numRows Number of rows
+
+   \warning The buffer is not copied, the programmer has to assure, that
+            it remains valid as long as it is assigned.
+ */
+void QwtTypedMatrixRasterData::setRawValueMatrix(const quint8* values, int numColumns, int numRows)
+{
+    m_data->releaseVectors();
+    m_data->assign(UInt8, values, numColumns * numRows, numColumns);
+    update();
+}
+
+/*!
+   \brief Wrap an external buffer of signed 16 bit values
+
+   \param values Row by row values of the matrix
+   \param numColumns Number of columns
+   \param numRows Number of rows
+
+   \warning The buffer is not copied, the programmer has to assure, that
+            it remains valid as long as it is assigned.
+ */
+void QwtTypedMatrixRasterData::setRawValueMatrix(const qint16* values, int numColumns, int numRows)
+{
+    m_data->releaseVectors();
+    m_data->assign(Int16, values, numColumns * numRows, numColumns);
+    update();
+}
+
+/*!
+   \brief Wrap an external buffer of unsigned 16 bit values
+
+   \param values Row by row values of the matrix
+   \param numColumns Number of columns
+   \param numRows Number of rows
+
+   \warning The buffer is not copied, the programmer has to assure, that
+            it remains valid as long as it is assigned.
+ */
+void QwtTypedMatrixRasterData::setRawValueMatrix(const quint16* values, int numColumns, int numRows)
+{
+    m_data->releaseVectors();
+    m_data->assign(UInt16, values, numColumns * numRows, numColumns);
+    update();
+}
+
+/*!
+   \brief Wrap an external buffer of float values
+
+   \param values Row by row values of the matrix
+   \param numColumns Number of columns
+   \param numRows Number of rows
+
+   \warning The buffer is not copied, the programmer has to assure, that
+            it remains valid as long as it is assigned.
+ */
+void QwtTypedMatrixRasterData::setRawValueMatrix(const float* values, int numColumns, int numRows)
+{
+    m_data->releaseVectors();
+    m_data->assign(Float32, values, numColumns * numRows, numColumns);
+    update();
+}
+
+//! \return Type of the values in the matrix
+QwtTypedMatrixRasterData::ValueType QwtTypedMatrixRasterData::valueType() const
+{
+    return m_data->valueType;
+}
+
+/*!
+   \return Pointer to the values, that have to be interpreted according to valueType()
+   \sa valueType()
+ */
+const void* QwtTypedMatrixRasterData::rawValues() const
+{
+    return m_data->values;
+}
+
+/*!
+   \brief Set a linear mapping from the raw to the physical values
+
+   value() returns raw * scale + offset.
+
+   \param scale Scale factor
+   \param offset Offset
+   \sa valueScale(), valueOffset()
+ */
+void QwtTypedMatrixRasterData::setValueScale(double scale, double offset)
+{
+    m_data->scale  = scale;
+    m_data->offset = offset;
+}
+
+//! \return Scale factor from the raw to the physical values
+double QwtTypedMatrixRasterData::valueScale() const
+{
+    return m_data->scale;
+}
+
+//! \return Offset from the raw to the physical values
+double QwtTypedMatrixRasterData::valueOffset() const
+{
+    return m_data->offset;
+}
+
+/*!
+   \return Number of columns of the value matrix
+   \sa numRows()
+ */
+int QwtTypedMatrixRasterData::numColumns() const
+{
+    return m_data->numColumns;
+}
+
+/*!
+   \return Number of rows of the value matrix
+   \sa numColumns()
+ */
+int QwtTypedMatrixRasterData::numRows() const
+{
+    return m_data->numRows;
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   \param area Requested area, ignored
+   \return Calculated hint
+
+   \sa QwtMatrixRasterData::pixelHint()
+ */
+QRectF QwtTypedMatrixRasterData::pixelHint(const QRectF& area) const
+{
+    Q_UNUSED(area)
+
+    QRectF rect;
+    if (m_data->resampleMode == NearestNeighbour) {
+        const QwtInterval intervalX = interval(Qt::XAxis);
+        const QwtInterval intervalY = interval(Qt::YAxis);
+        if (intervalX.isValid() && intervalY.isValid()) {
+            rect = QRectF(intervalX.minValue(), intervalY.minValue(), m_data->dx, m_data->dy);
+        }
+    }
+
+    return rect;
+}
+
+/*!
+   \return the scaled value at a raster position
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   \sa ResampleMode, setValueScale()
+ */
+double QwtTypedMatrixRasterData::value(double x, double y) const
+{
+    const QwtInterval xInterval = interval(Qt::XAxis);
+    const QwtInterval yInterval = interval(Qt::YAxis);
+
+    if (m_data->numRows <= 0 || !(xInterval.contains(x) && yInterval.contains(y)))
+        return qQNaN();
+
+    QwtTypedMatrixGeometry g;
+    g.x0         = xInterval.minValue();
+    g.y0         = yInterval.minValue();
+    g.dx         = m_data->dx;
+    g.dy         = m_data->dy;
+    g.numColumns = m_data->numColumns;
+    g.numRows    = m_data->numRows;
+
+    double value;
+
+    switch (m_data->valueType) {
+    case UInt8:
+        value = qwtTypedResample< quint8 >(m_data->values, m_data->resampleMode, g, x, y);
+        break;
+    case Int16:
+        value = qwtTypedResample< qint16 >(m_data->values, m_data->resampleMode, g, x, y);
+        break;
+    case UInt16:
+        value = qwtTypedResample< quint16 >(m_data->values, m_data->resampleMode, g, x, y);
+        break;
+    case Float32:
+        value = qwtTypedResample< float >(m_data->values, m_data->resampleMode, g, x, y);
+        break;
+    default:
+        return qQNaN();
+    }
+
+    // all resampling modes are linear in the values,
+    // so scaling the result is the same as scaling the matrix
+    return value * m_data->scale + m_data->offset;
+}
+
+void QwtTypedMatrixRasterData::update()
+{
+    m_data->numRows = 0;
+    m_data->dx      = 0.0;
+    m_data->dy      = 0.0;
+
+    if (m_data->numColumns > 0 && m_data->values) {
+        m_data->numRows = m_data->numValues / m_data->numColumns;
+
+        const QwtInterval xInterval = interval(Qt::XAxis);
+        const QwtInterval yInterval = interval(Qt::YAxis);
+        if (xInterval.isValid())
+            m_data->dx = xInterval.width() / m_data->numColumns;
+        if (yInterval.isValid() && m_data->numRows > 0)
+            m_data->dy = yInterval.width() / m_data->numRows;
+    }
+}
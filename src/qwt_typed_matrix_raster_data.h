@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Qwt Widget Library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TYPED_MATRIX_RASTER_DATA_H
+#define QWT_TYPED_MATRIX_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+
+#if QT_VERSION < 0x060000
+template< typename T >
+class QVector;
+#endif
+
+/*!
+   \brief A matrix of values with a compact storage type
+
+   QwtMatrixRasterData stores its values as doubles. For the frames of a
+   sensor with 8 or 16 bit resolution this is 4 - 8 times the memory
+   and bandwidth, that is needed for the raw values.
+
+   QwtTypedMatrixRasterData stores the values in their original type - see
+   ValueType. The values can be copied from a QVector, what is cheap
+   because of implicit sharing, or an external buffer can be wrapped
+   without copying.
+
+   A raw value v is mapped to v * valueScale() + valueOffset(), what allows
+   to display the physical values of a sensor without converting the frame.
+
+   The resampling algorithms are the same as in QwtMatrixRasterData, but
+   they are instantiated for each value type, reading the raw values directly.
+
+   \sa QwtMatrixRasterData, QwtPlotSpectrogram
+ */
+class QWT_EXPORT QwtTypedMatrixRasterData : public QwtRasterData
+{
+public:
+    //! Type of the values in the matrix
+    enum ValueType
+    {
+        //! No values assigned
+        NoValues,
+
+        //! 8 bit unsigned integer
+        UInt8,
+
+        //! 16 bit signed integer
+        Int16,
+
+        //! 16 bit unsigned integer
+        UInt16,
+
+        //! 32 bit floating point
+        Float32
+    };
+
+    /*!
+       \brief Resampling algorithm
+       The default setting is NearestNeighbour;
+       \sa QwtMatrixRasterData::ResampleMode
+     */
+    enum ResampleMode
+    {
+        //! Value from the matrix, that is nearest to the requested position
+        NearestNeighbour,
+
+        //! Interpolate from the 4 surrounding values
+        BilinearInterpolation,
+
+        //! Hermite bicubic interpolation from the 16 surrounding values
+        BicubicInterpolation
+    };
+
+    QwtTypedMatrixRasterData();
+    virtual ~QwtTypedMatrixRasterData();
+
+    void setResampleMode(ResampleMode mode);
+    ResampleMode resampleMode() const;
+
+    void setInterval(Qt::Axis, const QwtInterval&);
+    virtual QwtInterval interval(Qt::Axis axis) const QWT_OVERRIDE QWT_FINAL;
+
+    void setValueMatrix(const QVector< quint8 >& values, int numColumns);
+    void setValueMatrix(const QVector< qint16 >& values, int numColumns);
+    void setValueMatrix(const QVector< quint16 >& values, int numColumns);
+    void setValueMatrix(const QVector< float >& values, int numColumns);
+
+    void setRawValueMatrix(const quint8* values, int numColumns, int numRows);
+    void setRawValueMatrix(const qint16* values, int numColumns, int numRows);
+    void setRawValueMatrix(const quint16* values, int numColumns, int numRows);
+    void setRawValueMatrix(const float* values, int numColumns, int numRows);
+
+    ValueType valueType() const;
+    const void* rawValues() const;
+
+    void setValueScale(double scale, double offset = 0.0);
+    double valueScale() const;
+    double valueOffset() const;
+
+    int numColumns() const;
+    int numRows() const;
+
+    virtual QRectF pixelHint(const QRectF&) const QWT_OVERRIDE;
+
+    virtual double value(double x, double y) const QWT_OVERRIDE;
+
+private:
+    Q_DISABLE_COPY(QwtTypedMatrixRasterData)
+
+    void update();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -39,6 +39,24 @@ QwtVectorFieldSymbol::~QwtVectorFieldSymbol()
 {
 }
 
+/*!
+    \brief Outline of the symbol/arrow
+
+    The path has to match, what is drawn by paint() using the pen
+    and brush of the painter. It allows QwtPlotVectorField to collect
+    the arrows in one path, that is painted in one operation.
+
+    The default implementation returns an empty path, indicating, that
+    the symbol can only be drawn by paint().
+
+    \return Outline of the symbol in the geometry of the last setLength()
+    \sa paint(), QwtPlotVectorField::BatchedSymbols
+ */
+QPainterPath QwtVectorFieldSymbol::path() const
+{
+    return QPainterPath();
+}
+
 class QwtVectorFieldArrow::PrivateData
 {
   public:
@@ -114,6 +132,11 @@ void QwtVectorFieldArrow::paint( QPainter* painter ) const
     painter->drawPath( m_data->path );
 }
 
+QPainterPath QwtVectorFieldArrow::path() const
+{
+    return m_data->path;
+}
+
 class QwtVectorFieldThinArrow::PrivateData
 {
   public:
@@ -175,3 +198,8 @@ void QwtVectorFieldThinArrow::paint(QPainter* p) const
 {
     p->drawPath( m_data->path );
 }
+
+QPainterPath QwtVectorFieldThinArrow::path() const
+{
+    return m_data->path;
+}
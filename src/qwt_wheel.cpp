@@ -32,6 +32,7 @@
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qelapsedtimer.h>
@@ -103,6 +104,9 @@ public:
     bool pendingValueChanged;  // when not tracking
     bool inverted;
     bool wrapping;
+
+    // frame and background, that don't depend on the value
+    QPixmap pixmapCache;
 };
 
 //! Constructor
@@ -535,6 +539,7 @@ void QwtWheel::setWheelBorderWidth(int borderWidth)
     const int d              = qMin(width(), height()) / 3;
     borderWidth              = qMin(borderWidth, d);
     m_data->wheelBorderWidth = qMax(borderWidth, 1);
+    invalidateCache();
     update();
 }
 
@@ -558,6 +563,7 @@ int QwtWheel::wheelBorderWidth() const
 void QwtWheel::setBorderWidth(int width)
 {
     m_data->borderWidth = qMax(width, 0);
+    invalidateCache();
     update();
 }
 
@@ -632,6 +638,7 @@ void QwtWheel::setOrientation(Qt::Orientation orientation)
     }
 
     m_data->orientation = orientation;
+    invalidateCache();
     update();
 }
 
@@ -719,20 +726,64 @@ void QwtWheel::paintEvent(QPaintEvent* event)
     opt.initFrom(this);
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
 
-    qDrawShadePanel(&painter, contentsRect(), palette(), true, m_data->borderWidth);
+    const QSize cacheSize = size() * QwtPainter::devicePixelRatio(this);
+    if (m_data->pixmapCache.size() != cacheSize) {
+        m_data->pixmapCache = QwtPainter::backingStore(this, size());
+        m_data->pixmapCache.fill(Qt::transparent);
+
+        QPainter p(&m_data->pixmapCache);
+
+        qDrawShadePanel(&p, contentsRect(), palette(), true, m_data->borderWidth);
+        drawWheelBackground(&p, wheelRect());
+    }
+
+    painter.drawPixmap(0, 0, m_data->pixmapCache);
 
-    drawWheelBackground(&painter, wheelRect());
     drawTicks(&painter, wheelRect());
 
     if (hasFocus())
         QwtPainter::drawFocusRect(&painter, this);
 }
 
+/*!
+   Qt change event handler
+   \param event Event
+ */
+void QwtWheel::changeEvent(QEvent* event)
+{
+    // palette, enabled and activation state affect the cached colors
+    invalidateCache();
+
+    QWidget::changeEvent(event);
+}
+
+/*!
+   Invalidate the cached static layer ( frame and background ).
+
+   The cache is invalidated automatically, when the widget is resized
+   or its layout, palette or scale has changed. Applications and derived
+   classes need to call invalidateCache() and update() when they modify
+   anything else, that is painted into the static layer: f.e. state used by a reimplemented
+   drawWheelBackground().
+ */
+void QwtWheel::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
 /*!
    Draw the Wheel's background gradient
 
+   The background doesn't depend on the value. When painting the widget
+   it is rendered into the cached static layer together with the frame,
+   so drawWheelBackground() is not called for value changes.
+   Reimplementations, that depend on anything else than the geometry or
+   palette, need to call invalidateCache(), when it changes.
+
    \param painter Painter
    \param rect Geometry for the wheel
+
+   \sa drawTicks(), invalidateCache()
  */
 void QwtWheel::drawWheelBackground(QPainter* painter, const QRectF& rect)
 {
@@ -883,6 +934,7 @@ void QwtWheel::drawTicks(QPainter* painter, const QRectF& rect)
 void QwtWheel::setWheelWidth(int width)
 {
     m_data->wheelWidth = width;
+    invalidateCache();
     update();
 }
 
@@ -126,6 +126,8 @@ class QWT_EXPORT QwtWheel : public QWidget
 
     double mass() const;
 
+    void invalidateCache();
+
   public Q_SLOTS:
     void setValue( double );
     void setTotalAngle ( double );
@@ -172,6 +174,7 @@ class QWT_EXPORT QwtWheel : public QWidget
     virtual void keyPressEvent( QKeyEvent* ) QWT_OVERRIDE;
     virtual void wheelEvent( QWheelEvent* ) QWT_OVERRIDE;
     virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+    virtual void changeEvent( QEvent* ) QWT_OVERRIDE;
 
     void stopFlying();
 
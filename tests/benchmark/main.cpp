@@ -0,0 +1,458 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    Headless benchmarks for the rendering hot paths.
+
+    The benchmarks run on the offscreen platform plugin, so that no
+    display is needed. Results are written as JSON ( default ) or CSV,
+    what allows to compare them between releases.
+
+    Usage: qwtbenchmark [--max-points N] [--repeat N] [--filter TEXT]
+                        [--format json|csv] [--output FILE]
+ */
+
+#include <QwtPointMapper>
+#include <QwtScaleMap>
+#include <QwtPointSeriesData>
+#include <QwtWeedingCurveFitter>
+#include <QwtSplineLocal>
+#include <QwtSplineCubic>
+#include <QwtPlot>
+#include <QwtPlotCurve>
+#include <QwtPlotSpectrogram>
+#include <QwtMatrixRasterData>
+#include <QwtLinearColorMap>
+#include <QwtPlotRenderer>
+#include <QwtInterval>
+#include <qwt_clipper.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QPen>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+    struct Result
+    {
+        QString name;
+        qint64 points;
+        int iterations;
+        double minMs;
+        double medianMs;
+        double meanMs;
+    };
+
+    class Benchmark
+    {
+      public:
+        Benchmark( int repeat, const QString& filter )
+            : m_repeat( repeat )
+            , m_filter( filter )
+        {
+        }
+
+        void run( const QString& name, qint64 points,
+            const std::function< void() >& func )
+        {
+            if ( !m_filter.isEmpty() && !name.contains( m_filter ) )
+                return;
+
+            func(); // warm up
+
+            QVector< double > times;
+            times.reserve( m_repeat );
+
+            for ( int i = 0; i < m_repeat; i++ )
+            {
+                QElapsedTimer timer;
+                timer.start();
+
+                func();
+
+                times += timer.nsecsElapsed() / 1e6;
+            }
+
+            std::sort( times.begin(), times.end() );
+
+            double sum = 0.0;
+            for ( int i = 0; i < times.size(); i++ )
+                sum += times[i];
+
+            Result result;
+            result.name = name;
+            result.points = points;
+            result.iterations = times.size();
+            result.minMs = times.first();
+            result.medianMs = times[ times.size() / 2 ];
+            result.meanMs = sum / times.size();
+
+            m_results += result;
+
+            QTextStream( stderr ) << name << " [" << points << "]: "
+                << result.medianMs << " ms\n";
+        }
+
+        const QVector< Result >& results() const
+        {
+            return m_results;
+        }
+
+      private:
+        const int m_repeat;
+        const QString m_filter;
+        QVector< Result > m_results;
+    };
+
+    // a noisy sine wave, what is a typical signal for most plots
+    QPolygonF createSignal( qint64 numPoints )
+    {
+        QPolygonF points( int( numPoints ) );
+
+        quint32 seed = 12345;
+        for ( int i = 0; i < points.size(); i++ )
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const double noise = ( seed >> 8 ) / double( 1 << 24 ) - 0.5;
+
+            points[i].rx() = i;
+            points[i].ry() = std::sin( i * 20.0 * M_PI / numPoints ) + 0.2 * noise;
+        }
+
+        return points;
+    }
+
+    class Spectrogram : public QwtPlotSpectrogram
+    {
+      public:
+        using QwtPlotSpectrogram::renderImage;
+    };
+
+    QwtMatrixRasterData* createRasterData( int numColumns, int numRows )
+    {
+        QVector< double > values( numColumns * numRows );
+        for ( int row = 0; row < numRows; row++ )
+        {
+            const double y = 2.0 * row / numRows - 1.0;
+            for ( int col = 0; col < numColumns; col++ )
+            {
+                const double x = 2.0 * col / numColumns - 1.0;
+                values[ row * numColumns + col ] =
+                    std::sin( 6.0 * x ) * std::cos( 6.0 * y ) * std::exp( -x * x - y * y );
+            }
+        }
+
+        QwtMatrixRasterData* data = new QwtMatrixRasterData();
+        data->setInterval( Qt::XAxis, QwtInterval( -1.0, 1.0 ) );
+        data->setInterval( Qt::YAxis, QwtInterval( -1.0, 1.0 ) );
+        data->setInterval( Qt::ZAxis, QwtInterval( -1.0, 1.0 ) );
+        data->setValueMatrix( values, numColumns );
+
+        return data;
+    }
+}
+
+static void benchmarkPointMapper( Benchmark& bench,
+    const QPolygonF& signal, const QSize& canvasSize )
+{
+    const qint64 n = signal.size();
+    QwtPointSeriesData data( signal );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, n - 1 );
+    xMap.setPaintInterval( 0, canvasSize.width() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( -1.5, 1.5 );
+    yMap.setPaintInterval( canvasSize.height(), 0 );
+
+    const QRectF rect( QPointF( 0, 0 ), canvasSize );
+
+    QwtPointMapper mapper;
+    mapper.setBoundingRect( rect );
+
+    bench.run( "PointMapper::toPolygonF", n,
+        [&]() { mapper.toPolygonF( xMap, yMap, &data, 0, n - 1 ); } );
+
+    mapper.setFlags( QwtPointMapper::RoundPoints | QwtPointMapper::WeedOutIntermediatePoints );
+    bench.run( "PointMapper::toPolygonF/WeedOutIntermediatePoints", n,
+        [&]() { mapper.toPolygonF( xMap, yMap, &data, 0, n - 1 ); } );
+
+    mapper.setFlags( QwtPointMapper::WeedOutPoints );
+    bench.run( "PointMapper::toPoints/WeedOutPoints", n,
+        [&]() { mapper.toPoints( xMap, yMap, &data, 0, n - 1 ); } );
+
+    mapper.setFlags( QwtPointMapper::TransformationFlags() );
+    bench.run( "PointMapper::toImage", n,
+        [&]() { mapper.toImage( xMap, yMap, &data, 0, n - 1, QPen( Qt::black ), false, 0 ); } );
+
+    bench.run( "PointMapper::toLineImage", n,
+        [&]() { mapper.toLineImage( xMap, yMap, &data, 0, n - 1, QPen( Qt::black ), true, 0 ); } );
+}
+
+static void benchmarkClipper( Benchmark& bench,
+    const QPolygonF& signal, const QSize& canvasSize )
+{
+    const qint64 n = signal.size();
+
+    // zoomed into the middle 10% of the signal
+    QPolygonF polyline( signal );
+    for ( int i = 0; i < polyline.size(); i++ )
+    {
+        polyline[i].rx() = ( polyline[i].x() / n - 0.45 ) * 10.0 * canvasSize.width();
+        polyline[i].ry() = ( 1.5 - polyline[i].y() ) / 3.0 * canvasSize.height();
+    }
+
+    const QRectF clipRect( QPointF( 0, 0 ), canvasSize );
+
+    bench.run( "Clipper::clippedPolygonF", n,
+        [&]() { QwtClipper::clippedPolygonF( clipRect, polyline, false ); } );
+
+    bench.run( "Clipper::clippedPolylinesF", n,
+        [&]() { QwtClipper::clippedPolylinesF( clipRect, polyline ); } );
+}
+
+static void benchmarkFitters( Benchmark& bench, const QPolygonF& signal )
+{
+    const qint64 n = signal.size();
+
+    QwtWeedingCurveFitter fitter;
+    bench.run( "WeedingCurveFitter::fitCurve", n,
+        [&]() { fitter.fitCurve( signal ); } );
+
+    const QwtSplineLocal::Type types[] =
+    {
+        QwtSplineLocal::Cardinal,
+        QwtSplineLocal::ParabolicBlending,
+        QwtSplineLocal::Akima,
+        QwtSplineLocal::PChip
+    };
+
+    const char* names[] = { "Cardinal", "ParabolicBlending", "Akima", "PChip" };
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        QwtSplineLocal spline( types[i] );
+        bench.run( QString( "SplineLocal::painterPath/%1" ).arg( names[i] ), n,
+            [&]() { spline.painterPath( signal ); } );
+    }
+
+    QwtSplineCubic cubic;
+    bench.run( "SplineCubic::painterPath", n,
+        [&]() { cubic.painterPath( signal ); } );
+}
+
+static void benchmarkRaster( Benchmark& bench, const QSize& canvasSize )
+{
+    const int dim = 1000;
+
+    Spectrogram spectrogram;
+    spectrogram.setRenderThreadCount( 0 );
+    spectrogram.setData( createRasterData( dim, dim ) );
+
+    QwtLinearColorMap* colorMap = new QwtLinearColorMap( Qt::darkBlue, Qt::darkRed );
+    colorMap->addColorStop( 0.5, Qt::yellow );
+    spectrogram.setColorMap( colorMap );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( -1.0, 1.0 );
+    xMap.setPaintInterval( 0, canvasSize.width() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( -1.0, 1.0 );
+    yMap.setPaintInterval( canvasSize.height(), 0 );
+
+    const QRectF area( -1.0, -1.0, 2.0, 2.0 );
+
+    bench.run( "PlotSpectrogram::renderImage", qint64( dim ) * dim,
+        [&]() { spectrogram.renderImage( xMap, yMap, area, canvasSize ); } );
+
+    QList< double > levels;
+    for ( double level = -0.9; level < 1.0; level += 0.1 )
+        levels += level;
+
+    const QwtRasterData* data = spectrogram.data();
+    bench.run( "RasterData::contourLines", qint64( dim ) * dim,
+        [&]() { data->contourLines( area, canvasSize, levels, QwtRasterData::ConrecFlags() ); } );
+}
+
+static void benchmarkPlot( Benchmark& bench,
+    const QPolygonF& signal, const QSize& canvasSize, const QString& tmpDir )
+{
+    const qint64 n = signal.size();
+
+    QwtPlot plot;
+    plot.setAutoReplot( false );
+    plot.resize( canvasSize + QSize( 100, 100 ) );
+
+    QwtPlotCurve* curve = new QwtPlotCurve();
+    curve->setSamples( signal );
+    curve->attach( &plot );
+
+    plot.updateLayout();
+    plot.replot();
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        maps[ axisPos ] = plot.canvasMap( axisPos );
+
+    const QRectF canvasRect = plot.canvas()->contentsRect();
+
+    QImage image( plot.canvas()->size(), QImage::Format_ARGB32_Premultiplied );
+
+    bench.run( "Plot::drawItems", n,
+        [&]()
+        {
+            image.fill( Qt::white );
+            QPainter painter( &image );
+            plot.drawItems( &painter, canvasRect, maps );
+        } );
+
+    curve->setPaintAttribute( QwtPlotCurve::FilterPointsAggressive, true );
+    bench.run( "Plot::drawItems/FilterPointsAggressive", n,
+        [&]()
+        {
+            image.fill( Qt::white );
+            QPainter painter( &image );
+            plot.drawItems( &painter, canvasRect, maps );
+        } );
+
+    curve->setPaintAttribute( QwtPlotCurve::FilterPointsAggressive, false );
+
+    QwtPlotRenderer renderer;
+
+    bench.run( "PlotRenderer::renderTo/QImage", n,
+        [&]()
+        {
+            QImage document( plot.size(), QImage::Format_ARGB32_Premultiplied );
+            document.fill( Qt::white );
+            renderer.renderTo( &plot, document );
+        } );
+
+    const QString pdfFile = tmpDir + "/benchmark.pdf";
+    bench.run( "PlotRenderer::renderDocument/pdf", n,
+        [&]() { renderer.renderDocument( &plot, pdfFile, "pdf", QSizeF( 200, 150 ) ); } );
+
+#ifndef QWT_NO_SVG
+    const QString svgFile = tmpDir + "/benchmark.svg";
+    bench.run( "PlotRenderer::renderDocument/svg", n,
+        [&]() { renderer.renderDocument( &plot, svgFile, "svg", QSizeF( 200, 150 ) ); } );
+#endif
+}
+
+static QByteArray toJson( const QVector< Result >& results )
+{
+    QJsonArray entries;
+    for ( const Result& result : results )
+    {
+        QJsonObject entry;
+        entry[ "name" ] = result.name;
+        entry[ "points" ] = double( result.points );
+        entry[ "iterations" ] = result.iterations;
+        entry[ "min_ms" ] = result.minMs;
+        entry[ "median_ms" ] = result.medianMs;
+        entry[ "mean_ms" ] = result.meanMs;
+
+        entries += entry;
+    }
+
+    QJsonObject doc;
+    doc[ "qt_version" ] = QString( qVersion() );
+    doc[ "results" ] = entries;
+
+    return QJsonDocument( doc ).toJson();
+}
+
+static QByteArray toCsv( const QVector< Result >& results )
+{
+    QByteArray csv = "name,points,iterations,min_ms,median_ms,mean_ms\n";
+    for ( const Result& result : results )
+    {
+        csv += QString( "%1,%2,%3,%4,%5,%6\n" ).arg( result.name )
+            .arg( result.points ).arg( result.iterations )
+            .arg( result.minMs ).arg( result.medianMs ).arg( result.meanMs ).toUtf8();
+    }
+
+    return csv;
+}
+
+int main( int argc, char* argv[] )
+{
+    // no display needed
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption( { "max-points", "Largest dataset ( 1e3 ... 1e8 ).", "N", "1000000" } );
+    parser.addOption( { "repeat", "Number of timed iterations.", "N", "5" } );
+    parser.addOption( { "filter", "Run benchmarks containing TEXT only.", "TEXT" } );
+    parser.addOption( { "format", "Output format: json or csv.", "FORMAT", "json" } );
+    parser.addOption( { "output", "Output file, default is stdout.", "FILE" } );
+    parser.process( app );
+
+    const qint64 maxPoints = qBound( qint64( 1000 ),
+        parser.value( "max-points" ).toLongLong(), qint64( 100000000 ) );
+
+    Benchmark bench( qMax( 1, parser.value( "repeat" ).toInt() ),
+        parser.value( "filter" ) );
+
+    const QSize canvasSize( 1000, 600 );
+
+    QTemporaryDir tmpDir;
+
+    for ( qint64 n = 1000; n <= maxPoints; n *= 10 )
+    {
+        const QPolygonF signal = createSignal( n );
+
+        benchmarkPointMapper( bench, signal, canvasSize );
+        benchmarkClipper( bench, signal, canvasSize );
+
+        // the splines are way too slow for the huge datasets
+        if ( n <= 1000000 )
+            benchmarkFitters( bench, signal );
+
+        benchmarkPlot( bench, signal, canvasSize, tmpDir.path() );
+    }
+
+    benchmarkRaster( bench, canvasSize );
+
+    const QByteArray out = ( parser.value( "format" ) == "csv" )
+        ? toCsv( bench.results() ) : toJson( bench.results() );
+
+    if ( parser.isSet( "output" ) )
+    {
+        QFile file( parser.value( "output" ) );
+        if ( !file.open( QIODevice::WriteOnly ) )
+        {
+            QTextStream( stderr ) << "Can't write " << file.fileName() << "\n";
+            return 1;
+        }
+
+        file.write( out );
+    }
+    else
+    {
+        QTextStream( stdout ) << out;
+    }
+
+    return 0;
+}
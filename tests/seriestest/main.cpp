@@ -0,0 +1,347 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    Checks the numeric kernels of the series classes against their
+    reference implementations:
+
+    - the CSV number parser of QwtSeriesLoader against QByteArray::toDouble
+    - the array based qwtBoundingRect() kernels against the sample by sample
+      calculation of qwtBoundingRect( const QwtSeriesData<T>& )
+
+    The program returns the number of failed checks.
+ */
+
+#include <QwtSeriesLoader>
+#include <QwtSharedPointBuffer>
+#include <qwt_series_data.h>
+#include <qwt_point_data.h>
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QList>
+#include <QDebug>
+
+#include <cmath>
+#include <limits>
+
+static int numErrors = 0;
+
+static void reportError( const QString& test, const QString& text )
+{
+    qDebug() << qPrintable( test ) << ":" << qPrintable( text );
+    numErrors++;
+}
+
+// bitwise comparison, all NaNs being equal
+static inline bool isSame( double a, double b )
+{
+    if ( std::isnan( a ) || std::isnan( b ) )
+        return std::isnan( a ) && std::isnan( b );
+
+    return a == b && std::signbit( a ) == std::signbit( b );
+}
+
+static inline bool isSameRect( const QRectF& a, const QRectF& b )
+{
+    return isSame( a.left(), b.left() ) && isSame( a.top(), b.top() )
+        && isSame( a.right(), b.right() ) && isSame( a.bottom(), b.bottom() );
+}
+
+static QString toString( const QRectF& rect )
+{
+    return QString( "[%1, %2] x [%3, %4]" ).arg( rect.left(), 0, 'g', 17 )
+        .arg( rect.right(), 0, 'g', 17 ).arg( rect.top(), 0, 'g', 17 )
+        .arg( rect.bottom(), 0, 'g', 17 );
+}
+
+// reference: what QByteArray::toDouble makes of a field
+static bool referenceValue( QByteArray field, double& value )
+{
+    field = field.trimmed();
+    while ( field.startsWith( '"' ) )
+        field.remove( 0, 1 );
+    while ( field.endsWith( '"' ) )
+        field.chop( 1 );
+
+    bool ok = false;
+    value = field.trimmed().toDouble( &ok );
+
+    return ok;
+}
+
+static void testParser()
+{
+    const char* fields[] =
+    {
+        // fast path boundaries: 15/16 significant digits, 10^+-22/23
+        "123456789012345", "1234567890123456", "12345678901234567890",
+        "0.123456789012345", "0.1234567890123456",
+        "1e22", "1e23", "1e-22", "1e-23", "123456789012345e22", "1.5e-22",
+        "9007199254740993", "0.1", "0.2", "0.3", "2.2250738585072014e-308",
+        "1.7976931348623157e308", "1e400", "1e-400", "4.9e-324",
+
+        // leading and trailing zeros, signs
+        "0", "-0", "+0", "000000000000000000001.5", "0.000000000000000000001",
+        "00012300000000000000000", "-0.0000123", "+17", "-17.", ".5", "-.5",
+
+        // exponents
+        "1E5", "1e+5", "1e-5", "2.5e0", "1e", "1e+", "e5", "1e5x",
+
+        // quoted fields and spaces
+        "\"3.25\"", "  4.5  ", "\" 6.75 \"", "\"\"",
+
+        // fallback
+        "nan", "NaN", "inf", "-inf", "+inf", "Infinity",
+
+        // invalid
+        "", "-", "+", ".", "abc", "1.2.3", "1,5", "0x10", "--1"
+    };
+
+    const int numFields = int( sizeof( fields ) / sizeof( fields[0] ) );
+
+    QTemporaryDir dir;
+    const QString fileName = dir.path() + "/parser.csv";
+
+    QByteArray csv;
+    for ( int i = 0; i < numFields; i++ )
+    {
+        csv += QByteArray::number( i ) + ";" + fields[i];
+
+        // mix unix and windows line endings
+        csv += ( i % 2 ) ? "\r\n" : "\n";
+    }
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly ) )
+    {
+        reportError( "Parser", "can't write " + fileName );
+        return;
+    }
+    file.write( csv );
+    file.close();
+
+    QwtSeriesLoader loader;
+    loader.setDelimiter( ';' );
+    loader.setColumns( 0, 1 );
+    loader.setPreviewSize( 0 );
+
+    if ( !loader.load( fileName ) )
+    {
+        reportError( "Parser", "loading failed: " + loader.errorString() );
+        return;
+    }
+
+    const QVector< QPointF > samples = loader.result().samples();
+
+    int index = 0;
+    for ( int i = 0; i < numFields; i++ )
+    {
+        double expected;
+        const bool ok = referenceValue( fields[i], expected );
+
+        const bool parsed = ( index < samples.size() && samples[index].x() == i );
+        if ( parsed != ok )
+        {
+            reportError( "Parser", QString( "\"%1\": %2" ).arg( QString::fromLatin1( fields[i] ) )
+                .arg( QString::fromLatin1( ok ? "not parsed" : "parsed, but invalid" ) ) );
+        }
+
+        if ( parsed )
+        {
+            const double value = samples[index].y();
+            if ( ok && !isSame( value, expected ) )
+            {
+                reportError( "Parser", QString( "\"%1\": %2, expected %3" ).arg( QString::fromLatin1( fields[i] ) )
+                    .arg( value, 0, 'g', 17 ).arg( expected, 0, 'g', 17 ) );
+            }
+            index++;
+        }
+    }
+}
+
+class Random
+{
+  public:
+    explicit Random( quint32 seed )
+        : m_state( seed )
+    {
+    }
+
+    quint32 next()
+    {
+        m_state = m_state * 1664525u + 1013904223u;
+        return m_state >> 8;
+    }
+
+    // mostly ordinary values, with NaN and infinite values in between
+    double value()
+    {
+        const double nan = std::numeric_limits< double >::quiet_NaN();
+        const double inf = std::numeric_limits< double >::infinity();
+
+        switch ( next() % 16 )
+        {
+            case 0:
+                return nan;
+            case 1:
+                return inf;
+            case 2:
+                return -inf;
+            default:
+                // multiples of 1/64: left + width of the reference rectangles is exact
+                return ( double( next() % 200001 ) - 100000.0 ) / 64.0;
+        }
+    }
+
+  private:
+    quint32 m_state;
+};
+
+static void checkRect( const QString& test, size_t count,
+    const QRectF& rect, const QRectF& expected )
+{
+    if ( !isSameRect( rect, expected ) )
+    {
+        reportError( test, QString( "%1 samples: %2, expected %3" ).arg( count )
+            .arg( toString( rect ) ).arg( toString( expected ) ) );
+    }
+}
+
+// a derived class, that modifies the samples of m_samples in sample()
+class ScaledSeriesData : public QwtPointSeriesData
+{
+  public:
+    explicit ScaledSeriesData( const QVector< QPointF >& samples )
+        : QwtPointSeriesData( samples )
+    {
+    }
+
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE
+    {
+        return 2.0 * QwtPointSeriesData::sample( index );
+    }
+};
+
+static void testBoundingRects()
+{
+    // counts, that are not a multiple of the 4 lanes of the kernel
+    QList< int > counts;
+    for ( int i = 1; i <= 13; i++ )
+        counts += i;
+    counts << 63 << 64 << 65 << 1001;
+
+    const QRectF invalidRect( 1.0, 1.0, -2.0, -2.0 );
+
+    for ( quint32 seed = 1; seed <= 20; seed++ )
+    {
+        Random random( seed );
+
+        for ( int count : qAsConst( counts ) )
+        {
+            QVector< QPointF > points( count );
+            QVector< QwtPoint3D > points3D( count );
+            QVector< QwtIntervalSample > intervals( count );
+            QVector< QwtOHLCSample > ohlc( count );
+            QVector< double > xData( count ), yData( count );
+            QVector< float > xDataF( count ), yDataF( count );
+            QVector< QPointF > pointsF( count );
+
+            for ( int i = 0; i < count; i++ )
+            {
+                points[i] = QPointF( random.value(), random.value() );
+                points3D[i] = QwtPoint3D( random.value(), random.value(), random.value() );
+
+                // inverted intervals are ignored
+                intervals[i] = QwtIntervalSample( random.value(),
+                    random.value(), random.value() );
+
+                ohlc[i] = QwtOHLCSample( random.value(), random.value(),
+                    random.value(), random.value(), random.value() );
+
+                xData[i] = points[i].x();
+                yData[i] = points[i].y();
+
+                xDataF[i] = float( random.value() );
+                yDataF[i] = float( random.value() );
+                pointsF[i] = QPointF( xDataF[i], yDataF[i] );
+            }
+
+            const size_t n = size_t( count );
+
+            checkRect( "QPointF", n, qwtBoundingRect( points.constData(), n ),
+                qwtBoundingRect( QwtPointSeriesData( points ) ) );
+
+            checkRect( "QwtPoint3D", n, qwtBoundingRect( points3D.constData(), n ),
+                qwtBoundingRect( QwtPoint3DSeriesData( points3D ) ) );
+
+            checkRect( "QwtIntervalSample", n,
+                qwtBoundingRect( intervals.constData(), n ),
+                qwtBoundingRect( QwtIntervalSeriesData( intervals ) ) );
+
+            checkRect( "QwtOHLCSample", n, qwtBoundingRect( ohlc.constData(), n ),
+                qwtBoundingRect( QwtTradingChartData( ohlc ) ) );
+
+            checkRect( "double", n,
+                qwtBoundingRect( xData.constData(), yData.constData(), n ),
+                qwtBoundingRect( QwtPointSeriesData( points ) ) );
+
+            checkRect( "float", n,
+                qwtBoundingRect( xDataF.constData(), yDataF.constData(), n ),
+                qwtBoundingRect( QwtPointSeriesData( pointsF ) ) );
+
+            // the overloaded boundingRect() of the series data classes
+            checkRect( "QwtPointArrayData", n,
+                QwtPointArrayData< double >( xData, yData ).boundingRect(),
+                qwtBoundingRect( QwtPointSeriesData( points ) ) );
+
+            checkRect( "QwtCPointerData", n,
+                QwtCPointerData< float >( xDataF.constData(), yDataF.constData(), n ).boundingRect(),
+                qwtBoundingRect( QwtPointSeriesData( pointsF ) ) );
+
+            // derived classes have to fall back to the virtual sample()
+            const ScaledSeriesData scaled( points );
+            checkRect( "Derived QwtPointSeriesData", n, scaled.boundingRect(),
+                qwtBoundingRect( static_cast< const QwtSeriesData< QPointF >& >( scaled ) ) );
+        }
+    }
+
+    // only invalid samples
+
+    const double nan = std::numeric_limits< double >::quiet_NaN();
+    const double inf = std::numeric_limits< double >::infinity();
+
+    const QPointF invalidPoints[] =
+    {
+        QPointF( nan, 1.0 ), QPointF( 1.0, nan ), QPointF( inf, 1.0 ),
+        QPointF( 1.0, -inf ), QPointF( nan, nan )
+    };
+    checkRect( "Invalid QPointF", 5, qwtBoundingRect( invalidPoints, 5 ), invalidRect );
+
+    const QwtIntervalSample invertedIntervals[] =
+    {
+        QwtIntervalSample( 1.0, 2.0, 1.0 ), QwtIntervalSample( 1.0, 5.0, -5.0 )
+    };
+    checkRect( "Inverted intervals", 2,
+        qwtBoundingRect( invertedIntervals, 2 ), invalidRect );
+
+    checkRect( "No samples", 0,
+        qwtBoundingRect( static_cast< const double* >( NULL ),
+            static_cast< const double* >( NULL ), 0 ), invalidRect );
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    testParser();
+    testBoundingRects();
+
+    if ( numErrors == 0 )
+        qDebug() << "All tests passed";
+
+    return numErrors;
+}
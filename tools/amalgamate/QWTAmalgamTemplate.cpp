@@ -22,6 +22,8 @@
 #include "../../src/qwt_raster_data.cpp"
 #include "../../src/qwt_grid_raster_data.cpp"
 #include "../../src/qwt_matrix_raster_data.cpp"
+#include "../../src/qwt_typed_matrix_raster_data.cpp"
+#include "../../src/qwt_mipmap_raster_data.cpp"
 #include "../../src/qwt_date.cpp"
 #include "../../src/qwt_bezier.cpp"
 #include "../../src/qwt_point_polar.cpp"
@@ -32,6 +34,7 @@
 #include "../../src/qwt_graphic.cpp"
 #include "../../src/qwt_event_pattern.cpp"
 #include "../../src/qwt_painter.cpp"
+#include "../../src/qwt_render_stats.cpp"
 #include "../../src/qwt_text_engine.cpp"
 #include "../../src/qwt_text.cpp"
 #include "../../src/qwt_text_label.cpp"
@@ -46,6 +49,7 @@
 #include "../../src/qwt_curve_fitter.cpp"
 #include "../../src/qwt_polar_fitter.cpp"
 #include "../../src/qwt_sampling_thread.cpp"
+#include "../../src/qwt_sampling_buffer.cpp"
 #include "../../src/qwt_scale_div.cpp"
 #include "../../src/qwt_abstract_scale_draw.cpp"
 #include "../../src/qwt_scale_draw.cpp"
@@ -61,6 +65,7 @@
 #include "../../src/qwt_column_symbol.cpp"
 #include "../../src/qwt_wheel.cpp"
 #include "../../src/qwt_vectorfield_symbol.cpp"
+#include "../../src/qwt_symbol_renderer.cpp"
 #include "../../src/qwt_spline_polynomial.cpp"
 #include "../../src/qwt_spline_parametrization.cpp"
 #include "../../src/qwt_spline_pleasing.cpp"
@@ -73,6 +78,9 @@
 #include "../../src/qwt_date_scale_engine.cpp"
 #include "../../src/qwt_round_scale_draw.cpp"
 #include "../../src/qwt_point_data.cpp"
+#include "../../src/qwt_mapped_point_data.cpp"
+#include "../../src/qwt_shared_point_data.cpp"
+#include "../../src/qwt_series_loader.cpp"
 #include "../../src/qwt_point_mapper.cpp"
 #include "../../src/qwt_series_data.cpp"
 #include "../../src/qwt_picker_machine.cpp"
@@ -134,12 +142,15 @@
 #include "../../src/qwt_plot_layout.cpp"
 #include "../../src/qwt_parasite_plot_layout.cpp"
 #include "../../src/qwt_plot_scale_event_dispatcher.cpp"
+#include "../../src/qwt_plot_axis_link.cpp"
 #include "../../src/qwt_plot_rescaler.cpp"
 #include "../../src/qwt_polar_plot.cpp"
 #include "../../src/qwt_polar_grid.cpp"
 #include "../../src/qwt_polar_layout.cpp"
 #include "../../src/qwt_polar_renderer.cpp"
 #include "../../src/qwt_figure_layout.cpp"
+#include "../../src/qwt_lightweight_axes.cpp"
+#include "../../src/qwt_figure_tiff_writer.cpp"
 #include "../../src/qwt_figure.cpp"
 #include "../../src/qwt_figure_widget_overlay.cpp"
 // control
@@ -20,6 +20,8 @@
 #include "../../src/qwt_grid_data.hpp"
 #include "../../src/qwt_grid_raster_data.h"
 #include "../../src/qwt_matrix_raster_data.h"
+#include "../../src/qwt_typed_matrix_raster_data.h"
+#include "../../src/qwt_mipmap_raster_data.h"
 #include "../../src/qwt_date.h"
 #include "../../src/qwt_axis.h"
 #include "../../src/qwt_axis_id.h"
@@ -32,6 +34,7 @@
 #include "../../src/qwt_graphic.h"
 #include "../../src/qwt_event_pattern.h"
 #include "../../src/qwt_painter.h"
+#include "../../src/qwt_render_stats.h"
 #include "../../src/qwt_text_engine.h"
 #include "../../src/qwt_text.h"
 #include "../../src/qwt_text_label.h"
@@ -47,6 +50,7 @@
 #include "../../src/qwt_polar_fitter.h"
 
 #include "../../src/qwt_sampling_thread.h"
+#include "../../src/qwt_sampling_buffer.h"
 #include "../../src/qwt_scale_div.h"
 #include "../../src/qwt_scale_draw.h"
 #include "../../src/qwt_scale_engine.h"
@@ -62,6 +66,7 @@
 #include "../../src/qwt_column_symbol.h"
 #include "../../src/qwt_wheel.h"
 #include "../../src/qwt_vectorfield_symbol.h"
+#include "../../src/qwt_symbol_renderer.h"
 #include "../../src/qwt_spline_polynomial.h"
 #include "../../src/qwt_spline_parametrization.h"
 #include "../../src/qwt_spline_pleasing.h"
@@ -75,6 +80,9 @@
 #include "../../src/qwt_round_scale_draw.h"
 #include "../../src/qwt_series_store.h"
 #include "../../src/qwt_point_data.h"
+#include "../../src/qwt_mapped_point_data.h"
+#include "../../src/qwt_shared_point_data.h"
+#include "../../src/qwt_series_loader.h"
 #include "../../src/qwt_point_mapper.h"
 #include "../../src/qwt_dial_needle.h"
 #include "../../src/qwt_dial.h"
@@ -140,10 +148,12 @@
 #include "../../src/qwt_plot_layout.h"
 #include "../../src/qwt_parasite_plot_layout.h"
 #include "../../src/qwt_plot_scale_event_dispatcher.h"
+#include "../../src/qwt_plot_axis_link.h"
 #include "../../src/qwt_plot_rescaler.h"
 #include "../../src/qwt_polar_plot.h"
 #include "../../src/qwt_polar_grid.h"
 #include "../../src/qwt_polar_layout.h"
 #include "../../src/qwt_figure_layout.h"
+#include "../../src/qwt_lightweight_axes.h"
 #include "../../src/qwt_figure.h"
 #include "../../src/qwt_figure_widget_overlay.h"
\ No newline at end of file